@@ -176,20 +176,22 @@ void OptimizeImageCoorRigid(
             intr.block<3, 3>(0, 0) = intrinsic;
             intr(3, 3) = 1.0;
 
-            auto f_lambda = [&](int i, Eigen::Vector6d& J_r, double& r) {
+            auto f_lambda = [&](int i, utility::JTJandJTrAccumulator& sum) {
+                Eigen::Vector6d J_r;
+                double r;
                 jac.ComputeJacobianAndResidualRigid(
                         i, J_r, r, mesh, proxy_intensity, images_gray[c],
                         images_dx[c], images_dy[c], intr, extrinsic,
                         visiblity_image_to_vertex[c],
                         option.image_boundary_margin_);
+                sum.AddRow(J_r, r);
             };
             Eigen::Matrix6d JTJ;
             Eigen::Vector6d JTr;
             double r2;
-            std::tie(JTJ, JTr, r2) =
-                    utility::ComputeJTJandJTr<Eigen::Matrix6d, Eigen::Vector6d>(
-                            f_lambda, int(visiblity_image_to_vertex[c].size()),
-                            false);
+            std::tie(JTJ, JTr, r2) = utility::ReduceJTJandJTr(
+                    f_lambda, int(visiblity_image_to_vertex[c].size()),
+                    /*verbose*/ false);
 
             bool is_success;
             Eigen::Matrix4d delta;
@@ -0,0 +1,553 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Open3D/Geometry/IntersectionTest.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+
+namespace {
+using namespace geometry;
+
+/// Number of bins per axis used to evaluate the SAH split candidates.
+const int kNumBins = 16;
+
+/// Nodes with at least this many primitives are split with a parallel binning
+/// pass instead of being split in parallel with the other nodes of a level.
+const int kMinParallelNodeSize = 1 << 16;
+
+/// Number of chunks the primitives of a large node are split into for the
+/// parallel binning pass.
+const int kNumParallelChunks = 64;
+
+/// Minimum number of node pairs that are collected before the pair traversal
+/// is distributed over the threads.
+const size_t kMinParallelPairs = 1024;
+
+struct Bins {
+    Bins() {
+        for (int b = 0; b < kNumBins; b++) {
+            min_bound_[b] = Eigen::Vector3d::Constant(
+                    std::numeric_limits<double>::max());
+            max_bound_[b] = Eigen::Vector3d::Constant(
+                    std::numeric_limits<double>::lowest());
+            count_[b] = 0;
+        }
+    }
+
+    void Merge(const Bins &other) {
+        for (int b = 0; b < kNumBins; b++) {
+            min_bound_[b] = min_bound_[b].cwiseMin(other.min_bound_[b]);
+            max_bound_[b] = max_bound_[b].cwiseMax(other.max_bound_[b]);
+            count_[b] += other.count_[b];
+        }
+    }
+
+    Eigen::Vector3d min_bound_[kNumBins];
+    Eigen::Vector3d max_bound_[kNumBins];
+    int count_[kNumBins];
+};
+
+struct NodeBounds {
+    NodeBounds()
+        : min_bound_(Eigen::Vector3d::Constant(
+                  std::numeric_limits<double>::max())),
+          max_bound_(Eigen::Vector3d::Constant(
+                  std::numeric_limits<double>::lowest())),
+          centroid_min_(min_bound_),
+          centroid_max_(max_bound_) {}
+
+    void Merge(const NodeBounds &other) {
+        min_bound_ = min_bound_.cwiseMin(other.min_bound_);
+        max_bound_ = max_bound_.cwiseMax(other.max_bound_);
+        centroid_min_ = centroid_min_.cwiseMin(other.centroid_min_);
+        centroid_max_ = centroid_max_.cwiseMax(other.centroid_max_);
+    }
+
+    Eigen::Vector3d min_bound_;
+    Eigen::Vector3d max_bound_;
+    Eigen::Vector3d centroid_min_;
+    Eigen::Vector3d centroid_max_;
+};
+
+inline double HalfSurfaceArea(const Eigen::Vector3d &min_bound,
+                              const Eigen::Vector3d &max_bound) {
+    Eigen::Vector3d extent = max_bound - min_bound;
+    return extent(0) * extent(1) + extent(1) * extent(2) +
+           extent(2) * extent(0);
+}
+
+inline int GetBinIndex(double value, double min_value, double scale) {
+    int bin = int((value - min_value) * scale);
+    return std::min(std::max(bin, 0), kNumBins - 1);
+}
+
+void AccumulateBounds(const BoundingVolumeHierarchy &bvh,
+                      const std::vector<Eigen::Vector3d> &centroids,
+                      int begin,
+                      int end,
+                      NodeBounds &bounds) {
+    for (int i = begin; i < end; i++) {
+        int idx = bvh.primitive_indices_[i];
+        bounds.min_bound_ =
+                bounds.min_bound_.cwiseMin(bvh.primitive_min_bounds_[idx]);
+        bounds.max_bound_ =
+                bounds.max_bound_.cwiseMax(bvh.primitive_max_bounds_[idx]);
+        bounds.centroid_min_ = bounds.centroid_min_.cwiseMin(centroids[idx]);
+        bounds.centroid_max_ = bounds.centroid_max_.cwiseMax(centroids[idx]);
+    }
+}
+
+void AccumulateBins(const BoundingVolumeHierarchy &bvh,
+                    const std::vector<Eigen::Vector3d> &centroids,
+                    int begin,
+                    int end,
+                    int axis,
+                    double min_value,
+                    double scale,
+                    Bins &bins) {
+    for (int i = begin; i < end; i++) {
+        int idx = bvh.primitive_indices_[i];
+        int b = GetBinIndex(centroids[idx](axis), min_value, scale);
+        bins.min_bound_[b] =
+                bins.min_bound_[b].cwiseMin(bvh.primitive_min_bounds_[idx]);
+        bins.max_bound_[b] =
+                bins.max_bound_[b].cwiseMax(bvh.primitive_max_bounds_[idx]);
+        bins.count_[b]++;
+    }
+}
+
+/// Computes the bounds of node and splits its primitive range with the SAH.
+/// Returns the start of the second half of the range, or -1 if the node
+/// becomes a leaf. With parallel set, the range is processed in chunks by all
+/// threads, otherwise the node is processed by the calling thread.
+int SplitNode(BoundingVolumeHierarchy &bvh,
+              int node_idx,
+              const std::vector<Eigen::Vector3d> &centroids,
+              int max_leaf_size,
+              bool parallel) {
+    BoundingVolumeHierarchy::Node &node = bvh.nodes_[node_idx];
+    const int begin = node.first_;
+    const int end = node.first_ + node.size_;
+    const int num_chunks = parallel ? kNumParallelChunks : 1;
+    auto chunk_begin = [&](int c) {
+        return begin + int(int64_t(end - begin) * c / num_chunks);
+    };
+
+    NodeBounds bounds;
+    if (parallel) {
+        std::vector<NodeBounds> chunk_bounds(num_chunks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int c = 0; c < num_chunks; c++) {
+            AccumulateBounds(bvh, centroids, chunk_begin(c),
+                             chunk_begin(c + 1), chunk_bounds[c]);
+        }
+        for (int c = 0; c < num_chunks; c++) {
+            bounds.Merge(chunk_bounds[c]);
+        }
+    } else {
+        AccumulateBounds(bvh, centroids, begin, end, bounds);
+    }
+    node.min_bound_ = bounds.min_bound_;
+    node.max_bound_ = bounds.max_bound_;
+    if (node.size_ <= max_leaf_size) {
+        return -1;
+    }
+
+    // Bin the centroids along the axis with the largest extent.
+    Eigen::Vector3d centroid_extent =
+            bounds.centroid_max_ - bounds.centroid_min_;
+    int axis;
+    centroid_extent.maxCoeff(&axis);
+    const double min_value = bounds.centroid_min_(axis);
+    const double scale = centroid_extent(axis) > 0
+                                 ? kNumBins / centroid_extent(axis)
+                                 : 0;
+
+    Bins bins;
+    if (parallel) {
+        std::vector<Bins> chunk_bins(num_chunks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int c = 0; c < num_chunks; c++) {
+            AccumulateBins(bvh, centroids, chunk_begin(c), chunk_begin(c + 1),
+                           axis, min_value, scale, chunk_bins[c]);
+        }
+        for (int c = 0; c < num_chunks; c++) {
+            bins.Merge(chunk_bins[c]);
+        }
+    } else {
+        AccumulateBins(bvh, centroids, begin, end, axis, min_value, scale,
+                       bins);
+    }
+
+    // Sweep the bins and evaluate the SAH cost of splitting after bin b:
+    // count_left * area_left + count_right * area_right.
+    double best_cost = std::numeric_limits<double>::max();
+    int best_bin = -1;
+    double right_cost[kNumBins];
+    Eigen::Vector3d right_min =
+            Eigen::Vector3d::Constant(std::numeric_limits<double>::max());
+    Eigen::Vector3d right_max =
+            Eigen::Vector3d::Constant(std::numeric_limits<double>::lowest());
+    int right_count = 0;
+    for (int b = kNumBins - 1; b > 0; b--) {
+        right_min = right_min.cwiseMin(bins.min_bound_[b]);
+        right_max = right_max.cwiseMax(bins.max_bound_[b]);
+        right_count += bins.count_[b];
+        right_cost[b] = 0;
+        if (right_count > 0) {
+            right_cost[b] = right_count * HalfSurfaceArea(right_min, right_max);
+        }
+    }
+    Eigen::Vector3d left_min =
+            Eigen::Vector3d::Constant(std::numeric_limits<double>::max());
+    Eigen::Vector3d left_max =
+            Eigen::Vector3d::Constant(std::numeric_limits<double>::lowest());
+    int left_count = 0;
+    for (int b = 0; b < kNumBins - 1; b++) {
+        left_min = left_min.cwiseMin(bins.min_bound_[b]);
+        left_max = left_max.cwiseMax(bins.max_bound_[b]);
+        left_count += bins.count_[b];
+        if (left_count == 0 || left_count == node.size_) {
+            continue;
+        }
+        double cost = left_count * HalfSurfaceArea(left_min, left_max) +
+                      right_cost[b + 1];
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_bin = b;
+        }
+    }
+
+    int mid;
+    if (best_bin >= 0) {
+        auto first = bvh.primitive_indices_.begin();
+        mid = int(std::partition(first + begin, first + end,
+                                 [&](int idx) {
+                                     return GetBinIndex(centroids[idx](axis),
+                                                        min_value, scale) <=
+                                            best_bin;
+                                 }) -
+                  first);
+    } else {
+        // All centroids coincide, split the range in the middle to keep the
+        // leaves small.
+        mid = begin + node.size_ / 2;
+    }
+    return mid;
+}
+
+}  // unnamed namespace
+
+namespace geometry {
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const TriangleMesh &mesh,
+                                                 int max_leaf_size /* = 4 */) {
+    SetTriangleMesh(mesh, max_leaf_size);
+}
+
+bool BoundingVolumeHierarchy::SetTriangleMesh(const TriangleMesh &mesh,
+                                              int max_leaf_size /* = 4 */) {
+    const int n_triangles = int(mesh.triangles_.size());
+    primitive_min_bounds_.resize(n_triangles);
+    primitive_max_bounds_.resize(n_triangles);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int tidx = 0; tidx < n_triangles; tidx++) {
+        const Eigen::Vector3i &triangle = mesh.triangles_[tidx];
+        const Eigen::Vector3d &p0 = mesh.vertices_[triangle(0)];
+        const Eigen::Vector3d &p1 = mesh.vertices_[triangle(1)];
+        const Eigen::Vector3d &p2 = mesh.vertices_[triangle(2)];
+        primitive_min_bounds_[tidx] = p0.cwiseMin(p1).cwiseMin(p2);
+        primitive_max_bounds_[tidx] = p0.cwiseMax(p1).cwiseMax(p2);
+    }
+    Build(max_leaf_size);
+    return true;
+}
+
+bool BoundingVolumeHierarchy::SetBoundingBoxes(
+        const std::vector<Eigen::Vector3d> &min_bounds,
+        const std::vector<Eigen::Vector3d> &max_bounds,
+        int max_leaf_size /* = 4 */) {
+    if (min_bounds.size() != max_bounds.size()) {
+        utility::LogWarning(
+                "[BoundingVolumeHierarchy::SetBoundingBoxes] Number of min "
+                "and max bounds do not match.");
+        nodes_.clear();
+        primitive_indices_.clear();
+        primitive_min_bounds_.clear();
+        primitive_max_bounds_.clear();
+        return false;
+    }
+    primitive_min_bounds_ = min_bounds;
+    primitive_max_bounds_ = max_bounds;
+    Build(max_leaf_size);
+    return true;
+}
+
+void BoundingVolumeHierarchy::Build(int max_leaf_size) {
+    nodes_.clear();
+    primitive_indices_.clear();
+    const int n_primitives = int(primitive_min_bounds_.size());
+    if (n_primitives == 0) {
+        return;
+    }
+    max_leaf_size = std::max(max_leaf_size, 1);
+
+    std::vector<Eigen::Vector3d> centroids(n_primitives);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < n_primitives; i++) {
+        centroids[i] = (primitive_min_bounds_[i] + primitive_max_bounds_[i]) *
+                       0.5;
+    }
+    primitive_indices_.resize(n_primitives);
+    std::iota(primitive_indices_.begin(), primitive_indices_.end(), 0);
+
+    // The tree is built level by level. Nodes of one level own disjoint
+    // ranges of primitive_indices_, so they can be split concurrently. Large
+    // nodes near the root are split one at a time with parallel binning.
+    Node root;
+    root.first_ = 0;
+    root.size_ = n_primitives;
+    nodes_.push_back(root);
+    std::vector<int> level(1, 0);
+    while (!level.empty()) {
+        std::vector<int> mids(level.size(), -1);
+        std::vector<int> small_nodes;
+        for (size_t k = 0; k < level.size(); k++) {
+            if (nodes_[level[k]].size_ >= kMinParallelNodeSize) {
+                mids[k] = SplitNode(*this, level[k], centroids, max_leaf_size,
+                                    true);
+            } else {
+                small_nodes.push_back(int(k));
+            }
+        }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int s = 0; s < int(small_nodes.size()); s++) {
+            int k = small_nodes[s];
+            mids[k] = SplitNode(*this, level[k], centroids, max_leaf_size,
+                                false);
+        }
+
+        std::vector<int> next_level;
+        for (size_t k = 0; k < level.size(); k++) {
+            if (mids[k] < 0) {
+                continue;
+            }
+            const int begin = nodes_[level[k]].first_;
+            const int end = begin + nodes_[level[k]].size_;
+            const int child = int(nodes_.size());
+            nodes_[level[k]].first_ = child;
+            nodes_[level[k]].size_ = 0;
+
+            Node left, right;
+            left.first_ = begin;
+            left.size_ = mids[k] - begin;
+            right.first_ = mids[k];
+            right.size_ = end - mids[k];
+            nodes_.push_back(left);
+            nodes_.push_back(right);
+            next_level.push_back(child);
+            next_level.push_back(child + 1);
+        }
+        level.swap(next_level);
+    }
+}
+
+std::vector<int> BoundingVolumeHierarchy::SearchAABB(
+        const Eigen::Vector3d &min_bound,
+        const Eigen::Vector3d &max_bound) const {
+    std::vector<int> indices;
+    if (IsEmpty()) {
+        return indices;
+    }
+    std::vector<int> stack(1, 0);
+    while (!stack.empty()) {
+        const Node &node = nodes_[stack.back()];
+        stack.pop_back();
+        if (!IntersectionTest::AABBAABB(node.min_bound_, node.max_bound_,
+                                        min_bound, max_bound)) {
+            continue;
+        }
+        if (node.IsLeaf()) {
+            for (int i = node.first_; i < node.first_ + node.size_; i++) {
+                int idx = primitive_indices_[i];
+                if (IntersectionTest::AABBAABB(primitive_min_bounds_[idx],
+                                               primitive_max_bounds_[idx],
+                                               min_bound, max_bound)) {
+                    indices.push_back(idx);
+                }
+            }
+        } else {
+            stack.push_back(node.first_);
+            stack.push_back(node.first_ + 1);
+        }
+    }
+    return indices;
+}
+
+void BoundingVolumeHierarchy::TraverseOverlappingPairs(
+        const BoundingVolumeHierarchy &other,
+        const std::function<bool(int, int)> &f) const {
+    if (IsEmpty() || other.IsEmpty()) {
+        return;
+    }
+    typedef std::pair<int, int> NodePair;
+    const bool self = (&other == this);
+
+    auto overlap = [&](int a, int b) {
+        return IntersectionTest::AABBAABB(
+                nodes_[a].min_bound_, nodes_[a].max_bound_,
+                other.nodes_[b].min_bound_, other.nodes_[b].max_bound_);
+    };
+
+    // Pushes the overlapping child pairs of (a, b) to pairs. In self mode a
+    // pair (a, a) only expands to (l, l), (r, r) and (l, r), so that every
+    // unordered pair of primitives is visited once.
+    auto expand = [&](const NodePair &pair, std::vector<NodePair> &pairs) {
+        const Node &node_a = nodes_[pair.first];
+        const Node &node_b = other.nodes_[pair.second];
+        if (self && pair.first == pair.second) {
+            int l = node_a.first_;
+            int r = node_a.first_ + 1;
+            pairs.push_back(NodePair(l, l));
+            pairs.push_back(NodePair(r, r));
+            if (overlap(l, r)) {
+                pairs.push_back(NodePair(l, r));
+            }
+        } else if (node_b.IsLeaf() ||
+                   (!node_a.IsLeaf() &&
+                    HalfSurfaceArea(node_a.min_bound_, node_a.max_bound_) >=
+                            HalfSurfaceArea(node_b.min_bound_,
+                                            node_b.max_bound_))) {
+            for (int c = node_a.first_; c <= node_a.first_ + 1; c++) {
+                if (overlap(c, pair.second)) {
+                    pairs.push_back(NodePair(c, pair.second));
+                }
+            }
+        } else {
+            for (int c = node_b.first_; c <= node_b.first_ + 1; c++) {
+                if (overlap(pair.first, c)) {
+                    pairs.push_back(NodePair(pair.first, c));
+                }
+            }
+        }
+    };
+
+    std::atomic<bool> stop(false);
+    // Reports all overlapping primitive pairs of two leaves.
+    auto process_leaves = [&](const NodePair &pair) {
+        const Node &node_a = nodes_[pair.first];
+        const Node &node_b = other.nodes_[pair.second];
+        const bool same_leaf = self && pair.first == pair.second;
+        for (int i = node_a.first_; i < node_a.first_ + node_a.size_; i++) {
+            int idx_a = primitive_indices_[i];
+            int j = same_leaf ? i + 1 : node_b.first_;
+            for (; j < node_b.first_ + node_b.size_; j++) {
+                int idx_b = other.primitive_indices_[j];
+                if (!IntersectionTest::AABBAABB(
+                            primitive_min_bounds_[idx_a],
+                            primitive_max_bounds_[idx_a],
+                            other.primitive_min_bounds_[idx_b],
+                            other.primitive_max_bounds_[idx_b])) {
+                    continue;
+                }
+                bool next = self ? f(std::min(idx_a, idx_b),
+                                     std::max(idx_a, idx_b))
+                                 : f(idx_a, idx_b);
+                if (!next) {
+                    stop = true;
+                    return;
+                }
+            }
+        }
+    };
+
+    // Expand the pair tree breadth-first until there is enough independent
+    // work to distribute over the threads.
+    std::vector<NodePair> frontier;
+    if (overlap(0, 0)) {
+        frontier.push_back(NodePair(0, 0));
+    }
+    bool expanded = true;
+    while (expanded && frontier.size() < kMinParallelPairs) {
+        expanded = false;
+        std::vector<NodePair> next_frontier;
+        for (const NodePair &pair : frontier) {
+            if (nodes_[pair.first].IsLeaf() &&
+                other.nodes_[pair.second].IsLeaf()) {
+                next_frontier.push_back(pair);
+            } else {
+                expand(pair, next_frontier);
+                expanded = true;
+            }
+        }
+        frontier.swap(next_frontier);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int k = 0; k < int(frontier.size()); k++) {
+        std::vector<NodePair> stack(1, frontier[k]);
+        while (!stack.empty() && !stop) {
+            NodePair pair = stack.back();
+            stack.pop_back();
+            if (nodes_[pair.first].IsLeaf() &&
+                other.nodes_[pair.second].IsLeaf()) {
+                process_leaves(pair);
+            } else {
+                expand(pair, stack);
+            }
+        }
+    }
+}
+
+}  // namespace geometry
+}  // namespace open3d
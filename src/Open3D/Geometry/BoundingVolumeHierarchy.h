@@ -0,0 +1,115 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <functional>
+#include <vector>
+
+namespace open3d {
+namespace geometry {
+
+class TriangleMesh;
+
+/// \class BoundingVolumeHierarchy
+///
+/// \brief Bounding volume hierarchy (BVH) of axis aligned bounding boxes.
+///
+/// The hierarchy is built over a set of primitives, each represented by its
+/// axis aligned bounding box. The tree is constructed top-down by binning the
+/// primitive centroids and choosing the split with the lowest surface area
+/// heuristic (SAH) cost. Nodes of one level are split in parallel.
+class BoundingVolumeHierarchy {
+public:
+    /// \struct Node
+    ///
+    /// \brief Node of the hierarchy.
+    ///
+    /// A leaf node references the primitives
+    /// primitive_indices_[first_, first_ + size_). An internal node has size_
+    /// equal to 0, and its two children are stored at nodes_[first_] and
+    /// nodes_[first_ + 1].
+    struct Node {
+        bool IsLeaf() const { return size_ > 0; }
+
+        Eigen::Vector3d min_bound_ = Eigen::Vector3d::Zero();
+        Eigen::Vector3d max_bound_ = Eigen::Vector3d::Zero();
+        int first_ = 0;
+        int size_ = 0;
+    };
+
+public:
+    BoundingVolumeHierarchy() {}
+    /// \brief Builds the hierarchy over the triangles of \param mesh.
+    BoundingVolumeHierarchy(const TriangleMesh &mesh, int max_leaf_size = 4);
+    ~BoundingVolumeHierarchy() {}
+
+public:
+    /// \brief Builds the hierarchy over the triangles of \param mesh.
+    bool SetTriangleMesh(const TriangleMesh &mesh, int max_leaf_size = 4);
+
+    /// \brief Builds the hierarchy over arbitrary primitives given by the
+    /// axis aligned bounding boxes \param min_bounds and \param max_bounds.
+    bool SetBoundingBoxes(const std::vector<Eigen::Vector3d> &min_bounds,
+                          const std::vector<Eigen::Vector3d> &max_bounds,
+                          int max_leaf_size = 4);
+
+    bool IsEmpty() const { return nodes_.empty(); }
+
+    /// \brief Returns the indices of all primitives whose bounding box
+    /// overlaps the box given by \param min_bound and \param max_bound.
+    std::vector<int> SearchAABB(const Eigen::Vector3d &min_bound,
+                                const Eigen::Vector3d &max_bound) const;
+
+    /// \brief Traverses this hierarchy against \param other and calls \param f
+    /// for every pair of primitives (i, j) whose bounding boxes overlap, where
+    /// i is a primitive of this hierarchy and j one of \param other.
+    ///
+    /// If \param other is this hierarchy, each unordered pair of distinct
+    /// primitives is reported once with i < j. The traversal runs in parallel,
+    /// so \param f is called concurrently and has to be thread-safe. Returning
+    /// false from \param f stops the traversal as soon as possible.
+    void TraverseOverlappingPairs(
+            const BoundingVolumeHierarchy &other,
+            const std::function<bool(int, int)> &f) const;
+
+public:
+    /// Nodes of the hierarchy, nodes_[0] is the root.
+    std::vector<Node> nodes_;
+    /// Indices of the primitives, ordered such that every leaf node references
+    /// a contiguous range.
+    std::vector<int> primitive_indices_;
+    /// Bounding boxes of the primitives.
+    std::vector<Eigen::Vector3d> primitive_min_bounds_;
+    std::vector<Eigen::Vector3d> primitive_max_bounds_;
+
+private:
+    void Build(int max_leaf_size);
+};
+
+}  // namespace geometry
+}  // namespace open3d
@@ -24,6 +24,8 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <cstdint>
 #include <numeric>
 #include <unordered_map>
 
@@ -139,6 +141,92 @@ private:
     std::unordered_map<int, int> classes;
 };
 
+/// Number of key bits sorted per pass of RadixSort.
+const int kRadixBits = 8;
+const int kRadixBuckets = 1 << kRadixBits;
+
+/// Minimum and maximum number of chunks the points are split into for the
+/// parallel passes of VoxelDownSample.
+const int kMinChunkSize = 1 << 16;
+const int kMaxChunks = 64;
+
+/// Sorts keys in ascending order with a stable least significant digit radix
+/// sort over the lowest key_bits bits, and permutes values along. Each pass
+/// counts the digits per chunk, then scatters the chunks in parallel to the
+/// offsets given by a prefix sum over the counts in bucket-major order.
+void RadixSort(std::vector<uint64_t> &keys,
+               std::vector<int> &values,
+               int key_bits) {
+    const int64_t n = int64_t(keys.size());
+    const int n_chunks =
+            int(std::max<int64_t>(1, std::min<int64_t>(kMaxChunks,
+                                                       n / kMinChunkSize)));
+    std::vector<uint64_t> sorted_keys(n);
+    std::vector<int> sorted_values(n);
+    std::vector<int64_t> offsets(size_t(n_chunks) * kRadixBuckets);
+    for (int shift = 0; shift < key_bits; shift += kRadixBits) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int c = 0; c < n_chunks; c++) {
+            int64_t *chunk_offsets = offsets.data() + c * kRadixBuckets;
+            for (int64_t i = n * c / n_chunks; i < n * (c + 1) / n_chunks;
+                 i++) {
+                chunk_offsets[(keys[i] >> shift) & (kRadixBuckets - 1)]++;
+            }
+        }
+        int64_t sum = 0;
+        for (int b = 0; b < kRadixBuckets; b++) {
+            for (int c = 0; c < n_chunks; c++) {
+                const int64_t count = offsets[c * kRadixBuckets + b];
+                offsets[c * kRadixBuckets + b] = sum;
+                sum += count;
+            }
+        }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int c = 0; c < n_chunks; c++) {
+            int64_t *chunk_offsets = offsets.data() + c * kRadixBuckets;
+            for (int64_t i = n * c / n_chunks; i < n * (c + 1) / n_chunks;
+                 i++) {
+                const int64_t pos = chunk_offsets[(keys[i] >> shift) &
+                                                  (kRadixBuckets - 1)]++;
+                sorted_keys[pos] = keys[i];
+                sorted_values[pos] = values[i];
+            }
+        }
+        keys.swap(sorted_keys);
+        values.swap(sorted_values);
+    }
+}
+
+/// Component-wise median of values, the mean of the two middle values for
+/// an even number of values.
+Eigen::Vector3d ComputeMedian(std::vector<Eigen::Vector3d> &values) {
+    Eigen::Vector3d median(0.0, 0.0, 0.0);
+    if (values.empty()) {
+        return median;
+    }
+    const size_t mid = values.size() / 2;
+    for (int d = 0; d < 3; d++) {
+        auto less = [d](const Eigen::Vector3d &a, const Eigen::Vector3d &b) {
+            return a(d) < b(d);
+        };
+        std::nth_element(values.begin(), values.begin() + mid, values.end(),
+                         less);
+        median(d) = values[mid](d);
+        if (values.size() % 2 == 0) {
+            median(d) = 0.5 * (median(d) +
+                               (*std::max_element(values.begin(),
+                                                  values.begin() + mid, less))(
+                                       d));
+        }
+    }
+    return median;
+}
+
 }  // unnamed namespace
 
 namespace geometry {
@@ -252,7 +340,7 @@ std::shared_ptr<TriangleMesh> TriangleMesh::SelectDownSample(
 }
 
 std::shared_ptr<PointCloud> PointCloud::VoxelDownSample(
-        double voxel_size) const {
+        double voxel_size, VoxelReduction reduction) const {
     auto output = std::make_shared<PointCloud>();
     if (voxel_size <= 0.0) {
         utility::LogError("[VoxelDownSample] voxel_size <= 0.");
@@ -265,27 +353,151 @@ std::shared_ptr<PointCloud> PointCloud::VoxelDownSample(
         (voxel_max_bound - voxel_min_bound).maxCoeff()) {
         utility::LogError("[VoxelDownSample] voxel_size is too small.");
     }
-    std::unordered_map<Eigen::Vector3i, AccumulatedPoint,
-                       utility::hash_eigen::hash<Eigen::Vector3i>>
-            voxelindex_to_accpoint;
+    const int n = int(points_.size());
+    if (n == 0) {
+        return output;
+    }
+    auto get_voxel_index = [&](int i) {
+        Eigen::Vector3d ref_coord = (points_[i] - voxel_min_bound) / voxel_size;
+        return Eigen::Vector3i(int(floor(ref_coord(0))),
+                               int(floor(ref_coord(1))),
+                               int(floor(ref_coord(2))));
+    };
 
-    Eigen::Vector3d ref_coord;
-    Eigen::Vector3i voxel_index;
-    for (int i = 0; i < (int)points_.size(); i++) {
-        ref_coord = (points_[i] - voxel_min_bound) / voxel_size;
-        voxel_index << int(floor(ref_coord(0))), int(floor(ref_coord(1))),
-                int(floor(ref_coord(2)));
-        voxelindex_to_accpoint[voxel_index].AddPoint(*this, i);
+    // Sort the points by voxel index, keeping the input order within a
+    // voxel. Voxel indices are packed into 64 bit keys for a radix sort if
+    // the grid is small enough.
+    Eigen::Vector3i voxel_bits;
+    for (int d = 0; d < 3; d++) {
+        const int max_index = int(std::ceil(
+                (voxel_max_bound(d) - voxel_min_bound(d)) / voxel_size));
+        voxel_bits(d) = 1;
+        while (voxel_bits(d) < 31 && (max_index >> voxel_bits(d)) > 0) {
+            voxel_bits(d)++;
+        }
     }
+    std::vector<uint64_t> keys(n);
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    if (voxel_bits.sum() <= 64) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = 0; i < n; i++) {
+            const Eigen::Vector3i voxel_index = get_voxel_index(i);
+            keys[i] = (((uint64_t(voxel_index(0)) << voxel_bits(1)) |
+                        uint64_t(voxel_index(1)))
+                       << voxel_bits(2)) |
+                      uint64_t(voxel_index(2));
+        }
+        RadixSort(keys, order, voxel_bits.sum());
+    } else {
+        std::vector<Eigen::Vector3i> voxel_indices(n);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = 0; i < n; i++) {
+            voxel_indices[i] = get_voxel_index(i);
+        }
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+            return std::lexicographical_compare(
+                    voxel_indices[a].data(), voxel_indices[a].data() + 3,
+                    voxel_indices[b].data(), voxel_indices[b].data() + 3);
+        });
+        keys[0] = 0;
+        for (int i = 1; i < n; i++) {
+            keys[i] = keys[i - 1] +
+                      (voxel_indices[order[i]] != voxel_indices[order[i - 1]]);
+        }
+    }
+
+    // Find the runs of equal keys, which are the occupied voxels.
+    const int n_chunks = std::max(1, std::min(kMaxChunks, n / kMinChunkSize));
+    std::vector<int> chunk_offsets(n_chunks + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int c = 0; c < n_chunks; c++) {
+        for (int i = int(int64_t(n) * c / n_chunks);
+             i < int(int64_t(n) * (c + 1) / n_chunks); i++) {
+            chunk_offsets[c + 1] += (i == 0 || keys[i] != keys[i - 1]);
+        }
+    }
+    std::partial_sum(chunk_offsets.begin(), chunk_offsets.end(),
+                     chunk_offsets.begin());
+    const int num_voxels_occupied = chunk_offsets[n_chunks];
+    std::vector<int> voxel_begin(num_voxels_occupied + 1, n);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int c = 0; c < n_chunks; c++) {
+        int v = chunk_offsets[c];
+        for (int i = int(int64_t(n) * c / n_chunks);
+             i < int(int64_t(n) * (c + 1) / n_chunks); i++) {
+            if (i == 0 || keys[i] != keys[i - 1]) {
+                voxel_begin[v++] = i;
+            }
+        }
+    }
+
     bool has_normals = HasNormals();
     bool has_colors = HasColors();
-    for (auto accpoint : voxelindex_to_accpoint) {
-        output->points_.push_back(accpoint.second.GetAveragePoint());
-        if (has_normals) {
-            output->normals_.push_back(accpoint.second.GetAverageNormal());
-        }
-        if (has_colors) {
-            output->colors_.push_back(accpoint.second.GetAverageColor());
+    output->points_.resize(num_voxels_occupied);
+    if (has_normals) {
+        output->normals_.resize(num_voxels_occupied);
+    }
+    if (has_colors) {
+        output->colors_.resize(num_voxels_occupied);
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < num_voxels_occupied; v++) {
+        const int begin = voxel_begin[v];
+        const int end = voxel_begin[v + 1];
+        if (reduction == VoxelReduction::First) {
+            output->points_[v] = points_[order[begin]];
+            if (has_normals) {
+                output->normals_[v] = normals_[order[begin]];
+            }
+            if (has_colors) {
+                output->colors_[v] = colors_[order[begin]];
+            }
+        } else if (reduction == VoxelReduction::Median) {
+            std::vector<Eigen::Vector3d> values;
+            values.reserve(end - begin);
+            for (int i = begin; i < end; i++) {
+                values.push_back(points_[order[i]]);
+            }
+            output->points_[v] = ComputeMedian(values);
+            if (has_normals) {
+                values.clear();
+                for (int i = begin; i < end; i++) {
+                    if (!normals_[order[i]].hasNaN()) {
+                        values.push_back(normals_[order[i]]);
+                    }
+                }
+                output->normals_[v] = ComputeMedian(values).normalized();
+            }
+            if (has_colors) {
+                values.clear();
+                for (int i = begin; i < end; i++) {
+                    values.push_back(colors_[order[i]]);
+                }
+                output->colors_[v] = ComputeMedian(values);
+            }
+        } else {
+            AccumulatedPoint accpoint;
+            for (int i = begin; i < end; i++) {
+                accpoint.AddPoint(*this, order[i]);
+            }
+            output->points_[v] = accpoint.GetAveragePoint();
+            if (has_normals) {
+                output->normals_[v] = accpoint.GetAverageNormal();
+            }
+            if (has_colors) {
+                output->colors_[v] = accpoint.GetAverageColor();
+            }
         }
     }
     utility::LogDebug(
@@ -25,8 +25,10 @@
 // ----------------------------------------------------------------------------
 
 #include <Eigen/Eigenvalues>
+#include <algorithm>
 
 #include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/NeighborhoodGraph.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Utility/Console.h"
 
@@ -218,15 +220,16 @@ Eigen::Vector3d FastEigen3x3(Eigen::Matrix3d &A) {
 }
 
 Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
-                              const std::vector<int> &indices,
+                              const int *indices,
+                              int num_indices,
                               bool fast_normal_computation) {
-    if (indices.size() == 0) {
+    if (num_indices == 0) {
         return Eigen::Vector3d::Zero();
     }
     Eigen::Matrix3d covariance;
     Eigen::Matrix<double, 9, 1> cumulants;
     cumulants.setZero();
-    for (size_t i = 0; i < indices.size(); i++) {
+    for (int i = 0; i < num_indices; i++) {
         const Eigen::Vector3d &point = cloud.points_[indices[i]];
         cumulants(0) += point(0);
         cumulants(1) += point(1);
@@ -238,7 +241,7 @@ Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
         cumulants(7) += point(1) * point(2);
         cumulants(8) += point(2) * point(2);
     }
-    cumulants /= (double)indices.size();
+    cumulants /= (double)num_indices;
     covariance(0, 0) = cumulants(3) - cumulants(0) * cumulants(0);
     covariance(1, 1) = cumulants(6) - cumulants(1) * cumulants(1);
     covariance(2, 2) = cumulants(8) - cumulants(2) * cumulants(2);
@@ -258,6 +261,34 @@ Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
     }
 }
 
+/// Sets the normal of point i from its neighbors. If the cloud had normals
+/// before the estimation, the new normal is oriented like the old one.
+void EstimateNormal(PointCloud &cloud,
+                    int i,
+                    const int *indices,
+                    int num_indices,
+                    bool has_normal,
+                    bool fast_normal_computation) {
+    Eigen::Vector3d normal;
+    if (num_indices >= 3) {
+        normal = ComputeNormal(cloud, indices, num_indices,
+                               fast_normal_computation);
+        if (normal.norm() == 0.0) {
+            if (has_normal) {
+                normal = cloud.normals_[i];
+            } else {
+                normal = Eigen::Vector3d(0.0, 0.0, 1.0);
+            }
+        }
+        if (has_normal && normal.dot(cloud.normals_[i]) < 0.0) {
+            normal *= -1.0;
+        }
+        cloud.normals_[i] = normal;
+    } else {
+        cloud.normals_[i] = Eigen::Vector3d(0.0, 0.0, 1.0);
+    }
+}
+
 }  // unnamed namespace
 
 namespace geometry {
@@ -277,23 +308,34 @@ bool PointCloud::EstimateNormals(
     for (int i = 0; i < (int)points_.size(); i++) {
         std::vector<int> indices;
         std::vector<double> distance2;
-        Eigen::Vector3d normal;
-        if (kdtree.Search(points_[i], search_param, indices, distance2) >= 3) {
-            normal = ComputeNormal(*this, indices, fast_normal_computation);
-            if (normal.norm() == 0.0) {
-                if (has_normal) {
-                    normal = normals_[i];
-                } else {
-                    normal = Eigen::Vector3d(0.0, 0.0, 1.0);
-                }
-            }
-            if (has_normal && normal.dot(normals_[i]) < 0.0) {
-                normal *= -1.0;
-            }
-            normals_[i] = normal;
-        } else {
-            normals_[i] = Eigen::Vector3d(0.0, 0.0, 1.0);
-        }
+        int num_indices = std::max(
+                kdtree.Search(points_[i], search_param, indices, distance2), 0);
+        EstimateNormal(*this, i, indices.data(), num_indices, has_normal,
+                       fast_normal_computation);
+    }
+
+    return true;
+}
+
+bool PointCloud::EstimateNormals(const NeighborhoodGraph &graph,
+                                 bool fast_normal_computation /* = true */) {
+    if (graph.NumPoints() != points_.size()) {
+        utility::LogWarning(
+                "[EstimateNormals] The neighborhood graph does not match the "
+                "point cloud.");
+        return false;
+    }
+    bool has_normal = HasNormals();
+    if (HasNormals() == false) {
+        normals_.resize(points_.size());
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < (int)points_.size(); i++) {
+        EstimateNormal(*this, i, graph.indices_.data() + graph.offsets_[i],
+                       graph.NumNeighbors(i), has_normal,
+                       fast_normal_computation);
     }
 
     return true;
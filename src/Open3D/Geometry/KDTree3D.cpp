@@ -0,0 +1,549 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/KDTree3D.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace open3d {
+
+namespace {
+
+/// Keeps the nearest neighbors sorted by squared distance, up to a capacity
+/// and a maximum squared distance.
+class KNNResultSet {
+public:
+    KNNResultSet(int capacity,
+                 double max_distance2,
+                 int *indices,
+                 double *distance2)
+        : capacity_(capacity),
+          max_distance2_(max_distance2),
+          indices_(indices),
+          distance2_(distance2) {}
+
+    double WorstDistance2() const {
+        return size_ < capacity_ ? max_distance2_ : distance2_[capacity_ - 1];
+    }
+
+    void Add(double distance2, int index) {
+        int i = size_ < capacity_ ? size_++ : capacity_ - 1;
+        for (; i > 0 && distance2_[i - 1] > distance2; i--) {
+            distance2_[i] = distance2_[i - 1];
+            indices_[i] = indices_[i - 1];
+        }
+        distance2_[i] = distance2;
+        indices_[i] = index;
+    }
+
+    int Size() const { return size_; }
+
+private:
+    int capacity_;
+    double max_distance2_;
+    int *indices_;
+    double *distance2_;
+    int size_ = 0;
+};
+
+/// Collects all neighbors within a maximum squared distance, unsorted.
+class RadiusResultSet {
+public:
+    RadiusResultSet(double max_distance2) : max_distance2_(max_distance2) {}
+
+    double WorstDistance2() const { return max_distance2_; }
+
+    void Add(double distance2, int index) {
+        neighbors_.push_back(std::make_pair(distance2, index));
+    }
+
+    std::vector<std::pair<double, int>> neighbors_;
+
+private:
+    double max_distance2_;
+};
+
+/// Largest fraction of the points of a subtree in one of its children, before
+/// the subtree is rebuilt after adding points.
+const double kMaxChildFraction = 0.75;
+
+/// Squared search radius, rounded to float as in flann so that both search
+/// structures accept exactly the same neighbors.
+double RadiusToDistance2(double radius) { return float(radius * radius); }
+
+}  // unnamed namespace
+
+namespace geometry {
+
+template <typename Scalar>
+void KDTree3D<Scalar>::Build(const Eigen::Ref<const Eigen::Matrix3Xd> &points,
+                             int max_leaf_size) {
+    Clear();
+    max_leaf_size_ = std::max(max_leaf_size, 1);
+    const int n = int(points.cols());
+    if (n == 0) {
+        return;
+    }
+    indices_.resize(n);
+    std::iota(indices_.begin(), indices_.end(), 0);
+    BuildRange([&](int key, int axis) { return points(axis, key); }, 0, n);
+    min_bound_ = points.rowwise().minCoeff().template cast<Scalar>();
+    max_bound_ = points.rowwise().maxCoeff().template cast<Scalar>();
+
+    // Store the points in tree order, so that the points of a leaf are
+    // contiguous in memory.
+    points_.resize(n);
+    for (int i = 0; i < n; i++) {
+        points_[i] = points.col(indices_[i]).template cast<Scalar>();
+    }
+}
+
+template <typename Scalar>
+void KDTree3D<Scalar>::BuildReference(
+        const Eigen::Map<const Eigen::Matrix3Xd> &points, int max_leaf_size) {
+    Clear();
+    max_leaf_size_ = std::max(max_leaf_size, 1);
+    const int n = int(points.cols());
+    if (n == 0) {
+        return;
+    }
+    reference_ = points.data();
+    indices_.resize(n);
+    std::iota(indices_.begin(), indices_.end(), 0);
+    BuildRange([&](int key, int axis) { return points(axis, key); }, 0, n);
+    min_bound_ = points.rowwise().minCoeff().template cast<Scalar>();
+    max_bound_ = points.rowwise().maxCoeff().template cast<Scalar>();
+}
+
+template <typename Scalar>
+void KDTree3D<Scalar>::AddPoints(
+        const Eigen::Ref<const Eigen::Matrix3Xd> &points) {
+    if (IsEmpty()) {
+        Build(points, max_leaf_size_);
+    } else if (points.cols() > 0) {
+        Insert(points);
+    }
+}
+
+template <typename Scalar>
+void KDTree3D<Scalar>::AddPointsReference(
+        const Eigen::Map<const Eigen::Matrix3Xd> &points) {
+    if (IsEmpty()) {
+        BuildReference(points, max_leaf_size_);
+        return;
+    }
+    const int size = int(Size());
+    reference_ = points.data();
+    if (points.cols() > size) {
+        Insert(points.rightCols(points.cols() - size));
+    }
+}
+
+template <typename Scalar>
+void KDTree3D<Scalar>::Clear() {
+    nodes_.clear();
+    points_.clear();
+    indices_.clear();
+    reference_ = nullptr;
+}
+
+template <typename Scalar>
+template <typename Coordinate>
+int KDTree3D<Scalar>::BuildRange(const Coordinate &coordinate,
+                                 int begin,
+                                 int end) {
+    Eigen::Vector3d min_bound;
+    Eigen::Vector3d max_bound;
+    for (int d = 0; d < 3; d++) {
+        min_bound(d) = max_bound(d) = coordinate(indices_[begin], d);
+    }
+    for (int i = begin + 1; i < end; i++) {
+        for (int d = 0; d < 3; d++) {
+            const double value = coordinate(indices_[i], d);
+            min_bound(d) = std::min(min_bound(d), value);
+            max_bound(d) = std::max(max_bound(d), value);
+        }
+    }
+    return BuildNode(coordinate, begin, end, min_bound, max_bound);
+}
+
+template <typename Scalar>
+template <typename Coordinate>
+int KDTree3D<Scalar>::BuildNode(const Coordinate &coordinate,
+                                int begin,
+                                int end,
+                                const Eigen::Vector3d &min_bound,
+                                const Eigen::Vector3d &max_bound) {
+    const int node_idx = int(nodes_.size());
+    Node node;
+    node.axis_ = -1;
+    node.left_ = -1;
+    node.right_ = -1;
+    node.begin_ = begin;
+    node.size_ = end - begin;
+    node.split_low_ = 0;
+    node.split_high_ = 0;
+    nodes_.push_back(node);
+    if (end - begin <= max_leaf_size_) {
+        return node_idx;
+    }
+
+    // Split at the median along the axis of largest extent. The bounds of
+    // the children are those of the node, cut at the split.
+    int axis;
+    (max_bound - min_bound).maxCoeff(&axis);
+    const int mid = begin + (end - begin) / 2;
+    std::nth_element(indices_.begin() + begin, indices_.begin() + mid,
+                     indices_.begin() + end, [&](int a, int b) {
+                         return coordinate(a, axis) < coordinate(b, axis);
+                     });
+    double split_low = coordinate(indices_[begin], axis);
+    for (int i = begin + 1; i < mid; i++) {
+        split_low = std::max(split_low, coordinate(indices_[i], axis));
+    }
+    const double split_high = coordinate(indices_[mid], axis);
+    if (split_low == max_bound(axis) && split_high == min_bound(axis)) {
+        // All points share the coordinate along the longest axis, so they
+        // are identical.
+        return node_idx;
+    }
+    nodes_[node_idx].axis_ = axis;
+    nodes_[node_idx].split_low_ = Scalar(split_low);
+    nodes_[node_idx].split_high_ = Scalar(split_high);
+    Eigen::Vector3d child_bound = max_bound;
+    child_bound(axis) = split_low;
+    const int left =
+            BuildNode(coordinate, begin, mid, min_bound, child_bound);
+    child_bound = min_bound;
+    child_bound(axis) = split_high;
+    const int right = BuildNode(coordinate, mid, end, child_bound, max_bound);
+    nodes_[node_idx].left_ = left;
+    nodes_[node_idx].right_ = right;
+    return node_idx;
+}
+
+template <typename Scalar>
+void KDTree3D<Scalar>::Insert(
+        const Eigen::Ref<const Eigen::Matrix3Xd> &new_points) {
+    // Route the points to their leaves, keeping the subtree sizes and the
+    // split coordinates up to date on the way down.
+    const int begin = int(Size());
+    std::vector<std::pair<int, int>> pending;
+    pending.reserve(new_points.cols());
+    std::vector<bool> changed(nodes_.size(), false);
+    for (int j = 0; j < new_points.cols(); j++) {
+        const PointType point = new_points.col(j).template cast<Scalar>();
+        min_bound_ = min_bound_.cwiseMin(point);
+        max_bound_ = max_bound_.cwiseMax(point);
+        int node_idx = 0;
+        while (true) {
+            Node &node = nodes_[node_idx];
+            node.size_++;
+            changed[node_idx] = true;
+            if (node.axis_ < 0) {
+                break;
+            }
+            const Scalar value = point(node.axis_);
+            if ((value - node.split_low_) + (value - node.split_high_) < 0) {
+                node.split_low_ = std::max(node.split_low_, value);
+                node_idx = node.left_;
+            } else {
+                node.split_high_ = std::min(node.split_high_, value);
+                node_idx = node.right_;
+            }
+        }
+        pending.push_back(std::make_pair(node_idx, j));
+    }
+    std::sort(pending.begin(), pending.end());
+
+    // Rebuild the leaves with new points, and the highest subtrees on their
+    // paths with a child holding too many of the points.
+    std::vector<int> stack(1, 0);
+    while (!stack.empty()) {
+        const int node_idx = stack.back();
+        stack.pop_back();
+        const Node &node = nodes_[node_idx];
+        if (node.axis_ < 0 ||
+            std::max(nodes_[node.left_].size_, nodes_[node.right_].size_) >
+                    kMaxChildFraction * node.size_) {
+            RebuildNode(node_idx, new_points, pending, begin);
+            continue;
+        }
+        if (changed[node.right_]) {
+            stack.push_back(node.right_);
+        }
+        if (changed[node.left_]) {
+            stack.push_back(node.left_);
+        }
+    }
+    if (indices_.size() > 2 * Size()) {
+        Compact();
+    }
+}
+
+template <typename Scalar>
+void KDTree3D<Scalar>::RebuildNode(
+        int node_idx,
+        const Eigen::Ref<const Eigen::Matrix3Xd> &new_points,
+        const std::vector<std::pair<int, int>> &pending,
+        int begin) {
+    // Gather the indices of the points of the subtree, and for trees that own
+    // their points also the coordinates.
+    const int size = nodes_[node_idx].size_;
+    std::vector<int> ids;
+    ids.reserve(size);
+    Eigen::Matrix3Xd points(3, IsReference() ? 0 : size);
+    std::vector<int> stack(1, node_idx);
+    while (!stack.empty()) {
+        const int idx = stack.back();
+        const Node &node = nodes_[idx];
+        stack.pop_back();
+        if (node.axis_ >= 0) {
+            stack.push_back(node.right_);
+            stack.push_back(node.left_);
+            continue;
+        }
+        auto range = std::equal_range(
+                pending.begin(), pending.end(),
+                std::make_pair(idx, 0),
+                [](const std::pair<int, int> &a,
+                   const std::pair<int, int> &b) { return a.first < b.first; });
+        const int stored = node.size_ - int(range.second - range.first);
+        for (int i = node.begin_; i < node.begin_ + stored; i++) {
+            if (!IsReference()) {
+                points.col(ids.size()) = points_[i].template cast<double>();
+            }
+            ids.push_back(indices_[i]);
+        }
+        for (auto it = range.first; it != range.second; it++) {
+            if (!IsReference()) {
+                points.col(ids.size()) = new_points.col(it->second);
+            }
+            ids.push_back(begin + it->second);
+        }
+    }
+
+    // Build the subtree at the end of the arrays, and move its root to the
+    // node. The previous points and nodes of the subtree are left unused.
+    const int range_begin = int(indices_.size());
+    int root;
+    if (IsReference()) {
+        indices_.insert(indices_.end(), ids.begin(), ids.end());
+        root = BuildRange(
+                [&](int key, int axis) {
+                    return reference_[3 * size_t(key) + axis];
+                },
+                range_begin, range_begin + size);
+    } else {
+        indices_.resize(range_begin + size);
+        std::iota(indices_.begin() + range_begin, indices_.end(), 0);
+        root = BuildRange(
+                [&](int key, int axis) { return points(axis, key); },
+                range_begin, range_begin + size);
+        points_.resize(indices_.size());
+        for (int i = range_begin; i < range_begin + size; i++) {
+            points_[i] = points.col(indices_[i]).template cast<Scalar>();
+            indices_[i] = ids[indices_[i]];
+        }
+    }
+    nodes_[node_idx] = nodes_[root];
+}
+
+template <typename Scalar>
+void KDTree3D<Scalar>::Compact() {
+    std::vector<Node> nodes;
+    std::vector<PointType> points;
+    std::vector<int> indices;
+    indices.reserve(Size());
+    if (!IsReference()) {
+        points.reserve(Size());
+    }
+    CompactNode(0, nodes, points, indices);
+    nodes_.swap(nodes);
+    points_.swap(points);
+    indices_.swap(indices);
+}
+
+template <typename Scalar>
+int KDTree3D<Scalar>::CompactNode(int node_idx,
+                                  std::vector<Node> &nodes,
+                                  std::vector<PointType> &points,
+                                  std::vector<int> &indices) const {
+    const Node &node = nodes_[node_idx];
+    const int new_idx = int(nodes.size());
+    nodes.push_back(node);
+    if (node.axis_ < 0) {
+        nodes[new_idx].begin_ = int(indices.size());
+        indices.insert(indices.end(), indices_.begin() + node.begin_,
+                       indices_.begin() + node.begin_ + node.size_);
+        if (!IsReference()) {
+            points.insert(points.end(), points_.begin() + node.begin_,
+                          points_.begin() + node.begin_ + node.size_);
+        }
+        return new_idx;
+    }
+    const int left = CompactNode(node.left_, nodes, points, indices);
+    const int right = CompactNode(node.right_, nodes, points, indices);
+    nodes[new_idx].left_ = left;
+    nodes[new_idx].right_ = right;
+    return new_idx;
+}
+
+template <typename Scalar>
+int KDTree3D<Scalar>::SearchKNN(const Eigen::Vector3d &query,
+                                int knn,
+                                int *indices,
+                                double *distance2) const {
+    if (knn <= 0 || IsEmpty()) {
+        return 0;
+    }
+    KNNResultSet result(knn, std::numeric_limits<double>::max(), indices,
+                        distance2);
+    Search(query, result);
+    return result.Size();
+}
+
+template <typename Scalar>
+int KDTree3D<Scalar>::SearchHybrid(const Eigen::Vector3d &query,
+                                   double radius,
+                                   int max_nn,
+                                   int *indices,
+                                   double *distance2) const {
+    if (max_nn <= 0 || IsEmpty()) {
+        return 0;
+    }
+    KNNResultSet result(max_nn, RadiusToDistance2(radius), indices, distance2);
+    Search(query, result);
+    return result.Size();
+}
+
+template <typename Scalar>
+int KDTree3D<Scalar>::SearchRadius(const Eigen::Vector3d &query,
+                                   double radius,
+                                   std::vector<int> &indices,
+                                   std::vector<double> &distance2) const {
+    if (IsEmpty()) {
+        return 0;
+    }
+    RadiusResultSet result(RadiusToDistance2(radius));
+    Search(query, result);
+    std::sort(result.neighbors_.begin(), result.neighbors_.end());
+    for (const auto &neighbor : result.neighbors_) {
+        distance2.push_back(neighbor.first);
+        indices.push_back(neighbor.second);
+    }
+    return int(result.neighbors_.size());
+}
+
+template <typename Scalar>
+template <typename ResultSet>
+void KDTree3D<Scalar>::Search(const Eigen::Vector3d &query,
+                              ResultSet &result) const {
+    // The squared distance from the query to the bounding box of a node is
+    // tracked per axis, and updated incrementally when descending into the
+    // far child of a split.
+    const PointType q = query.template cast<Scalar>();
+    Scalar axis_distance2[3];
+    Scalar min_distance2 = 0;
+    for (int d = 0; d < 3; d++) {
+        Scalar diff = 0;
+        if (q(d) < min_bound_(d)) {
+            diff = min_bound_(d) - q(d);
+        } else if (q(d) > max_bound_(d)) {
+            diff = q(d) - max_bound_(d);
+        }
+        axis_distance2[d] = diff * diff;
+        min_distance2 += axis_distance2[d];
+    }
+    SearchNode(0, q, min_distance2, axis_distance2, result);
+}
+
+template <typename Scalar>
+template <typename ResultSet>
+void KDTree3D<Scalar>::SearchNode(int node_idx,
+                                  const PointType &query,
+                                  Scalar min_distance2,
+                                  Scalar *axis_distance2,
+                                  ResultSet &result) const {
+    const Node &node = nodes_[node_idx];
+    if (node.axis_ < 0) {
+        if (IsReference()) {
+            for (int i = node.begin_; i < node.begin_ + node.size_; i++) {
+                const double *point = reference_ + 3 * size_t(indices_[i]);
+                const Scalar d0 = Scalar(point[0]) - query(0);
+                const Scalar d1 = Scalar(point[1]) - query(1);
+                const Scalar d2 = Scalar(point[2]) - query(2);
+                const double distance2 = d0 * d0 + d1 * d1 + d2 * d2;
+                if (distance2 < result.WorstDistance2()) {
+                    result.Add(distance2, indices_[i]);
+                }
+            }
+        } else {
+            for (int i = node.begin_; i < node.begin_ + node.size_; i++) {
+                const Scalar d0 = points_[i](0) - query(0);
+                const Scalar d1 = points_[i](1) - query(1);
+                const Scalar d2 = points_[i](2) - query(2);
+                const double distance2 = d0 * d0 + d1 * d1 + d2 * d2;
+                if (distance2 < result.WorstDistance2()) {
+                    result.Add(distance2, indices_[i]);
+                }
+            }
+        }
+        return;
+    }
+    const int axis = node.axis_;
+    const Scalar diff_low = query(axis) - node.split_low_;
+    const Scalar diff_high = query(axis) - node.split_high_;
+    int near_idx, far_idx;
+    Scalar cut_distance2;
+    if (diff_low + diff_high < 0) {
+        near_idx = node.left_;
+        far_idx = node.right_;
+        cut_distance2 = diff_high * diff_high;
+    } else {
+        near_idx = node.right_;
+        far_idx = node.left_;
+        cut_distance2 = diff_low * diff_low;
+    }
+    SearchNode(near_idx, query, min_distance2, axis_distance2, result);
+
+    const Scalar old_axis_distance2 = axis_distance2[axis];
+    min_distance2 += cut_distance2 - old_axis_distance2;
+    if (min_distance2 <= result.WorstDistance2()) {
+        axis_distance2[axis] = cut_distance2;
+        SearchNode(far_idx, query, min_distance2, axis_distance2, result);
+        axis_distance2[axis] = old_axis_distance2;
+    }
+}
+
+template class KDTree3D<float>;
+template class KDTree3D<double>;
+
+}  // namespace geometry
+}  // namespace open3d
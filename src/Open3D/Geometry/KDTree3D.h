@@ -0,0 +1,180 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <utility>
+#include <vector>
+
+namespace open3d {
+namespace geometry {
+
+/// \class KDTree3D
+///
+/// \brief KD-tree specialized for 3D points.
+///
+/// By default the points are copied once, in the order of the leaves of the
+/// tree, with coordinates of type Scalar (float or double). A tree built with
+/// BuildReference instead references the points, and only stores their
+/// permutation. The nodes are stored in a flat array, in depth-first order
+/// after a build. The search results match KDTreeFlann: neighbors are sorted
+/// by increasing squared distance, and radius searches only return points
+/// with a squared distance strictly smaller than radius * radius.
+///
+/// Added points are routed to the leaves containing them. Once all points of
+/// a batch are routed, the leaves that received points are rebuilt, as are
+/// the subtrees that became unbalanced. Rebuilt subtrees are appended to the
+/// arrays, which are compacted when more than half of them is unused.
+template <typename Scalar>
+class KDTree3D {
+public:
+    typedef Eigen::Matrix<Scalar, 3, 1> PointType;
+
+    struct Node {
+        /// Split dimension, -1 for leaves
+        int axis_;
+        /// Children of inner nodes
+        int left_;
+        int right_;
+        /// Leaves hold the points begin_ to begin_ + size_ - 1 in tree order
+        int begin_;
+        /// Number of points in the subtree
+        int size_;
+        /// Largest coordinate of the left and smallest coordinate of the
+        /// right subtree along axis_
+        Scalar split_low_;
+        Scalar split_high_;
+    };
+
+public:
+    KDTree3D() {}
+
+public:
+    /// Builds the tree over a copy of the columns of points, a 3xN matrix.
+    void Build(const Eigen::Ref<const Eigen::Matrix3Xd> &points,
+               int max_leaf_size = 10);
+    /// Builds the tree over the columns of points without copying them. The
+    /// memory of points must stay valid and unchanged while the tree is used,
+    /// until the tree is built again or updated with AddPointsReference.
+    void BuildReference(const Eigen::Map<const Eigen::Matrix3Xd> &points,
+                        int max_leaf_size = 10);
+    /// Adds copies of the columns of points to a tree built with Build. The
+    /// new points get the indices Size() to Size() + points.cols() - 1.
+    void AddPoints(const Eigen::Ref<const Eigen::Matrix3Xd> &points);
+    /// Adds points to a tree built with BuildReference. points replaces the
+    /// referenced memory, which may have been reallocated: its first Size()
+    /// columns must be the points of the tree, followed by the new points.
+    void AddPointsReference(const Eigen::Map<const Eigen::Matrix3Xd> &points);
+
+    bool IsEmpty() const { return nodes_.empty(); }
+    bool IsReference() const { return reference_ != nullptr; }
+    size_t Size() const { return nodes_.empty() ? 0 : nodes_[0].size_; }
+
+    /// Writes the (at most knn) nearest neighbors to indices and distance2,
+    /// which must hold knn elements. Returns the number of neighbors.
+    int SearchKNN(const Eigen::Vector3d &query,
+                  int knn,
+                  int *indices,
+                  double *distance2) const;
+
+    /// Like SearchKNN, but only considers points within radius.
+    int SearchHybrid(const Eigen::Vector3d &query,
+                     double radius,
+                     int max_nn,
+                     int *indices,
+                     double *distance2) const;
+
+    /// Appends all points within radius to indices and distance2. Returns the
+    /// number of appended neighbors.
+    int SearchRadius(const Eigen::Vector3d &query,
+                     double radius,
+                     std::vector<int> &indices,
+                     std::vector<double> &distance2) const;
+
+protected:
+    void Clear();
+
+    /// Builds a subtree over the keys indices_[begin] to indices_[end - 1],
+    /// reordering them. coordinate(key, axis) returns a coordinate of the
+    /// point of a key. Returns the index of the root node.
+    template <typename Coordinate>
+    int BuildRange(const Coordinate &coordinate, int begin, int end);
+
+    template <typename Coordinate>
+    int BuildNode(const Coordinate &coordinate,
+                  int begin,
+                  int end,
+                  const Eigen::Vector3d &min_bound,
+                  const Eigen::Vector3d &max_bound);
+
+    /// Adds the points with indices Size() to Size() + new_points.cols() - 1.
+    /// For trees that reference their points, reference_ must already hold
+    /// the new points and new_points only provides their coordinates.
+    void Insert(const Eigen::Ref<const Eigen::Matrix3Xd> &new_points);
+
+    /// Rebuilds the subtree of a node with its points and the added points
+    /// routed to it. pending holds the pairs of leaf and column of new_points
+    /// sorted by leaf, begin is the index of the first added point.
+    void RebuildNode(int node_idx,
+                     const Eigen::Ref<const Eigen::Matrix3Xd> &new_points,
+                     const std::vector<std::pair<int, int>> &pending,
+                     int begin);
+
+    /// Copies the used parts of the arrays in depth-first order.
+    void Compact();
+    int CompactNode(int node_idx,
+                    std::vector<Node> &nodes,
+                    std::vector<PointType> &points,
+                    std::vector<int> &indices) const;
+
+    template <typename ResultSet>
+    void SearchNode(int node_idx,
+                    const PointType &query,
+                    Scalar min_distance2,
+                    Scalar *axis_distance2,
+                    ResultSet &result) const;
+
+    template <typename ResultSet>
+    void Search(const Eigen::Vector3d &query, ResultSet &result) const;
+
+protected:
+    /// Nodes of the tree, with the root at index 0
+    std::vector<Node> nodes_;
+    /// Points in tree order, empty for trees that reference their points
+    std::vector<PointType> points_;
+    /// Index of each point in tree order
+    std::vector<int> indices_;
+    /// Referenced points, nullptr if the tree owns its points
+    const double *reference_ = nullptr;
+    int max_leaf_size_ = 10;
+    /// Bounding box of all points
+    PointType min_bound_;
+    PointType max_bound_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
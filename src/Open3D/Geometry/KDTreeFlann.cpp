@@ -31,21 +31,110 @@
 
 #include "Open3D/Geometry/KDTreeFlann.h"
 
+#include <algorithm>
 #include <flann/flann.hpp>
 
 #include "Open3D/Geometry/HalfEdgeTriangleMesh.h"
+#include "Open3D/Geometry/KDTree3D.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
+
+namespace {
+
+/// Number of consecutive queries handled by one task of the batched searches.
+const int kQueryChunkSize = 256;
+
+/// Initial number of neighbors reserved per query in the unbounded batched
+/// radius search, grown on demand.
+const int kInitialRadiusCapacity = 64;
+
+/// Returns the points of a point cloud or the vertices of a mesh, nullptr for
+/// other geometries.
+const std::vector<Eigen::Vector3d> *GetGeometryPoints(
+        const geometry::Geometry &geometry) {
+    switch (geometry.GetGeometryType()) {
+        case geometry::Geometry::GeometryType::PointCloud:
+            return &((const geometry::PointCloud &)geometry).points_;
+        case geometry::Geometry::GeometryType::TriangleMesh:
+        case geometry::Geometry::GeometryType::HalfEdgeTriangleMesh:
+            return &((const geometry::TriangleMesh &)geometry).vertices_;
+        case geometry::Geometry::GeometryType::Image:
+        case geometry::Geometry::GeometryType::Unspecified:
+        default:
+            return nullptr;
+    }
+}
+
+/// Appends the knn nearest neighbors of query to indices and distance2.
+template <typename Scalar>
+int SearchKNN3D(const geometry::KDTree3D<Scalar> &tree,
+                const Eigen::Vector3d &query,
+                int knn,
+                std::vector<int> &indices,
+                std::vector<double> &distance2) {
+    const size_t size = indices.size();
+    indices.resize(size + knn);
+    distance2.resize(size + knn);
+    int k = tree.SearchKNN(query, knn, indices.data() + size,
+                           distance2.data() + size);
+    indices.resize(size + k);
+    distance2.resize(size + k);
+    return k;
+}
+
+/// Appends the neighbors of query within radius to indices and distance2,
+/// max_nn < 0 means no limit on the neighbors.
+template <typename Scalar>
+int SearchRadius3D(const geometry::KDTree3D<Scalar> &tree,
+                   const Eigen::Vector3d &query,
+                   double radius,
+                   int max_nn,
+                   std::vector<int> &indices,
+                   std::vector<double> &distance2) {
+    if (max_nn < 0) {
+        return tree.SearchRadius(query, radius, indices, distance2);
+    }
+    const size_t size = indices.size();
+    indices.resize(size + max_nn);
+    distance2.resize(size + max_nn);
+    int k = tree.SearchHybrid(query, radius, max_nn, indices.data() + size,
+                              distance2.data() + size);
+    indices.resize(size + k);
+    distance2.resize(size + k);
+    return k;
+}
+
+/// Writes the k nearest neighbors of every query with a stride of k.
+template <typename Scalar>
+void SearchKNNBatch3D(const geometry::KDTree3D<Scalar> &tree,
+                      const Eigen::Ref<const Eigen::MatrixXd> &queries,
+                      int k,
+                      int *indices,
+                      double *distance2) {
+    const int n_queries = int(queries.cols());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, kQueryChunkSize)
+#endif
+    for (int i = 0; i < n_queries; i++) {
+        tree.SearchKNN(Eigen::Vector3d(queries.col(i)), k,
+                       indices + size_t(i) * k, distance2 + size_t(i) * k);
+    }
+}
+
+}  // unnamed namespace
+
 namespace geometry {
 
 KDTreeFlann::KDTreeFlann() {}
 
 KDTreeFlann::KDTreeFlann(const Eigen::MatrixXd &data) { SetMatrixData(data); }
 
-KDTreeFlann::KDTreeFlann(const Geometry &geometry) { SetGeometry(geometry); }
+KDTreeFlann::KDTreeFlann(const Geometry &geometry, bool use_float32) {
+    SetGeometry(geometry, use_float32);
+}
 
 KDTreeFlann::KDTreeFlann(const registration::Feature &feature) {
     SetFeature(feature);
@@ -58,30 +147,76 @@ bool KDTreeFlann::SetMatrixData(const Eigen::MatrixXd &data) {
             data.data(), data.rows(), data.cols()));
 }
 
-bool KDTreeFlann::SetGeometry(const Geometry &geometry) {
-    switch (geometry.GetGeometryType()) {
-        case Geometry::GeometryType::PointCloud:
-            return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
-                    (const double *)((const PointCloud &)geometry)
-                            .points_.data(),
-                    3, ((const PointCloud &)geometry).points_.size()));
-        case Geometry::GeometryType::TriangleMesh:
-        case Geometry::GeometryType::HalfEdgeTriangleMesh:
-            return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
-                    (const double *)((const TriangleMesh &)geometry)
-                            .vertices_.data(),
-                    3, ((const TriangleMesh &)geometry).vertices_.size()));
-        case Geometry::GeometryType::Image:
-        case Geometry::GeometryType::Unspecified:
-        default:
-            utility::LogWarning(
-                    "[KDTreeFlann::SetGeometry] Unsupported Geometry type.");
-            return false;
+bool KDTreeFlann::SetGeometry(const Geometry &geometry, bool use_float32) {
+    const std::vector<Eigen::Vector3d> *points = GetGeometryPoints(geometry);
+    if (points == nullptr) {
+        utility::LogWarning(
+                "[KDTreeFlann::SetGeometry] Unsupported Geometry type.");
+        return false;
+    }
+    return SetPoints(Eigen::Map<const Eigen::Matrix3Xd>(
+                             (const double *)points->data(), 3, points->size()),
+                     use_float32, false);
+}
+
+bool KDTreeFlann::SetPointsReference(
+        const Eigen::Map<const Eigen::Matrix3Xd> &points) {
+    return SetPoints(points, false, true);
+}
+
+bool KDTreeFlann::SetGeometryReference(const Geometry &geometry) {
+    const std::vector<Eigen::Vector3d> *points = GetGeometryPoints(geometry);
+    if (points == nullptr) {
+        utility::LogWarning(
+                "[KDTreeFlann::SetGeometryReference] Unsupported Geometry "
+                "type.");
+        return false;
     }
+    return SetPoints(Eigen::Map<const Eigen::Matrix3Xd>(
+                             (const double *)points->data(), 3, points->size()),
+                     false, true);
 }
 
 bool KDTreeFlann::SetFeature(const registration::Feature &feature) {
-    return SetMatrixData(feature.data_);
+    return SetMatrixData(feature.data_.cast<double>());
+}
+
+bool KDTreeFlann::AddPoints(const std::vector<Eigen::Vector3d> &points) {
+    if ((!kdtree3d_ && !kdtree3f_) ||
+        (kdtree3d_ && kdtree3d_->IsReference())) {
+        utility::LogWarning(
+                "[KDTreeFlann::AddPoints] Requires a tree built with "
+                "SetGeometry.");
+        return false;
+    }
+    Eigen::Map<const Eigen::Matrix3Xd> data((const double *)points.data(), 3,
+                                            points.size());
+    if (kdtree3d_) {
+        kdtree3d_->AddPoints(data);
+    } else {
+        kdtree3f_->AddPoints(data);
+    }
+    dataset_size_ += points.size();
+    return true;
+}
+
+bool KDTreeFlann::AddPointsReference(
+        const Eigen::Map<const Eigen::Matrix3Xd> &points) {
+    if (!kdtree3d_ || !kdtree3d_->IsReference()) {
+        utility::LogWarning(
+                "[KDTreeFlann::AddPointsReference] Requires a tree built with "
+                "SetPointsReference or SetGeometryReference.");
+        return false;
+    }
+    if (size_t(points.cols()) < dataset_size_) {
+        utility::LogWarning(
+                "[KDTreeFlann::AddPointsReference] Fewer points than in the "
+                "tree.");
+        return false;
+    }
+    kdtree3d_->AddPointsReference(points);
+    dataset_size_ = points.cols();
+    return true;
 }
 
 template <typename T>
@@ -116,10 +251,19 @@ int KDTreeFlann::SearchKNN(const T &query,
     // This is optimized code for heavily repeated search.
     // Other flann::Index::knnSearch() implementations lose performance due to
     // memory allocation/deallocation.
-    if (data_.empty() || dataset_size_ <= 0 ||
-        size_t(query.rows()) != dimension_ || knn < 0) {
+    if (dataset_size_ <= 0 || size_t(query.rows()) != dimension_ ||
+        knn < 0) {
         return -1;
     }
+    if (kdtree3d_ || kdtree3f_) {
+        const Eigen::Vector3d query3(query(0), query(1), query(2));
+        indices.clear();
+        distance2.clear();
+        return kdtree3d_ ? SearchKNN3D(*kdtree3d_, query3, knn, indices,
+                                       distance2)
+                         : SearchKNN3D(*kdtree3f_, query3, knn, indices,
+                                       distance2);
+    }
     flann::Matrix<double> query_flann((double *)query.data(), 1, dimension_);
     indices.resize(knn);
     distance2.resize(knn);
@@ -141,10 +285,18 @@ int KDTreeFlann::SearchRadius(const T &query,
     // Since max_nn is not given, we let flann to do its own memory management.
     // Other flann::Index::radiusSearch() implementations lose performance due
     // to memory management and CPU caching.
-    if (data_.empty() || dataset_size_ <= 0 ||
-        size_t(query.rows()) != dimension_) {
+    if (dataset_size_ <= 0 || size_t(query.rows()) != dimension_) {
         return -1;
     }
+    if (kdtree3d_ || kdtree3f_) {
+        const Eigen::Vector3d query3(query(0), query(1), query(2));
+        indices.clear();
+        distance2.clear();
+        return kdtree3d_ ? SearchRadius3D(*kdtree3d_, query3, radius, -1,
+                                          indices, distance2)
+                         : SearchRadius3D(*kdtree3f_, query3, radius, -1,
+                                          indices, distance2);
+    }
     flann::Matrix<double> query_flann((double *)query.data(), 1, dimension_);
     flann::SearchParams param(-1, 0.0);
     param.max_neighbors = -1;
@@ -167,10 +319,19 @@ int KDTreeFlann::SearchHybrid(const T &query,
     // It is also the recommended setting for search.
     // Other flann::Index::radiusSearch() implementations lose performance due
     // to memory allocation/deallocation.
-    if (data_.empty() || dataset_size_ <= 0 ||
-        size_t(query.rows()) != dimension_ || max_nn < 0) {
+    if (dataset_size_ <= 0 || size_t(query.rows()) != dimension_ ||
+        max_nn < 0) {
         return -1;
     }
+    if (kdtree3d_ || kdtree3f_) {
+        const Eigen::Vector3d query3(query(0), query(1), query(2));
+        indices.clear();
+        distance2.clear();
+        return kdtree3d_ ? SearchRadius3D(*kdtree3d_, query3, radius, max_nn,
+                                          indices, distance2)
+                         : SearchRadius3D(*kdtree3f_, query3, radius, max_nn,
+                                          indices, distance2);
+    }
     flann::Matrix<double> query_flann((double *)query.data(), 1, dimension_);
     flann::SearchParams param(-1, 0.0);
     param.max_neighbors = max_nn;
@@ -186,7 +347,200 @@ int KDTreeFlann::SearchHybrid(const T &query,
     return k;
 }
 
+int KDTreeFlann::Search(const Eigen::Ref<const Eigen::MatrixXd> &queries,
+                        const KDTreeSearchParam &param,
+                        std::vector<int> &indices,
+                        std::vector<double> &distance2,
+                        std::vector<int> &offsets) const {
+    switch (param.GetSearchType()) {
+        case KDTreeSearchParam::SearchType::Knn:
+            return SearchKNN(queries,
+                             ((const KDTreeSearchParamKNN &)param).knn_,
+                             indices, distance2, offsets);
+        case KDTreeSearchParam::SearchType::Radius:
+            return SearchRadius(
+                    queries, ((const KDTreeSearchParamRadius &)param).radius_,
+                    indices, distance2, offsets);
+        case KDTreeSearchParam::SearchType::Hybrid:
+            return SearchHybrid(
+                    queries, ((const KDTreeSearchParamHybrid &)param).radius_,
+                    ((const KDTreeSearchParamHybrid &)param).max_nn_, indices,
+                    distance2, offsets);
+        default:
+            return -1;
+    }
+    return -1;
+}
+
+int KDTreeFlann::SearchKNN(const Eigen::Ref<const Eigen::MatrixXd> &queries,
+                           int knn,
+                           std::vector<int> &indices,
+                           std::vector<double> &distance2,
+                           std::vector<int> &offsets) const {
+    if (dataset_size_ <= 0 || size_t(queries.rows()) != dimension_ ||
+        knn < 0) {
+        return -1;
+    }
+    // Every query gets the same number of neighbors, so the results of a
+    // chunk of queries can be written in place with a fixed stride.
+    const int n_queries = int(queries.cols());
+    const int k = std::min(knn, int(dataset_size_));
+    indices.resize(size_t(n_queries) * k);
+    distance2.resize(size_t(n_queries) * k);
+    offsets.resize(n_queries + 1);
+    for (int i = 0; i <= n_queries; i++) {
+        offsets[i] = i * k;
+    }
+    if (k == 0) {
+        return 0;
+    }
+    if (kdtree3d_) {
+        SearchKNNBatch3D(*kdtree3d_, queries, k, indices.data(),
+                         distance2.data());
+        return n_queries * k;
+    }
+    if (kdtree3f_) {
+        SearchKNNBatch3D(*kdtree3f_, queries, k, indices.data(),
+                         distance2.data());
+        return n_queries * k;
+    }
+    const int n_chunks = (n_queries + kQueryChunkSize - 1) / kQueryChunkSize;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int c = 0; c < n_chunks; c++) {
+        const int begin = c * kQueryChunkSize;
+        const int n = std::min(kQueryChunkSize, n_queries - begin);
+        // The queries may be a view with an outer stride, e.g. a block of
+        // a larger matrix.
+        const size_t stride = size_t(queries.outerStride());
+        flann::Matrix<double> query_flann(
+                (double *)queries.data() + size_t(begin) * stride, n,
+                dimension_, stride * sizeof(double));
+        flann::Matrix<int> indices_flann(indices.data() + size_t(begin) * k,
+                                         n, k);
+        flann::Matrix<double> dists_flann(
+                distance2.data() + size_t(begin) * k, n, k);
+        flann_index_->knnSearch(query_flann, indices_flann, dists_flann, k,
+                                flann::SearchParams(-1, 0.0));
+    }
+    return n_queries * k;
+}
+
+int KDTreeFlann::SearchRadius(const Eigen::Ref<const Eigen::MatrixXd> &queries,
+                              double radius,
+                              std::vector<int> &indices,
+                              std::vector<double> &distance2,
+                              std::vector<int> &offsets) const {
+    return SearchRadiusBatch(queries, radius, -1, indices, distance2, offsets);
+}
+
+int KDTreeFlann::SearchHybrid(const Eigen::Ref<const Eigen::MatrixXd> &queries,
+                              double radius,
+                              int max_nn,
+                              std::vector<int> &indices,
+                              std::vector<double> &distance2,
+                              std::vector<int> &offsets) const {
+    if (max_nn < 0) {
+        return -1;
+    }
+    return SearchRadiusBatch(queries, radius, max_nn, indices, distance2,
+                             offsets);
+}
+
+int KDTreeFlann::SearchRadiusBatch(
+        const Eigen::Ref<const Eigen::MatrixXd> &queries,
+        double radius,
+        int max_nn,
+        std::vector<int> &indices,
+        std::vector<double> &distance2,
+        std::vector<int> &offsets) const {
+    if (dataset_size_ <= 0 || size_t(queries.rows()) != dimension_) {
+        return -1;
+    }
+    // The neighbors of each chunk are collected into buffers of the chunk,
+    // then the chunks are concatenated at the offsets given by a prefix sum
+    // over the neighbor counts. Without max_nn the search is bounded by the
+    // capacity of the buffers and repeated with a larger one if it fills up.
+    const int n_queries = int(queries.cols());
+    const int n_chunks = (n_queries + kQueryChunkSize - 1) / kQueryChunkSize;
+    std::vector<std::vector<int>> chunk_indices(n_chunks);
+    std::vector<std::vector<double>> chunk_distance2(n_chunks);
+    offsets.assign(n_queries + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int c = 0; c < n_chunks; c++) {
+        const int begin = c * kQueryChunkSize;
+        const int end = std::min(begin + kQueryChunkSize, n_queries);
+        if (kdtree3d_ || kdtree3f_) {
+            for (int i = begin; i < end; i++) {
+                const Eigen::Vector3d query(queries.col(i));
+                offsets[i + 1] =
+                        kdtree3d_ ? SearchRadius3D(*kdtree3d_, query, radius,
+                                                   max_nn, chunk_indices[c],
+                                                   chunk_distance2[c])
+                                  : SearchRadius3D(*kdtree3f_, query, radius,
+                                                   max_nn, chunk_indices[c],
+                                                   chunk_distance2[c]);
+            }
+            continue;
+        }
+        int capacity = max_nn >= 0 ? max_nn : kInitialRadiusCapacity;
+        std::vector<size_t> indices_buffer(capacity);
+        std::vector<double> dists_buffer(capacity);
+        for (int i = begin; i < end && capacity > 0; i++) {
+            flann::Matrix<double> query_flann(
+                    (double *)queries.data() +
+                            size_t(i) * size_t(queries.outerStride()),
+                    1, dimension_);
+            int k;
+            while (true) {
+                flann::Matrix<size_t> indices_flann(indices_buffer.data(), 1,
+                                                    capacity);
+                flann::Matrix<double> dists_flann(dists_buffer.data(), 1,
+                                                  capacity);
+                flann::SearchParams param(-1, 0.0);
+                param.max_neighbors = capacity;
+                k = flann_index_->radiusSearch(query_flann, indices_flann,
+                                               dists_flann,
+                                               float(radius * radius), param);
+                if (max_nn >= 0 || k < capacity) {
+                    break;
+                }
+                capacity *= 2;
+                indices_buffer.resize(capacity);
+                dists_buffer.resize(capacity);
+            }
+            offsets[i + 1] = k;
+            chunk_indices[c].insert(chunk_indices[c].end(),
+                                    indices_buffer.begin(),
+                                    indices_buffer.begin() + k);
+            chunk_distance2[c].insert(chunk_distance2[c].end(),
+                                      dists_buffer.begin(),
+                                      dists_buffer.begin() + k);
+        }
+    }
+    for (int i = 0; i < n_queries; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    indices.resize(offsets[n_queries]);
+    distance2.resize(offsets[n_queries]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int c = 0; c < n_chunks; c++) {
+        std::copy(chunk_indices[c].begin(), chunk_indices[c].end(),
+                  indices.begin() + offsets[c * kQueryChunkSize]);
+        std::copy(chunk_distance2[c].begin(), chunk_distance2[c].end(),
+                  distance2.begin() + offsets[c * kQueryChunkSize]);
+    }
+    return offsets[n_queries];
+}
+
 bool KDTreeFlann::SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data) {
+    kdtree3d_.reset();
+    kdtree3f_.reset();
     dimension_ = data.rows();
     dataset_size_ = data.cols();
     if (dimension_ == 0 || dataset_size_ == 0) {
@@ -204,6 +558,35 @@ bool KDTreeFlann::SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data) {
     return true;
 }
 
+bool KDTreeFlann::SetPoints(const Eigen::Map<const Eigen::Matrix3Xd> &points,
+                            bool use_float32,
+                            bool reference) {
+    // The KDTree3D either keeps its own copy of the points or references
+    // them, so the flann index and its copy of the data are released.
+    flann_index_.reset();
+    flann_dataset_.reset();
+    std::vector<double>().swap(data_);
+    kdtree3d_.reset();
+    kdtree3f_.reset();
+    dimension_ = 3;
+    dataset_size_ = points.cols();
+    if (dataset_size_ == 0) {
+        utility::LogWarning("[KDTreeFlann::SetPoints] Failed due to no data.");
+        return false;
+    }
+    if (reference) {
+        kdtree3d_.reset(new KDTree3D<double>());
+        kdtree3d_->BuildReference(points);
+    } else if (use_float32) {
+        kdtree3f_.reset(new KDTree3D<float>());
+        kdtree3f_->Build(points);
+    } else {
+        kdtree3d_.reset(new KDTree3D<double>());
+        kdtree3d_->Build(points);
+    }
+    return true;
+}
+
 template int KDTreeFlann::Search<Eigen::Vector3d>(
         const Eigen::Vector3d &query,
         const KDTreeSearchParam &param,
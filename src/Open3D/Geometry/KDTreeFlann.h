@@ -46,11 +46,14 @@ class Index;
 namespace open3d {
 namespace geometry {
 
+template <typename Scalar>
+class KDTree3D;
+
 class KDTreeFlann {
 public:
     KDTreeFlann();
     KDTreeFlann(const Eigen::MatrixXd &data);
-    KDTreeFlann(const Geometry &geometry);
+    KDTreeFlann(const Geometry &geometry, bool use_float32 = false);
     KDTreeFlann(const registration::Feature &feature);
     ~KDTreeFlann();
     KDTreeFlann(const KDTreeFlann &) = delete;
@@ -58,9 +61,29 @@ public:
 
 public:
     bool SetMatrixData(const Eigen::MatrixXd &data);
-    bool SetGeometry(const Geometry &geometry);
+    /// Point clouds and meshes are indexed with a KDTree3D, which stores the
+    /// points in single precision if use_float32 is true.
+    bool SetGeometry(const Geometry &geometry, bool use_float32 = false);
+    /// Builds a KDTree3D that references the columns of points instead of
+    /// copying them, and only stores their permutation. The memory of points
+    /// must stay valid and unchanged while the tree is used, until the next
+    /// call to Set* or AddPointsReference.
+    bool SetPointsReference(const Eigen::Map<const Eigen::Matrix3Xd> &points);
+    /// Like SetPointsReference, for the points of a point cloud or the
+    /// vertices of a mesh. Adding points to the geometry may reallocate them,
+    /// so AddPointsReference must be called before the next search.
+    bool SetGeometryReference(const Geometry &geometry);
     bool SetFeature(const registration::Feature &feature);
 
+    /// Adds copies of points to a tree built with SetGeometry. The new points
+    /// get the indices following the existing points. Only the most recently
+    /// added parts of the tree are rebuilt.
+    bool AddPoints(const std::vector<Eigen::Vector3d> &points);
+    /// Adds points to a tree built with SetPointsReference or
+    /// SetGeometryReference. points replaces the referenced memory: it starts
+    /// with the points of the tree, unchanged, followed by the new points.
+    bool AddPointsReference(const Eigen::Map<const Eigen::Matrix3Xd> &points);
+
     template <typename T>
     int Search(const T &query,
                const KDTreeSearchParam &param,
@@ -86,13 +109,56 @@ public:
                      std::vector<int> &indices,
                      std::vector<double> &distance2) const;
 
+    /// Batched searches for all columns of queries, parallelized over the
+    /// queries. The results are returned in compressed sparse row layout: the
+    /// neighbors of query i are indices[offsets[i]] to
+    /// indices[offsets[i + 1] - 1], with the squared distances in distance2.
+    /// Returns the total number of neighbors, or -1 on invalid input.
+    int Search(const Eigen::Ref<const Eigen::MatrixXd> &queries,
+               const KDTreeSearchParam &param,
+               std::vector<int> &indices,
+               std::vector<double> &distance2,
+               std::vector<int> &offsets) const;
+
+    int SearchKNN(const Eigen::Ref<const Eigen::MatrixXd> &queries,
+                  int knn,
+                  std::vector<int> &indices,
+                  std::vector<double> &distance2,
+                  std::vector<int> &offsets) const;
+
+    int SearchRadius(const Eigen::Ref<const Eigen::MatrixXd> &queries,
+                     double radius,
+                     std::vector<int> &indices,
+                     std::vector<double> &distance2,
+                     std::vector<int> &offsets) const;
+
+    int SearchHybrid(const Eigen::Ref<const Eigen::MatrixXd> &queries,
+                     double radius,
+                     int max_nn,
+                     std::vector<int> &indices,
+                     std::vector<double> &distance2,
+                     std::vector<int> &offsets) const;
+
 private:
     bool SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data);
+    bool SetPoints(const Eigen::Map<const Eigen::Matrix3Xd> &points,
+                   bool use_float32,
+                   bool reference);
+
+    /// Batched radius search, max_nn < 0 means no limit on the neighbors.
+    int SearchRadiusBatch(const Eigen::Ref<const Eigen::MatrixXd> &queries,
+                          double radius,
+                          int max_nn,
+                          std::vector<int> &indices,
+                          std::vector<double> &distance2,
+                          std::vector<int> &offsets) const;
 
 protected:
     std::vector<double> data_;
     std::unique_ptr<flann::Matrix<double>> flann_dataset_;
     std::unique_ptr<flann::Index<flann::L2<double>>> flann_index_;
+    std::unique_ptr<KDTree3D<double>> kdtree3d_;
+    std::unique_ptr<KDTree3D<float>> kdtree3f_;
     size_t dimension_ = 0;
     size_t dataset_size_ = 0;
 };
@@ -0,0 +1,59 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/NeighborhoodGraph.h"
+
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+namespace geometry {
+
+std::shared_ptr<NeighborhoodGraph> NeighborhoodGraph::CreateFromPointCloud(
+        const PointCloud &pointcloud,
+        const KDTreeSearchParam
+                &search_param /* = KDTreeSearchParamKNN()*/) {
+    auto graph = std::make_shared<NeighborhoodGraph>();
+    if (!pointcloud.HasPoints()) {
+        graph->offsets_.assign(1, 0);
+        return graph;
+    }
+    KDTreeFlann kdtree(pointcloud);
+    if (kdtree.Search(Eigen::Map<const Eigen::MatrixXd>(
+                              (const double *)pointcloud.points_.data(), 3,
+                              pointcloud.points_.size()),
+                      search_param, graph->indices_, graph->distance2_,
+                      graph->offsets_) < 0) {
+        utility::LogError(
+                "[NeighborhoodGraph::CreateFromPointCloud] Invalid search "
+                "parameter.");
+    }
+    return graph;
+}
+
+}  // namespace geometry
+}  // namespace open3d
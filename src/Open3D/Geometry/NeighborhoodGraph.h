@@ -0,0 +1,74 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+
+namespace open3d {
+namespace geometry {
+
+class PointCloud;
+
+/// \class NeighborhoodGraph
+///
+/// \brief Neighbors of every point of a point cloud, searched once and shared
+/// by the algorithms that need them, such as normal estimation and FPFH.
+///
+/// The graph is stored in compressed sparse row layout: the neighbors of
+/// point i are indices_[offsets_[i]] to indices_[offsets_[i + 1] - 1], with
+/// squared distances distance2_. Like the results of KDTreeFlann::Search,
+/// they are sorted by distance and include the point itself.
+class NeighborhoodGraph {
+public:
+    NeighborhoodGraph() {}
+    ~NeighborhoodGraph() {}
+
+public:
+    /// Number of points whose neighbors are stored.
+    size_t NumPoints() const {
+        return offsets_.empty() ? 0 : offsets_.size() - 1;
+    }
+    /// Number of neighbors of point i.
+    int NumNeighbors(size_t i) const { return offsets_[i + 1] - offsets_[i]; }
+
+    /// Factory function to search the neighbors of all points of a point
+    /// cloud in parallel.
+    static std::shared_ptr<NeighborhoodGraph> CreateFromPointCloud(
+            const PointCloud &pointcloud,
+            const KDTreeSearchParam &search_param = KDTreeSearchParamKNN());
+
+public:
+    std::vector<int> indices_;
+    std::vector<double> distance2_;
+    std::vector<int> offsets_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
@@ -43,12 +43,21 @@ class PinholeCameraIntrinsic;
 namespace geometry {
 
 class Image;
+class NeighborhoodGraph;
 class RGBDImage;
 class TriangleMesh;
 class VoxelGrid;
 
 class PointCloud : public Geometry3D {
 public:
+    /// Indicates how VoxelDownSample reduces the points of a voxel to one.
+    /// \param Mean indicates that the points and colors are averaged, and the
+    /// normals are averaged and normalized.
+    /// \param Median indicates that the component-wise medians are taken, and
+    /// the normals are normalized.
+    /// \param First indicates that the first point of the voxel is kept.
+    enum class VoxelReduction { Mean, Median, First };
+
     PointCloud() : Geometry3D(Geometry::GeometryType::PointCloud) {}
     PointCloud(const std::vector<Eigen::Vector3d> &points)
         : Geometry3D(Geometry::GeometryType::PointCloud), points_(points) {}
@@ -108,9 +117,13 @@ public:
 
     /// Function to downsample \param input pointcloud into output pointcloud
     /// with a voxel \param voxel_size defines the resolution of the voxel grid,
-    /// smaller value leads to denser output point cloud. Normals and colors are
-    /// averaged if they exist.
-    std::shared_ptr<PointCloud> VoxelDownSample(double voxel_size) const;
+    /// smaller value leads to denser output point cloud. The points, normals
+    /// and colors of a voxel are reduced as given by \param reduction. The
+    /// output points are ordered by voxel index, so the output does not
+    /// depend on the number of threads.
+    std::shared_ptr<PointCloud> VoxelDownSample(
+            double voxel_size,
+            VoxelReduction reduction = VoxelReduction::Mean) const;
 
     /// Function to downsample using VoxelDownSample, but specialized for
     /// Surface convolution project. Experimental function.
@@ -156,6 +169,12 @@ public:
             const KDTreeSearchParam &search_param = KDTreeSearchParamKNN(),
             bool fast_normal_computation = true);
 
+    /// Function to compute the normals of a point cloud from the neighbors in
+    /// graph, which must have been created from this point cloud. The graph
+    /// can be shared with other algorithms, such as ComputeFPFHFeature.
+    bool EstimateNormals(const NeighborhoodGraph &graph,
+                         bool fast_normal_computation = true);
+
     /// Function to orient the normals of a point cloud
     /// \param cloud is the input point cloud. It must have normals.
     /// Normals are oriented with respect to \param orientation_reference
@@ -221,12 +240,34 @@ public:
     /// \param ransac_n Number of initial points to be considered inliers in
     /// each iteration.
     /// \param num_iterations Number of iterations.
+    /// \param confidence Stop once a sample of inliers has been drawn with this
+    /// probability, estimated from the best plane so far. 1 runs all the
+    /// iterations.
+    /// \param seed Seed of the random samples, which makes the result
+    /// independent of the number of threads. A negative seed is drawn at
+    /// random.
     /// \return Returns the plane model ax + by + cz + d = 0 and the indices of
     /// the plane inliers.
     std::tuple<Eigen::Vector4d, std::vector<size_t>> SegmentPlane(
             const double distance_threshold = 0.01,
             const int ransac_n = 3,
-            const int num_iterations = 100) const;
+            const int num_iterations = 100,
+            const double confidence = 1.0,
+            const int seed = -1) const;
+
+    /// \brief Segment up to num_planes planes, largest first, by running
+    /// SegmentPlane on the points that are not inliers of a previous plane.
+    ///
+    /// Stops early when fewer than three points remain or no plane is found.
+    /// The other parameters are the ones of SegmentPlane.
+    /// \return Returns the plane models and the indices of their inliers.
+    std::vector<std::tuple<Eigen::Vector4d, std::vector<size_t>>>
+    SegmentPlanes(const int num_planes,
+                  const double distance_threshold = 0.01,
+                  const int ransac_n = 3,
+                  const int num_iterations = 100,
+                  const double confidence = 1.0,
+                  const int seed = -1) const;
 
     /// Factory function to create a pointcloud from a depth image and a camera
     /// model (PointCloudFactory.cpp)
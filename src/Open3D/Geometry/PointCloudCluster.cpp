@@ -27,7 +27,8 @@
 #include "Open3D/Geometry/PointCloud.h"
 
 #include <Eigen/Dense>
-#include <unordered_set>
+#include <algorithm>
+#include <atomic>
 
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Utility/Console.h"
@@ -37,79 +38,154 @@
 #endif
 
 namespace open3d {
+
+namespace {
+
+/// Number of consecutive points handled by one task of ClusterDBSCAN.
+const int kClusterChunkSize = 4096;
+
+/// Returns the root of the set of i. Parents always have smaller indices than
+/// their children, so concurrent path halving keeps the forest valid.
+int FindRoot(std::vector<std::atomic<int>> &parent, int i) {
+    while (true) {
+        int p = parent[i].load(std::memory_order_relaxed);
+        if (p == i) return i;
+        int gp = parent[p].load(std::memory_order_relaxed);
+        if (p != gp) {
+            parent[i].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        }
+        i = gp;
+    }
+}
+
+/// Merges the sets of i and j. The root of a set is its smallest index.
+void Union(std::vector<std::atomic<int>> &parent, int i, int j) {
+    while (true) {
+        i = FindRoot(parent, i);
+        j = FindRoot(parent, j);
+        if (i == j) return;
+        if (i < j) std::swap(i, j);
+        int expected = i;
+        if (parent[i].compare_exchange_strong(expected, j,
+                                              std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+}  // unnamed namespace
+
 namespace geometry {
 
+// Clusters are the connected components of the core points, linked when they
+// are within eps of each other, and are labeled in the order of their
+// smallest core point. Border points get the smallest label of the clusters
+// of their core neighbors. This matches the labels of the serial expansion,
+// which visits the points in order, without storing any neighbor list.
 std::vector<int> PointCloud::ClusterDBSCAN(double eps,
                                            size_t min_points,
                                            bool print_progress) const {
+    const int num_points = int(points_.size());
+    const int num_chunks =
+            (num_points + kClusterChunkSize - 1) / kClusterChunkSize;
     KDTreeFlann kdtree(*this);
 
-    // precompute all neighbours
-    utility::LogDebug("Precompute Neighbours");
-    utility::ConsoleProgressBar progress_bar(
-            points_.size(), "Precompute Neighbours", print_progress);
-    std::vector<std::vector<int>> nbs(points_.size());
+    // A point is a core point if it has at least min_points neighbors,
+    // itself included, so the search stops at min_points neighbors.
+    utility::LogDebug("Find Core Points");
+    utility::ConsoleProgressBar progress_bar(num_chunks, "Find Core Points",
+                                             print_progress);
+    std::vector<char> is_core(num_points, min_points <= 1);
+    if (min_points > 1) {
 #ifdef _OPENMP
-#pragma omp parallel for schedule(static)
+#pragma omp parallel for schedule(dynamic)
 #endif
-    for (int idx = 0; idx < int(points_.size()); ++idx) {
-        std::vector<double> dists2;
-        kdtree.SearchRadius(points_[idx], eps, nbs[idx], dists2);
-
+        for (int c = 0; c < num_chunks; c++) {
+            std::vector<int> indices;
+            std::vector<double> dists2;
+            const int end = std::min(num_points, (c + 1) * kClusterChunkSize);
+            for (int idx = c * kClusterChunkSize; idx < end; ++idx) {
+                is_core[idx] = kdtree.SearchHybrid(points_[idx], eps,
+                                                   int(min_points), indices,
+                                                   dists2) >= int(min_points);
+            }
 #ifdef _OPENMP
 #pragma omp critical
 #endif
-        { ++progress_bar; }
+            { ++progress_bar; }
+        }
     }
-    utility::LogDebug("Done Precompute Neighbours");
+    utility::LogDebug("Done Find Core Points");
 
-    // set all labels to undefined (-2)
+    // Core points are merged with their core neighbors of smaller index.
     utility::LogDebug("Compute Clusters");
-    progress_bar.reset(points_.size(), "Clustering", print_progress);
-    std::vector<int> labels(points_.size(), -2);
-    int cluster_label = 0;
-    for (size_t idx = 0; idx < points_.size(); ++idx) {
-        if (labels[idx] != -2) {  // label is not undefined
-            continue;
+    progress_bar.reset(num_chunks, "Clustering", print_progress);
+    std::vector<std::atomic<int>> parent(num_points);
+    for (int idx = 0; idx < num_points; ++idx) {
+        parent[idx].store(idx, std::memory_order_relaxed);
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int c = 0; c < num_chunks; c++) {
+        std::vector<int> indices;
+        std::vector<double> dists2;
+        const int end = std::min(num_points, (c + 1) * kClusterChunkSize);
+        for (int idx = c * kClusterChunkSize; idx < end; ++idx) {
+            if (!is_core[idx]) continue;
+            kdtree.SearchRadius(points_[idx], eps, indices, dists2);
+            for (int nb : indices) {
+                if (nb < idx && is_core[nb]) {
+                    Union(parent, idx, nb);
+                }
+            }
         }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        { ++progress_bar; }
+    }
 
-        // check density
-        if (nbs[idx].size() < min_points) {
-            labels[idx] = -1;
-            continue;
+    // Roots are the smallest core points of their clusters.
+    std::vector<int> labels(num_points, -1);
+    int cluster_label = 0;
+    for (int idx = 0; idx < num_points; ++idx) {
+        if (is_core[idx] && FindRoot(parent, idx) == idx) {
+            labels[idx] = cluster_label++;
         }
+    }
 
-        std::unordered_set<int> nbs_next(nbs[idx].begin(), nbs[idx].end());
-        std::unordered_set<int> nbs_visited;
-        nbs_visited.insert(int(idx));
-
-        labels[idx] = cluster_label;
-        ++progress_bar;
-        while (!nbs_next.empty()) {
-            int nb = *nbs_next.begin();
-            nbs_next.erase(nbs_next.begin());
-            nbs_visited.insert(nb);
-
-            if (labels[nb] == -1) {  // noise label
-                labels[nb] = cluster_label;
-                ++progress_bar;
-            }
-            if (labels[nb] != -2) {  // not undefined label
+    utility::LogDebug("Label Points");
+    progress_bar.reset(num_chunks, "Labeling", print_progress);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int c = 0; c < num_chunks; c++) {
+        std::vector<int> indices;
+        std::vector<double> dists2;
+        const int end = std::min(num_points, (c + 1) * kClusterChunkSize);
+        for (int idx = c * kClusterChunkSize; idx < end; ++idx) {
+            if (is_core[idx]) {
+                // The labels of roots are only read here.
+                const int root = FindRoot(parent, idx);
+                if (root != idx) labels[idx] = labels[root];
                 continue;
             }
-            labels[nb] = cluster_label;
-            ++progress_bar;
-
-            if (nbs[nb].size() >= min_points) {
-                for (int qnb : nbs[nb]) {
-                    if (nbs_visited.count(qnb) == 0) {
-                        nbs_next.insert(qnb);
-                    }
+            int root = num_points;
+            kdtree.SearchRadius(points_[idx], eps, indices, dists2);
+            for (int nb : indices) {
+                if (is_core[nb]) {
+                    root = std::min(root, FindRoot(parent, nb));
                 }
             }
+            if (root < num_points) {
+                labels[idx] = labels[root];
+            }
         }
-
-        cluster_label++;
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        { ++progress_bar; }
     }
 
     utility::LogDebug("Done Compute Clusters: {:d}", cluster_label);
@@ -28,6 +28,7 @@
 
 #include <Eigen/Dense>
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <numeric>
 #include <random>
@@ -35,6 +36,7 @@
 
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Helper.h"
 
 namespace open3d {
 namespace geometry {
@@ -52,37 +54,71 @@ public:
     double inlier_rmse_;
 };
 
-// Calculates the number of inliers given a list of points and a plane model,
-// and the total distance between the inliers and the plane. These numbers are
-// then used to evaluate how well the plane model fits the given points.
-RANSACResult EvaluateRANSACBasedOnDistance(
-        const std::vector<Eigen::Vector3d> &points,
-        const Eigen::Vector4d plane_model,
-        std::vector<size_t> &inliers,
-        double distance_threshold,
-        double error) {
-    RANSACResult result;
+// Number of points whose distances to all the planes of a batch are
+// evaluated together. The partial sums of the blocks are reduced in order, so
+// the results do not depend on the number of threads.
+constexpr int kRANSACPointBlockSize = 4096;
 
-    for (size_t idx = 0; idx < points.size(); ++idx) {
-        Eigen::Vector4d point(points[idx](0), points[idx](1), points[idx](2),
-                              1);
-        double distance = std::abs(plane_model.dot(point));
+// Calculates the number of inliers among the points listed in indices for each
+// of the plane models, and the total distance between the inliers and the
+// plane. These numbers are then used to evaluate how well the plane models fit
+// the points. Each point is loaded once for all the plane models.
+std::vector<RANSACResult> EvaluateRANSACBasedOnDistance(
+        const std::vector<Eigen::Vector3d> &points,
+        const std::vector<size_t> &indices,
+        const std::vector<Eigen::Vector4d> &plane_models,
+        double distance_threshold) {
+    const int num_models = (int)plane_models.size();
+    const int num_points = (int)indices.size();
+    const int num_blocks =
+            (num_points + kRANSACPointBlockSize - 1) / kRANSACPointBlockSize;
+    // Plane coefficients in structure of arrays layout for vectorization.
+    std::vector<double> a(num_models), b(num_models), c(num_models),
+            d(num_models);
+    for (int m = 0; m < num_models; m++) {
+        a[m] = plane_models[m](0);
+        b[m] = plane_models[m](1);
+        c[m] = plane_models[m](2);
+        d[m] = plane_models[m](3);
+    }
+    std::vector<int> block_inliers((size_t)num_blocks * num_models, 0);
+    std::vector<double> block_errors((size_t)num_blocks * num_models, 0.0);
 
-        if (distance < distance_threshold) {
-            error += distance;
-            inliers.emplace_back(idx);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int block = 0; block < num_blocks; block++) {
+        int *inliers = block_inliers.data() + (size_t)block * num_models;
+        double *errors = block_errors.data() + (size_t)block * num_models;
+        const int end =
+                std::min(num_points, (block + 1) * kRANSACPointBlockSize);
+        for (int i = block * kRANSACPointBlockSize; i < end; i++) {
+            const Eigen::Vector3d &point = points[indices[i]];
+            for (int m = 0; m < num_models; m++) {
+                const double distance = std::abs(a[m] * point(0) +
+                                                 b[m] * point(1) +
+                                                 c[m] * point(2) + d[m]);
+                const bool is_inlier = distance < distance_threshold;
+                inliers[m] += is_inlier;
+                errors[m] += is_inlier ? distance : 0.0;
+            }
         }
     }
 
-    size_t inlier_num = inliers.size();
-    if (inlier_num == 0) {
-        result.fitness_ = 0;
-        result.inlier_rmse_ = 0;
-    } else {
-        result.fitness_ = (double)inlier_num / (double)points.size();
-        result.inlier_rmse_ = error / std::sqrt((double)inlier_num);
+    std::vector<RANSACResult> results(num_models);
+    for (int m = 0; m < num_models; m++) {
+        size_t inlier_num = 0;
+        double error = 0;
+        for (int block = 0; block < num_blocks; block++) {
+            inlier_num += block_inliers[(size_t)block * num_models + m];
+            error += block_errors[(size_t)block * num_models + m];
+        }
+        if (inlier_num > 0) {
+            results[m].fitness_ = (double)inlier_num / (double)num_points;
+            results[m].inlier_rmse_ = error / std::sqrt((double)inlier_num);
+        }
     }
-    return result;
+    return results;
 }
 
 // Find the plane such that the summed squared distance from the
@@ -133,68 +169,75 @@ Eigen::Vector4d GetPlaneFromPoints(const std::vector<Eigen::Vector3d> &points,
     return Eigen::Vector4d(abc(0), abc(1), abc(2), d);
 }
 
-std::tuple<Eigen::Vector4d, std::vector<size_t>> PointCloud::SegmentPlane(
-        const double distance_threshold /* = 0.01 */,
-        const int ransac_n /* = 3 */,
-        const int num_iterations /* = 100 */) const {
-    RANSACResult result;
-    double error = 0;
+// Number of RANSAC iterations evaluated together between two updates of the
+// iteration budget. It is independent of the number of threads to keep seeded
+// results reproducible.
+constexpr int kRANSACBatchSize = 64;
 
-    // Initialize the plane model ax + by + cz + d = 0.
-    Eigen::Vector4d plane_model = Eigen::Vector4d(0, 0, 0, 0);
-    // Initialize the best plane model.
+// Segments a plane among the points listed in indices, using the random
+// stream seed. Iteration itr draws its sample from a generator seeded with
+// (seed, itr), so the result does not depend on the evaluation order.
+std::tuple<Eigen::Vector4d, std::vector<size_t>> SegmentPlaneOnIndices(
+        const std::vector<Eigen::Vector3d> &points,
+        const std::vector<size_t> &indices,
+        const double distance_threshold,
+        const int num_iterations,
+        const double confidence,
+        const unsigned int seed) {
+    // Initialize the best plane model ax + by + cz + d = 0.
     Eigen::Vector4d best_plane_model = Eigen::Vector4d(0, 0, 0, 0);
-
-    // Initialize consensus set.
     std::vector<size_t> inliers;
-
-    size_t num_points = points_.size();
-    std::vector<size_t> indices(num_points);
-    std::iota(std::begin(indices), std::end(indices), 0);
-
-    std::random_device rd;
-    std::mt19937 rng(rd());
-
-    // Return if ransac_n is less than the required plane model parameters.
-    if (ransac_n < 3) {
-        utility::LogError(
-                "ransac_n should be set to higher than or equal to 3.");
+    const int num_points = (int)indices.size();
+    if (num_points < 3) {
         return std::make_tuple(best_plane_model, inliers);
     }
 
-    for (int itr = 0; itr < num_iterations; itr++) {
-        for (int i = 0; i < ransac_n; ++i) {
-            std::swap(indices[i], indices[rng() % num_points]);
-        }
-        inliers.clear();
-        for (int idx = 0; idx < ransac_n; ++idx) {
-            inliers.emplace_back(indices[idx]);
-        }
-
-        // Fit model to num_model_parameters randomly selected points among the
-        // inliers.
-        plane_model = TriangleMesh::ComputeTrianglePlane(
-                points_[inliers[0]], points_[inliers[1]], points_[inliers[2]]);
-        if (plane_model.isZero(0)) {
-            continue;
+    RANSACResult result;
+    std::vector<Eigen::Vector4d> plane_models;
+    int max_iteration = num_iterations;
+    for (int begin = 0; begin < max_iteration; begin += kRANSACBatchSize) {
+        const int end = std::min(begin + kRANSACBatchSize, max_iteration);
+        plane_models.clear();
+        for (int itr = begin; itr < end; itr++) {
+            std::seed_seq seed_seq{seed, (unsigned int)itr};
+            std::mt19937 rng(seed_seq);
+            std::uniform_int_distribution<int> distribution(0, num_points - 1);
+            // Fit the plane to three distinct random points.
+            int sample[3];
+            for (int j = 0; j < 3; j++) {
+                do {
+                    sample[j] = distribution(rng);
+                } while (std::find(sample, sample + j, sample[j]) !=
+                         sample + j);
+            }
+            const Eigen::Vector4d plane_model =
+                    TriangleMesh::ComputeTrianglePlane(
+                            points[indices[sample[0]]],
+                            points[indices[sample[1]]],
+                            points[indices[sample[2]]]);
+            if (!plane_model.isZero(0)) {
+                plane_models.push_back(plane_model);
+            }
         }
-
-        error = 0;
-        inliers.clear();
-        auto this_result = EvaluateRANSACBasedOnDistance(
-                points_, plane_model, inliers, distance_threshold, error);
-        if (this_result.fitness_ > result.fitness_ ||
-            (this_result.fitness_ == result.fitness_ &&
-             this_result.inlier_rmse_ < result.inlier_rmse_)) {
-            result = this_result;
-            best_plane_model = plane_model;
+        const auto batch_results = EvaluateRANSACBasedOnDistance(
+                points, indices, plane_models, distance_threshold);
+        // Reduce in iteration order, so that ties are broken consistently.
+        for (size_t m = 0; m < plane_models.size(); m++) {
+            const auto &this_result = batch_results[m];
+            if (this_result.fitness_ > result.fitness_ ||
+                (this_result.fitness_ == result.fitness_ &&
+                 this_result.inlier_rmse_ < result.inlier_rmse_)) {
+                result = this_result;
+                best_plane_model = plane_models[m];
+                max_iteration = utility::GetRANSACIterations(
+                        confidence, result.fitness_, 3, max_iteration);
+            }
         }
     }
 
     // Find the final inliers using best_plane_model.
-    inliers.clear();
-    for (size_t idx = 0; idx < points_.size(); ++idx) {
-        Eigen::Vector4d point(points_[idx](0), points_[idx](1), points_[idx](2),
+    for (size_t idx : indices) {
+        Eigen::Vector4d point(points[idx](0), points[idx](1), points[idx](2),
                               1);
         double distance = std::abs(best_plane_model.dot(point));
 
@@ -204,12 +247,71 @@ std::tuple<Eigen::Vector4d, std::vector<size_t>> PointCloud::SegmentPlane(
     }
 
     // Improve best_plane_model using the final inliers.
-    best_plane_model = GetPlaneFromPoints(points_, inliers);
+    if (!inliers.empty()) {
+        best_plane_model = GetPlaneFromPoints(points, inliers);
+    }
 
     utility::LogDebug("RANSAC | Inliers: {:d}, Fitness: {:e}, RMSE: {:e}",
                       inliers.size(), result.fitness_, result.inlier_rmse_);
     return std::make_tuple(best_plane_model, inliers);
 }
 
+std::tuple<Eigen::Vector4d, std::vector<size_t>> PointCloud::SegmentPlane(
+        const double distance_threshold /* = 0.01 */,
+        const int ransac_n /* = 3 */,
+        const int num_iterations /* = 100 */,
+        const double confidence /* = 1.0 */,
+        const int seed /* = -1 */) const {
+    // Return if ransac_n is less than the required plane model parameters.
+    if (ransac_n < 3) {
+        utility::LogError(
+                "ransac_n should be set to higher than or equal to 3.");
+    }
+
+    std::vector<size_t> indices(points_.size());
+    std::iota(std::begin(indices), std::end(indices), 0);
+    return SegmentPlaneOnIndices(points_, indices, distance_threshold,
+                                 num_iterations, confidence,
+                                 utility::GetRANSACSeed(seed));
+}
+
+std::vector<std::tuple<Eigen::Vector4d, std::vector<size_t>>>
+PointCloud::SegmentPlanes(const int num_planes,
+                          const double distance_threshold /* = 0.01 */,
+                          const int ransac_n /* = 3 */,
+                          const int num_iterations /* = 100 */,
+                          const double confidence /* = 1.0 */,
+                          const int seed /* = -1 */) const {
+    if (ransac_n < 3) {
+        utility::LogError(
+                "ransac_n should be set to higher than or equal to 3.");
+    }
+
+    std::vector<std::tuple<Eigen::Vector4d, std::vector<size_t>>> planes;
+    // Points that are not inliers of a previous plane.
+    std::vector<size_t> indices(points_.size());
+    std::iota(std::begin(indices), std::end(indices), 0);
+    std::vector<bool> is_inlier(points_.size(), false);
+    const unsigned int plane_seed = utility::GetRANSACSeed(seed);
+    for (int p = 0; p < num_planes && indices.size() >= 3; p++) {
+        auto plane = SegmentPlaneOnIndices(points_, indices, distance_threshold,
+                                           num_iterations, confidence,
+                                           plane_seed + p);
+        const auto &inliers = std::get<1>(plane);
+        if (inliers.empty()) {
+            break;
+        }
+        for (size_t idx : inliers) {
+            is_inlier[idx] = true;
+        }
+        indices.erase(
+                std::remove_if(indices.begin(), indices.end(),
+                               [&](size_t idx) { return is_inlier[idx]; }),
+                indices.end());
+        planes.push_back(std::move(plane));
+    }
+    return planes;
+}
+
 }  // namespace geometry
 }  // namespace open3d
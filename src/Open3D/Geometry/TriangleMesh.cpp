@@ -26,12 +26,14 @@
 
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Geometry/BoundingVolume.h"
+#include "Open3D/Geometry/BoundingVolumeHierarchy.h"
 #include "Open3D/Geometry/IntersectionTest.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/Qhull.h"
 
 #include <Eigen/Dense>
+#include <atomic>
 #include <numeric>
 #include <queue>
 #include <random>
@@ -1305,40 +1307,66 @@ bool TriangleMesh::IsVertexManifold() const {
     return GetNonManifoldVertices().empty();
 }
 
+bool IsNonAdjacentTrianglePairIntersecting(const TriangleMesh &mesh,
+                                           int tidx0,
+                                           int tidx1) {
+    const Eigen::Vector3i &tria_p = mesh.triangles_[tidx0];
+    const Eigen::Vector3i &tria_q = mesh.triangles_[tidx1];
+    // check if neighbour triangle
+    if (tria_p(0) == tria_q(0) || tria_p(0) == tria_q(1) ||
+        tria_p(0) == tria_q(2) || tria_p(1) == tria_q(0) ||
+        tria_p(1) == tria_q(1) || tria_p(1) == tria_q(2) ||
+        tria_p(2) == tria_q(0) || tria_p(2) == tria_q(1) ||
+        tria_p(2) == tria_q(2)) {
+        return false;
+    }
+
+    // check for intersection
+    const Eigen::Vector3d &p0 = mesh.vertices_[tria_p(0)];
+    const Eigen::Vector3d &p1 = mesh.vertices_[tria_p(1)];
+    const Eigen::Vector3d &p2 = mesh.vertices_[tria_p(2)];
+    const Eigen::Vector3d &q0 = mesh.vertices_[tria_q(0)];
+    const Eigen::Vector3d &q1 = mesh.vertices_[tria_q(1)];
+    const Eigen::Vector3d &q2 = mesh.vertices_[tria_q(2)];
+    return IntersectionTest::TriangleTriangle3d(p0, p1, p2, q0, q1, q2);
+}
+
 std::vector<Eigen::Vector2i> TriangleMesh::GetSelfIntersectingTriangles()
         const {
     std::vector<Eigen::Vector2i> self_intersecting_triangles;
-    for (size_t tidx0 = 0; tidx0 < triangles_.size() - 1; ++tidx0) {
-        const Eigen::Vector3i &tria_p = triangles_[tidx0];
-        const Eigen::Vector3d &p0 = vertices_[tria_p(0)];
-        const Eigen::Vector3d &p1 = vertices_[tria_p(1)];
-        const Eigen::Vector3d &p2 = vertices_[tria_p(2)];
-        for (size_t tidx1 = tidx0 + 1; tidx1 < triangles_.size(); ++tidx1) {
-            const Eigen::Vector3i &tria_q = triangles_[tidx1];
-            // check if neighbour triangle
-            if (tria_p(0) == tria_q(0) || tria_p(0) == tria_q(1) ||
-                tria_p(0) == tria_q(2) || tria_p(1) == tria_q(0) ||
-                tria_p(1) == tria_q(1) || tria_p(1) == tria_q(2) ||
-                tria_p(2) == tria_q(0) || tria_p(2) == tria_q(1) ||
-                tria_p(2) == tria_q(2)) {
-                continue;
-            }
-
-            // check for intersection
-            const Eigen::Vector3d &q0 = vertices_[tria_q(0)];
-            const Eigen::Vector3d &q1 = vertices_[tria_q(1)];
-            const Eigen::Vector3d &q2 = vertices_[tria_q(2)];
-            if (IntersectionTest::TriangleTriangle3d(p0, p1, p2, q0, q1, q2)) {
+    BoundingVolumeHierarchy bvh(*this);
+    bvh.TraverseOverlappingPairs(bvh, [&](int tidx0, int tidx1) {
+        if (IsNonAdjacentTrianglePairIntersecting(*this, tidx0, tidx1)) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            {
                 self_intersecting_triangles.push_back(
                         Eigen::Vector2i(tidx0, tidx1));
             }
         }
-    }
+        return true;
+    });
+    // The traversal runs in parallel, sort to get a deterministic order.
+    std::sort(self_intersecting_triangles.begin(),
+              self_intersecting_triangles.end(),
+              [](const Eigen::Vector2i &a, const Eigen::Vector2i &b) {
+                  return a(0) < b(0) || (a(0) == b(0) && a(1) < b(1));
+              });
     return self_intersecting_triangles;
 }
 
 bool TriangleMesh::IsSelfIntersecting() const {
-    return !GetSelfIntersectingTriangles().empty();
+    std::atomic<bool> self_intersecting(false);
+    BoundingVolumeHierarchy bvh(*this);
+    bvh.TraverseOverlappingPairs(bvh, [&](int tidx0, int tidx1) {
+        if (IsNonAdjacentTrianglePairIntersecting(*this, tidx0, tidx1)) {
+            self_intersecting = true;
+            return false;
+        }
+        return true;
+    });
+    return self_intersecting;
 }
 
 bool TriangleMesh::IsBoundingBoxIntersecting(const TriangleMesh &other) const {
@@ -1350,22 +1378,25 @@ bool TriangleMesh::IsIntersecting(const TriangleMesh &other) const {
     if (!IsBoundingBoxIntersecting(other)) {
         return false;
     }
-    for (size_t tidx0 = 0; tidx0 < triangles_.size(); ++tidx0) {
+    std::atomic<bool> intersecting(false);
+    BoundingVolumeHierarchy bvh(*this);
+    BoundingVolumeHierarchy other_bvh(other);
+    bvh.TraverseOverlappingPairs(other_bvh, [&](int tidx0, int tidx1) {
         const Eigen::Vector3i &tria_p = triangles_[tidx0];
+        const Eigen::Vector3i &tria_q = other.triangles_[tidx1];
         const Eigen::Vector3d &p0 = vertices_[tria_p(0)];
         const Eigen::Vector3d &p1 = vertices_[tria_p(1)];
         const Eigen::Vector3d &p2 = vertices_[tria_p(2)];
-        for (size_t tidx1 = 0; tidx1 < other.triangles_.size(); ++tidx1) {
-            const Eigen::Vector3i &tria_q = other.triangles_[tidx1];
-            const Eigen::Vector3d &q0 = other.vertices_[tria_q(0)];
-            const Eigen::Vector3d &q1 = other.vertices_[tria_q(1)];
-            const Eigen::Vector3d &q2 = other.vertices_[tria_q(2)];
-            if (IntersectionTest::TriangleTriangle3d(p0, p1, p2, q0, q1, q2)) {
-                return true;
-            }
+        const Eigen::Vector3d &q0 = other.vertices_[tria_q(0)];
+        const Eigen::Vector3d &q1 = other.vertices_[tria_q(1)];
+        const Eigen::Vector3d &q2 = other.vertices_[tria_q(2)];
+        if (IntersectionTest::TriangleTriangle3d(p0, p1, p2, q0, q1, q2)) {
+            intersecting = true;
+            return false;
         }
-    }
-    return false;
+        return true;
+    });
+    return intersecting;
 }
 
 std::tuple<std::vector<int>, std::vector<size_t>, std::vector<double>>
@@ -220,7 +220,8 @@ public:
     std::vector<Eigen::Vector2i> GetSelfIntersectingTriangles() const;
 
     /// Function that tests if the triangle mesh is self-intersecting.
-    /// Tests each triangle pair for intersection.
+    /// Tests each triangle pair with overlapping bounding boxes for
+    /// intersection.
     bool IsSelfIntersecting() const;
 
     /// Function that tests if the bounding boxes of the triangle meshes are
@@ -228,7 +229,8 @@ public:
     bool IsBoundingBoxIntersecting(const TriangleMesh &other) const;
 
     /// Function that tests if the triangle mesh intersects another triangle
-    /// mesh. Tests each triangle against each other triangle.
+    /// mesh. Tests each triangle against each other triangle with an
+    /// overlapping bounding box.
     bool IsIntersecting(const TriangleMesh &other) const;
 
     /// Function that tests if the given triangle mesh is orientable, i.e.
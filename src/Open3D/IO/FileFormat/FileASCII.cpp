@@ -0,0 +1,563 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/IO/FileFormat/FileASCII.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+
+namespace {
+
+/// Text is read in chunks of about this size, which bounds the staging
+/// memory for large files.
+constexpr size_t kASCIIChunkSizeInBytes = 64 * 1024 * 1024;
+/// Each chunk is split at line breaks into pieces of about this size, which
+/// are parsed by one thread each.
+constexpr size_t kASCIIPieceSizeInBytes = 1024 * 1024;
+/// Number of rows formatted by one thread at a time.
+constexpr size_t kASCIIBlockSize = 16384;
+/// Number of blocks formatted in parallel before they are written.
+constexpr size_t kASCIIBlocksPerBatch = 64;
+
+/// Powers of ten that are exactly representable as doubles.
+const double kExactPowersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                   1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                   1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                   1e18, 1e19, 1e20, 1e21, 1e22};
+
+/// Significands and binary exponents of the normalized 64 bit
+/// approximations of 10^-348, 10^-340, ..., 10^340.
+const std::uint64_t kCachedPowersF[] = {
+        0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+        0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+        0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+        0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+        0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+        0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+        0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+        0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+        0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+        0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+        0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+        0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+        0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+        0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+        0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+        0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+        0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+        0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+        0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+        0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+        0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+        0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+        0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+        0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+        0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+        0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+        0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+        0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+        0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL};
+const int kCachedPowersE[] = {
+        -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+        -954, -927, -901, -874, -847, -821, -794, -768, -741, -715, -688, -661,
+        -635, -608, -582, -555, -529, -502, -475, -449, -422, -396, -369, -343,
+        -316, -289, -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3,
+        30, 56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348, 375, 402,
+        428, 455, 481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747, 774,
+        800, 827, 853, 880, 907, 933, 960, 986, 1013, 1039, 1066};
+
+const std::uint64_t kPowersOf10U64[] = {1ULL,
+                                        10ULL,
+                                        100ULL,
+                                        1000ULL,
+                                        10000ULL,
+                                        100000ULL,
+                                        1000000ULL,
+                                        10000000ULL,
+                                        100000000ULL,
+                                        1000000000ULL,
+                                        10000000000ULL,
+                                        100000000000ULL,
+                                        1000000000000ULL,
+                                        10000000000000ULL,
+                                        100000000000000ULL,
+                                        1000000000000000ULL,
+                                        10000000000000000ULL,
+                                        100000000000000000ULL,
+                                        1000000000000000000ULL,
+                                        10000000000000000000ULL};
+
+constexpr std::uint64_t kDoubleHiddenBit = std::uint64_t(1) << 52;
+
+/// A floating point number f * 2^e with a 64 bit significand.
+struct DiyFp {
+    DiyFp(std::uint64_t f, int e) : f_(f), e_(e) {}
+
+    explicit DiyFp(double value) {
+        std::uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        const int biased_e = (int)((bits >> 52) & 0x7FF);
+        const std::uint64_t significand = bits & (kDoubleHiddenBit - 1);
+        if (biased_e != 0) {
+            f_ = significand + kDoubleHiddenBit;
+            e_ = biased_e - 1075;
+        } else {
+            f_ = significand;
+            e_ = -1074;
+        }
+    }
+
+    /// The upper 64 bits of the product, rounded.
+    DiyFp operator*(const DiyFp &other) const {
+        const std::uint64_t mask = 0xFFFFFFFFULL;
+        const std::uint64_t a = f_ >> 32, b = f_ & mask;
+        const std::uint64_t c = other.f_ >> 32, d = other.f_ & mask;
+        const std::uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+        const std::uint64_t tmp = (bd >> 32) + (ad & mask) + (bc & mask) +
+                                  (std::uint64_t(1) << 31);
+        return DiyFp(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32),
+                     e_ + other.e_ + 64);
+    }
+
+    DiyFp Normalize() const {
+        DiyFp res = *this;
+        while (!(res.f_ & (std::uint64_t(1) << 63))) {
+            res.f_ <<= 1;
+            res.e_--;
+        }
+        return res;
+    }
+
+    std::uint64_t f_;
+    int e_;
+};
+
+/// Writes the digits of a positive value to buffer, such that value rounds
+/// from digits * 10^K. This is the Grisu2 algorithm of Loitsch, "Printing
+/// Floating-Point Numbers Quickly and Accurately with Integers". Its digits
+/// always read back to value, and are the shortest such digits for all but
+/// a small fraction of values.
+void Grisu2(double value, char *buffer, int &length, int &K) {
+    const DiyFp v(value);
+    // Boundaries halfway to the neighboring doubles, normalized to the
+    // binary exponent of the upper one.
+    DiyFp plus((v.f_ << 1) + 1, v.e_ - 1);
+    while (!(plus.f_ & (kDoubleHiddenBit << 1))) {
+        plus.f_ <<= 1;
+        plus.e_--;
+    }
+    plus.f_ <<= 10;
+    plus.e_ -= 10;
+    DiyFp minus = (v.f_ == kDoubleHiddenBit)
+                          ? DiyFp((v.f_ << 2) - 1, v.e_ - 2)
+                          : DiyFp((v.f_ << 1) - 1, v.e_ - 1);
+    minus.f_ <<= minus.e_ - plus.e_;
+    minus.e_ = plus.e_;
+
+    // A cached power of ten that brings the binary exponent of the scaled
+    // boundaries into [-60, -32].
+    const double dk = (-61 - plus.e_) * 0.30102999566398114 + 347;
+    int k = (int)dk;
+    if (dk - k > 0.0) {
+        k++;
+    }
+    const int index = (k >> 3) + 1;
+    K = -(-348 + index * 8);
+    const DiyFp c_mk(kCachedPowersF[index], kCachedPowersE[index]);
+
+    const DiyFp w = v.Normalize() * c_mk;
+    DiyFp w_plus = plus * c_mk;
+    DiyFp w_minus = minus * c_mk;
+    w_minus.f_++;
+    w_plus.f_--;
+    std::uint64_t delta = w_plus.f_ - w_minus.f_;
+    const std::uint64_t w_plus_minus_w = w_plus.f_ - w.f_;
+
+    // Generates digits of w_plus until the rest is within delta, then moves
+    // the last digit towards w.
+    const int shift = -w_plus.e_;
+    const std::uint64_t one = std::uint64_t(1) << shift;
+    std::uint32_t p1 = (std::uint32_t)(w_plus.f_ >> shift);
+    std::uint64_t p2 = w_plus.f_ & (one - 1);
+    int kappa = 1;
+    while (kappa < 10 && p1 >= kPowersOf10U64[kappa]) {
+        kappa++;
+    }
+    length = 0;
+    std::uint64_t rest, ten_kappa, w_plus_minus_w_scaled;
+    while (true) {
+        if (kappa > 0) {
+            const std::uint32_t power =
+                    (std::uint32_t)kPowersOf10U64[kappa - 1];
+            const std::uint32_t d = p1 / power;
+            p1 %= power;
+            if (d || length) {
+                buffer[length++] = (char)('0' + d);
+            }
+            kappa--;
+            rest = ((std::uint64_t)p1 << shift) + p2;
+            if (rest <= delta) {
+                ten_kappa = kPowersOf10U64[kappa] << shift;
+                w_plus_minus_w_scaled = w_plus_minus_w;
+                break;
+            }
+        } else {
+            p2 *= 10;
+            delta *= 10;
+            const char d = (char)(p2 >> shift);
+            if (d || length) {
+                buffer[length++] = (char)('0' + d);
+            }
+            p2 &= one - 1;
+            kappa--;
+            if (p2 < delta) {
+                rest = p2;
+                ten_kappa = one;
+                w_plus_minus_w_scaled =
+                        -kappa < 20 ? w_plus_minus_w * kPowersOf10U64[-kappa]
+                                    : 0;
+                break;
+            }
+        }
+    }
+    K += kappa;
+    while (rest < w_plus_minus_w_scaled && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < w_plus_minus_w_scaled ||
+            w_plus_minus_w_scaled - rest >
+                    rest + ten_kappa - w_plus_minus_w_scaled)) {
+        buffer[length - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool IsBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/// Parses the lines in [begin, end) and appends the values of every row to
+/// values. end follows a line break, or is the end of the text, and *end can
+/// be read.
+void ParseASCIIRows(const char *begin,
+                    const char *end,
+                    int num_values,
+                    bool skip_invalid_rows,
+                    std::vector<double> &values) {
+    std::vector<double> row(num_values);
+    const char *line = begin;
+    while (line < end) {
+        const char *line_end =
+                (const char *)memchr(line, '\n', (size_t)(end - line));
+        if (line_end == nullptr) {
+            line_end = end;
+        }
+        const char *ptr = line;
+        int k = 0;
+        for (; k < num_values; k++) {
+            while (ptr < line_end && IsBlank(*ptr)) {
+                ptr++;
+            }
+            if (ptr == line_end) {
+                break;
+            }
+            ptr = io::ParseASCIIDouble(ptr, row[k]);
+            if (ptr == nullptr) {
+                break;
+            }
+        }
+        if (k == num_values) {
+            values.insert(values.end(), row.begin(), row.end());
+        } else if (!skip_invalid_rows) {
+            values.resize(values.size() + num_values, 0.0);
+        }
+        line = line_end + 1;
+    }
+}
+
+}  // unnamed namespace
+
+namespace io {
+
+const char *ParseASCIIDouble(const char *str, double &value) {
+    // A mantissa of at most 2^53 and a power of ten of at most 10^22 are
+    // both exact, so one multiplication or division rounds correctly.
+    const char *ptr = str;
+    const bool negative = (*ptr == '-');
+    if (*ptr == '-' || *ptr == '+') {
+        ptr++;
+    }
+    std::uint64_t mantissa = 0;
+    int num_digits = 0;
+    int exponent = 0;
+    for (; IsDigit(*ptr); ptr++, num_digits++) {
+        mantissa = mantissa * 10 + (std::uint64_t)(*ptr - '0');
+    }
+    if (*ptr == '.') {
+        ptr++;
+        for (; IsDigit(*ptr); ptr++, num_digits++, exponent--) {
+            mantissa = mantissa * 10 + (std::uint64_t)(*ptr - '0');
+        }
+    }
+    bool fast_path = num_digits > 0 && num_digits <= 19;
+    if (fast_path && (*ptr == 'e' || *ptr == 'E')) {
+        ptr++;
+        const bool negative_exponent = (*ptr == '-');
+        if (*ptr == '-' || *ptr == '+') {
+            ptr++;
+        }
+        fast_path = IsDigit(*ptr);
+        int exponent_value = 0;
+        for (; IsDigit(*ptr); ptr++) {
+            if (exponent_value < 10000) {
+                exponent_value = exponent_value * 10 + (*ptr - '0');
+            }
+        }
+        exponent += negative_exponent ? -exponent_value : exponent_value;
+    }
+    fast_path = fast_path && mantissa <= (std::uint64_t(1) << 53) &&
+                exponent >= -22 && exponent <= 22 &&
+                (IsBlank(*ptr) || *ptr == '\n' || *ptr == '\0');
+    if (fast_path) {
+        double result = (double)mantissa;
+        if (exponent < 0) {
+            result /= kExactPowersOf10[-exponent];
+        } else {
+            result *= kExactPowersOf10[exponent];
+        }
+        value = negative ? -result : result;
+        return ptr;
+    }
+    // strtod would skip white space, including line breaks.
+    if (std::isspace((unsigned char)*str)) {
+        return nullptr;
+    }
+    char *end;
+    const double result = std::strtod(str, &end);
+    if (end == str) {
+        return nullptr;
+    }
+    value = result;
+    return end;
+}
+
+bool ReadASCIIRows(
+        FILE *file,
+        int num_values,
+        const std::function<void(const double *, size_t)> &append_rows,
+        bool skip_invalid_rows /* = true*/,
+        size_t max_num_rows /* = std::numeric_limits<size_t>::max()*/,
+        utility::ConsoleProgressBar *progress_bar /* = nullptr*/) {
+    // One extra byte holds a terminating zero after the text.
+    size_t capacity = kASCIIChunkSizeInBytes;
+    std::unique_ptr<char[]> buffer(new char[capacity + 1]);
+    size_t num_carried = 0;
+    size_t num_rows = 0;
+    bool end_of_file = false;
+    while (!end_of_file && num_rows < max_num_rows) {
+        if (num_carried == capacity) {
+            // A line that does not fit in the buffer.
+            std::unique_ptr<char[]> larger_buffer(new char[2 * capacity + 1]);
+            memcpy(larger_buffer.get(), buffer.get(), num_carried);
+            buffer = std::move(larger_buffer);
+            capacity *= 2;
+        }
+        const size_t num_read = fread(buffer.get() + num_carried, 1,
+                                      capacity - num_carried, file);
+        if (num_read < capacity - num_carried) {
+            if (ferror(file)) {
+                utility::LogWarning("[ReadASCIIRows] Failed to read text.");
+                return false;
+            }
+            end_of_file = true;
+        }
+        const size_t size = num_carried + num_read;
+        buffer[size] = '\0';
+
+        // The text after the last line break is parsed with the next chunk.
+        size_t parse_size = size;
+        if (!end_of_file) {
+            while (parse_size > 0 && buffer[parse_size - 1] != '\n') {
+                parse_size--;
+            }
+            if (parse_size == 0) {
+                num_carried = size;
+                continue;
+            }
+        }
+
+        std::vector<size_t> piece_begins(1, 0);
+        while (piece_begins.back() + kASCIIPieceSizeInBytes < parse_size) {
+            const size_t search_begin =
+                    piece_begins.back() + kASCIIPieceSizeInBytes;
+            const char *line_break = (const char *)memchr(
+                    buffer.get() + search_begin, '\n',
+                    parse_size - search_begin);
+            if (line_break == nullptr ||
+                (size_t)(line_break - buffer.get()) + 1 == parse_size) {
+                break;
+            }
+            piece_begins.push_back(line_break - buffer.get() + 1);
+        }
+        piece_begins.push_back(parse_size);
+        const int num_pieces = (int)piece_begins.size() - 1;
+        std::vector<std::vector<double>> piece_values(num_pieces);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = 0; i < num_pieces; i++) {
+            ParseASCIIRows(buffer.get() + piece_begins[i],
+                           buffer.get() + piece_begins[i + 1], num_values,
+                           skip_invalid_rows, piece_values[i]);
+        }
+
+        for (int i = 0; i < num_pieces && num_rows < max_num_rows; i++) {
+            const size_t num_piece_rows =
+                    std::min(piece_values[i].size() / num_values,
+                             max_num_rows - num_rows);
+            append_rows(piece_values[i].data(), num_piece_rows);
+            num_rows += num_piece_rows;
+            if (progress_bar != nullptr) {
+                for (size_t j = 0; j < num_piece_rows; j++) {
+                    ++(*progress_bar);
+                }
+            }
+        }
+
+        num_carried = size - parse_size;
+        memmove(buffer.get(), buffer.get() + parse_size, num_carried);
+    }
+    return true;
+}
+
+void AppendASCIIDouble(std::string &buffer, double value) {
+    if (value != value) {
+        buffer += "nan";
+        return;
+    }
+    if (std::signbit(value)) {
+        buffer += '-';
+        value = -value;
+    }
+    if (value == 0.0) {
+        buffer += '0';
+        return;
+    }
+    if (value == std::numeric_limits<double>::infinity()) {
+        buffer += "inf";
+        return;
+    }
+    char digits[32];
+    int length, K;
+    Grisu2(value, digits, length, K);
+    // Numbers of at least 1e-6 and below 1e21 are printed without an
+    // exponent, as in JavaScript.
+    const int point = length + K;
+    if (length <= point && point <= 21) {
+        buffer.append(digits, length);
+        buffer.append(point - length, '0');
+    } else if (0 < point && point <= 21) {
+        buffer.append(digits, point);
+        buffer += '.';
+        buffer.append(digits + point, length - point);
+    } else if (-6 < point && point <= 0) {
+        buffer += "0.";
+        buffer.append(-point, '0');
+        buffer.append(digits, length);
+    } else {
+        buffer += digits[0];
+        if (length > 1) {
+            buffer += '.';
+            buffer.append(digits + 1, length - 1);
+        }
+        buffer += 'e';
+        AppendASCIIInt(buffer, point - 1);
+    }
+}
+
+void AppendASCIIInt(std::string &buffer, int value) {
+    char str[16];
+    snprintf(str, sizeof(str), "%d", value);
+    buffer += str;
+}
+
+bool WriteASCIIRows(
+        FILE *file,
+        size_t num_rows,
+        const std::function<void(size_t, std::string &)> &format_row,
+        utility::ConsoleProgressBar *progress_bar /* = nullptr*/) {
+    const size_t num_blocks =
+            (num_rows + kASCIIBlockSize - 1) / kASCIIBlockSize;
+    std::vector<std::string> buffers(kASCIIBlocksPerBatch);
+    for (size_t batch_begin = 0; batch_begin < num_blocks;
+         batch_begin += kASCIIBlocksPerBatch) {
+        const int num_batch_blocks = (int)std::min(kASCIIBlocksPerBatch,
+                                                   num_blocks - batch_begin);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int b = 0; b < num_batch_blocks; b++) {
+            std::string &buffer = buffers[b];
+            buffer.clear();
+            const size_t row_begin = (batch_begin + b) * kASCIIBlockSize;
+            const size_t row_end =
+                    std::min(row_begin + kASCIIBlockSize, num_rows);
+            for (size_t i = row_begin; i < row_end; i++) {
+                format_row(i, buffer);
+            }
+        }
+        for (int b = 0; b < num_batch_blocks; b++) {
+            if (fwrite(buffers[b].data(), 1, buffers[b].size(), file) !=
+                buffers[b].size()) {
+                utility::LogWarning("[WriteASCIIRows] Failed to write text.");
+                return false;
+            }
+            if (progress_bar != nullptr) {
+                const size_t row_begin = (batch_begin + b) * kASCIIBlockSize;
+                const size_t row_end =
+                        std::min(row_begin + kASCIIBlockSize, num_rows);
+                for (size_t i = row_begin; i < row_end; i++) {
+                    ++(*progress_bar);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace io
+}  // namespace open3d
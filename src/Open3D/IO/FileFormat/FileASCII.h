@@ -0,0 +1,83 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <string>
+
+namespace open3d {
+
+namespace utility {
+class ConsoleProgressBar;
+}  // namespace utility
+
+namespace io {
+
+/// Parses a decimal number at str, with optional sign, fraction and
+/// exponent. Values that are not exactly representable through the fast
+/// path, and spellings such as inf or nan, are parsed by strtod.
+/// \return The character after the number, or nullptr if there is none.
+const char *ParseASCIIDouble(const char *str, double &value);
+
+/// Reads the text lines of file from its current position on. A line that
+/// starts with num_values numbers separated by white space is a row of these
+/// values, and other lines are skipped. With skip_invalid_rows set to false
+/// they are rows of zeros instead. Reading stops after max_num_rows rows.
+/// The file is read in large chunks whose lines are parsed in parallel.
+/// append_rows receives the rows in file order, num_rows * num_values values
+/// at a time. progress_bar, if not nullptr, advances once per row.
+/// \return false if the file could not be read.
+bool ReadASCIIRows(
+        FILE *file,
+        int num_values,
+        const std::function<void(const double *values, size_t num_rows)>
+                &append_rows,
+        bool skip_invalid_rows = true,
+        size_t max_num_rows = std::numeric_limits<size_t>::max(),
+        utility::ConsoleProgressBar *progress_bar = nullptr);
+
+/// Appends the shortest decimal representation of value that reads back to
+/// the same double.
+void AppendASCIIDouble(std::string &buffer, double value);
+
+/// Appends value in decimal.
+void AppendASCIIInt(std::string &buffer, int value);
+
+/// Writes num_rows lines to file. format_row appends the text of row i,
+/// including its line ending, to a buffer. Rows are formatted in parallel
+/// into large buffers that are written with one fwrite each.
+/// \return false if the file could not be written.
+bool WriteASCIIRows(
+        FILE *file,
+        size_t num_rows,
+        const std::function<void(size_t, std::string &)> &format_row,
+        utility::ConsoleProgressBar *progress_bar = nullptr);
+
+}  // namespace io
+}  // namespace open3d
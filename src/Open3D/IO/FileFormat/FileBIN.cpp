@@ -84,8 +84,13 @@ bool ReadFeatureFromBIN(const std::string &filename,
                             filename);
         return false;
     }
-    bool success = ReadMatrixXdFromBINFile(fid, feature.data_);
+    // Features are stored in double precision in the file.
+    Eigen::MatrixXd data;
+    bool success = ReadMatrixXdFromBINFile(fid, data);
     fclose(fid);
+    if (success) {
+        feature.data_ = data.cast<float>();
+    }
     return success;
 }
 
@@ -97,7 +102,7 @@ bool WriteFeatureToBIN(const std::string &filename,
                             filename);
         return false;
     }
-    bool success = WriteMatrixXdToBINFile(fid, feature.data_);
+    bool success = WriteMatrixXdToBINFile(fid, feature.data_.cast<double>());
     fclose(fid);
     return success;
 }
@@ -25,6 +25,7 @@
 // ----------------------------------------------------------------------------
 
 #include <liblzf/lzf.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <sstream>
@@ -234,64 +235,168 @@ bool ReadPCDHeader(FILE *file, PCDHeader &header) {
     return true;
 }
 
-double UnpackBinaryPCDElement(const char *data_ptr,
-                              const char type,
-                              const int size) {
+/// Binary payloads are read, unpacked and written in chunks of about this
+/// size, which bounds the staging memory for large files.
+constexpr size_t kPCDChunkSizeInBytes = 64 * 1024 * 1024;
+/// Number of points unpacked or packed by one thread at a time.
+constexpr int kPCDBlockSize = 4096;
+
+/// Unpacks num values of a field into every third double of data, which
+/// walks one coordinate of a std::vector<Eigen::Vector3d>. The values of
+/// consecutive points are stride bytes apart in the binary buffer.
+typedef void (*PCDUnpackFunction)(const char *data_ptr,
+                                  size_t stride,
+                                  int num,
+                                  double *data);
+
+template <typename T>
+void UnpackBinaryPCDField(const char *data_ptr,
+                          size_t stride,
+                          int num,
+                          double *data) {
+    for (int i = 0; i < num; i++) {
+        T value;
+        memcpy(&value, data_ptr + i * stride, sizeof(T));
+        data[3 * i] = (double)value;
+    }
+}
+
+void UnpackBinaryPCDZero(const char *data_ptr,
+                         size_t stride,
+                         int num,
+                         double *data) {
+    for (int i = 0; i < num; i++) {
+        data[3 * i] = 0.0;
+    }
+}
+
+void UnpackBinaryPCDColor(const char *data_ptr,
+                          size_t stride,
+                          int num,
+                          double *data) {
+    for (int i = 0; i < num; i++) {
+        std::uint8_t rgba[4];
+        memcpy(rgba, data_ptr + i * stride, 4);
+        // color data is packed in BGR order.
+        data[3 * i + 0] = (double)rgba[2] / 255.0;
+        data[3 * i + 1] = (double)rgba[1] / 255.0;
+        data[3 * i + 2] = (double)rgba[0] / 255.0;
+    }
+}
+
+void UnpackBinaryPCDColorZero(const char *data_ptr,
+                              size_t stride,
+                              int num,
+                              double *data) {
+    for (int i = 0; i < num; i++) {
+        data[3 * i + 0] = 0.0;
+        data[3 * i + 1] = 0.0;
+        data[3 * i + 2] = 0.0;
+    }
+}
+
+PCDUnpackFunction GetBinaryPCDUnpackFunction(const char type, const int size) {
     if (type == 'I') {
         if (size == 1) {
-            std::int8_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
+            return UnpackBinaryPCDField<std::int8_t>;
         } else if (size == 2) {
-            std::int16_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
+            return UnpackBinaryPCDField<std::int16_t>;
         } else if (size == 4) {
-            std::int32_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else {
-            return 0.0;
+            return UnpackBinaryPCDField<std::int32_t>;
         }
     } else if (type == 'U') {
         if (size == 1) {
-            std::uint8_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
+            return UnpackBinaryPCDField<std::uint8_t>;
         } else if (size == 2) {
-            std::uint16_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
+            return UnpackBinaryPCDField<std::uint16_t>;
         } else if (size == 4) {
-            std::uint32_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else {
-            return 0.0;
+            return UnpackBinaryPCDField<std::uint32_t>;
         }
     } else if (type == 'F') {
         if (size == 4) {
-            std::float_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
+            return UnpackBinaryPCDField<float>;
+        }
+    }
+    return UnpackBinaryPCDZero;
+}
+
+/// A field of the binary payload that is unpacked into the point cloud. The
+/// field of point i is at offset + i * stride in the binary buffer.
+struct PCDUnpackTarget {
+    PCDUnpackFunction unpack;
+    size_t offset;
+    size_t stride;
+    double *data;
+};
+
+/// Resolves the fields of a binary payload to their unpack kernels and
+/// destinations once, instead of dispatching on the name and type per point.
+/// Binary data stores the fields of a point together, while the decompressed
+/// binary_compressed data stores all the values of a field together.
+std::vector<PCDUnpackTarget> GetBinaryPCDUnpackTargets(
+        const PCDHeader &header, geometry::PointCloud &pointcloud) {
+    std::vector<PCDUnpackTarget> targets;
+    for (const auto &field : header.fields) {
+        PCDUnpackTarget target;
+        target.unpack = GetBinaryPCDUnpackFunction(field.type, field.size);
+        if (header.datatype == PCD_DATA_BINARY_COMPRESSED) {
+            target.offset = (size_t)field.offset * header.points;
+            target.stride = (size_t)field.size * field.count;
         } else {
-            return 0.0;
+            target.offset = (size_t)field.offset;
+            target.stride = (size_t)header.pointsize;
         }
+        const bool is_normal = field.name == "normal_x" ||
+                               field.name == "normal_y" ||
+                               field.name == "normal_z";
+        const bool is_color = field.name == "rgb" || field.name == "rgba";
+        if ((is_normal && !header.has_normals) ||
+            (is_color && !header.has_colors)) {
+            continue;
+        }
+        if (field.name == "x") {
+            target.data = pointcloud.points_[0].data() + 0;
+        } else if (field.name == "y") {
+            target.data = pointcloud.points_[0].data() + 1;
+        } else if (field.name == "z") {
+            target.data = pointcloud.points_[0].data() + 2;
+        } else if (field.name == "normal_x") {
+            target.data = pointcloud.normals_[0].data() + 0;
+        } else if (field.name == "normal_y") {
+            target.data = pointcloud.normals_[0].data() + 1;
+        } else if (field.name == "normal_z") {
+            target.data = pointcloud.normals_[0].data() + 2;
+        } else if (is_color) {
+            target.unpack = field.size == 4 ? UnpackBinaryPCDColor
+                                            : UnpackBinaryPCDColorZero;
+            target.data = pointcloud.colors_[0].data();
+        } else {
+            continue;
+        }
+        targets.push_back(target);
     }
-    return 0.0;
+    return targets;
 }
 
-Eigen::Vector3d UnpackBinaryPCDColor(const char *data_ptr,
-                                     const char type,
-                                     const int size) {
-    if (size == 4) {
-        std::uint8_t data[4];
-        memcpy(data, data_ptr, 4);
-        // color data is packed in BGR order.
-        return Eigen::Vector3d((double)data[2] / 255.0, (double)data[1] / 255.0,
-                               (double)data[0] / 255.0);
-    } else {
-        return Eigen::Vector3d::Zero();
+/// Unpacks the points begin to begin + num - 1 in parallel. data_ptr holds
+/// the binary data starting at point begin.
+void UnpackBinaryPCDPoints(const char *data_ptr,
+                           int begin,
+                           int num,
+                           const std::vector<PCDUnpackTarget> &targets) {
+    const int num_blocks = (num + kPCDBlockSize - 1) / kPCDBlockSize;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int b = 0; b < num_blocks; b++) {
+        const int block_begin = b * kPCDBlockSize;
+        const int block_num = std::min(kPCDBlockSize, num - block_begin);
+        for (const auto &target : targets) {
+            target.unpack(
+                    data_ptr + target.offset + block_begin * target.stride,
+                    target.stride, block_num,
+                    target.data + 3 * ((size_t)begin + block_begin));
+        }
     }
 }
 
@@ -395,45 +500,22 @@ bool ReadPCDData(FILE *file,
             idx++;
         }
     } else if (header.datatype == PCD_DATA_BINARY) {
-        std::unique_ptr<char[]> buffer(new char[header.pointsize]);
-        for (int i = 0; i < header.points; i++) {
-            if (fread(buffer.get(), header.pointsize, 1, file) != 1) {
+        const auto targets = GetBinaryPCDUnpackTargets(header, pointcloud);
+        const int chunk_size = (int)std::max(
+                kPCDChunkSizeInBytes / header.pointsize, (size_t)1);
+        std::unique_ptr<char[]> buffer(
+                new char[(size_t)std::min(chunk_size, header.points) *
+                         header.pointsize]);
+        for (int begin = 0; begin < header.points; begin += chunk_size) {
+            const int num = std::min(chunk_size, header.points - begin);
+            if (fread(buffer.get(), header.pointsize, num, file) !=
+                (size_t)num) {
                 utility::LogWarning(
                         "[ReadPCDData] Failed to read data record.");
                 pointcloud.Clear();
                 return false;
             }
-            for (const auto &field : header.fields) {
-                if (field.name == "x") {
-                    pointcloud.points_[i](0) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "y") {
-                    pointcloud.points_[i](1) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "z") {
-                    pointcloud.points_[i](2) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_x") {
-                    pointcloud.normals_[i](0) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_y") {
-                    pointcloud.normals_[i](1) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_z") {
-                    pointcloud.normals_[i](2) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "rgb" || field.name == "rgba") {
-                    pointcloud.colors_[i] =
-                            UnpackBinaryPCDColor(buffer.get() + field.offset,
-                                                 field.type, field.size);
-                }
-            }
+            UnpackBinaryPCDPoints(buffer.get(), begin, num, targets);
         }
     } else if (header.datatype == PCD_DATA_BINARY_COMPRESSED) {
         std::uint32_t compressed_size;
@@ -453,6 +535,12 @@ bool ReadPCDData(FILE *file,
                 "PCD data with {:d} compressed size, and {:d} uncompressed "
                 "size.",
                 compressed_size, uncompressed_size);
+        if ((size_t)uncompressed_size <
+            (size_t)header.pointsize * header.points) {
+            utility::LogWarning("[ReadPCDData] Uncompressed data too small.");
+            pointcloud.Clear();
+            return false;
+        }
         std::unique_ptr<char[]> buffer_compressed(new char[compressed_size]);
         if (fread(buffer_compressed.get(), 1, compressed_size, file) !=
             compressed_size) {
@@ -469,52 +557,8 @@ bool ReadPCDData(FILE *file,
             pointcloud.Clear();
             return false;
         }
-        for (const auto &field : header.fields) {
-            const char *base_ptr = buffer.get() + field.offset * header.points;
-            if (field.name == "x") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](0) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "y") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](1) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "z") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](2) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_x") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](0) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_y") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](1) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_z") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](2) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "rgb" || field.name == "rgba") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.colors_[i] = UnpackBinaryPCDColor(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            }
-        }
+        const auto targets = GetBinaryPCDUnpackTargets(header, pointcloud);
+        UnpackBinaryPCDPoints(buffer.get(), 0, header.points, targets);
     }
     return true;
 }
@@ -625,6 +669,28 @@ float ConvertRGBToFloat(const Eigen::Vector3d &color) {
     return value;
 }
 
+/// Packs the fields of point i as floats to data, data + stride, ...
+void PackBinaryPCDPoint(const geometry::PointCloud &pointcloud,
+                        size_t i,
+                        float *data,
+                        size_t stride) {
+    const auto &point = pointcloud.points_[i];
+    data[0 * stride] = (float)point(0);
+    data[1 * stride] = (float)point(1);
+    data[2 * stride] = (float)point(2);
+    size_t idx = 3;
+    if (pointcloud.HasNormals()) {
+        const auto &normal = pointcloud.normals_[i];
+        data[(idx + 0) * stride] = (float)normal(0);
+        data[(idx + 1) * stride] = (float)normal(1);
+        data[(idx + 2) * stride] = (float)normal(2);
+        idx += 3;
+    }
+    if (pointcloud.HasColors()) {
+        data[idx * stride] = ConvertRGBToFloat(pointcloud.colors_[i]);
+    }
+}
+
 bool WritePCDData(FILE *file,
                   const PCDHeader &header,
                   const geometry::PointCloud &pointcloud) {
@@ -646,25 +712,29 @@ bool WritePCDData(FILE *file,
             fprintf(file, "\n");
         }
     } else if (header.datatype == PCD_DATA_BINARY) {
-        std::unique_ptr<float[]> data(new float[header.elementnum]);
-        for (size_t i = 0; i < pointcloud.points_.size(); i++) {
-            const auto &point = pointcloud.points_[i];
-            data[0] = (float)point(0);
-            data[1] = (float)point(1);
-            data[2] = (float)point(2);
-            int idx = 3;
-            if (has_normal) {
-                const auto &normal = pointcloud.normals_[i];
-                data[idx + 0] = (float)normal(0);
-                data[idx + 1] = (float)normal(1);
-                data[idx + 2] = (float)normal(2);
-                idx += 3;
+        // Points are packed in parallel into a chunk, which is written with a
+        // single fwrite.
+        const int chunk_size = (int)std::max(
+                kPCDChunkSizeInBytes / header.pointsize, (size_t)1);
+        std::unique_ptr<float[]> buffer(
+                new float[(size_t)std::min(chunk_size, header.points) *
+                          header.elementnum]);
+        for (int begin = 0; begin < header.points; begin += chunk_size) {
+            const int num = std::min(chunk_size, header.points - begin);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+            for (int i = 0; i < num; i++) {
+                PackBinaryPCDPoint(pointcloud, (size_t)begin + i,
+                                   buffer.get() + (size_t)i * header.elementnum,
+                                   1);
             }
-            if (has_color) {
-                const auto &color = pointcloud.colors_[i];
-                data[idx] = ConvertRGBToFloat(color);
+            if (fwrite(buffer.get(), header.pointsize, num, file) !=
+                (size_t)num) {
+                utility::LogWarning(
+                        "[WritePCDData] Failed to write data record.");
+                return false;
             }
-            fwrite(data.get(), sizeof(float), header.elementnum, file);
         }
     } else if (header.datatype == PCD_DATA_BINARY_COMPRESSED) {
         int strip_size = header.points;
@@ -672,23 +742,11 @@ bool WritePCDData(FILE *file,
                 (std::uint32_t)(header.elementnum * header.points);
         std::unique_ptr<float[]> buffer(new float[buffer_size]);
         std::unique_ptr<float[]> buffer_compressed(new float[buffer_size * 2]);
-        for (size_t i = 0; i < pointcloud.points_.size(); i++) {
-            const auto &point = pointcloud.points_[i];
-            buffer[0 * strip_size + i] = (float)point(0);
-            buffer[1 * strip_size + i] = (float)point(1);
-            buffer[2 * strip_size + i] = (float)point(2);
-            int idx = 3;
-            if (has_normal) {
-                const auto &normal = pointcloud.normals_[i];
-                buffer[(idx + 0) * strip_size + i] = (float)normal(0);
-                buffer[(idx + 1) * strip_size + i] = (float)normal(1);
-                buffer[(idx + 2) * strip_size + i] = (float)normal(2);
-                idx += 3;
-            }
-            if (has_color) {
-                const auto &color = pointcloud.colors_[i];
-                buffer[idx * strip_size + i] = ConvertRGBToFloat(color);
-            }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int i = 0; i < strip_size; i++) {
+            PackBinaryPCDPoint(pointcloud, i, buffer.get() + i, strip_size);
         }
         std::uint32_t buffer_size_in_bytes = buffer_size * sizeof(float);
         std::uint32_t size_compressed =
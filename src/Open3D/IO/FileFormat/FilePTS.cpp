@@ -25,7 +25,9 @@
 // ----------------------------------------------------------------------------
 
 #include <cstdio>
+
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/FileFormat/FileASCII.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
 #include "Open3D/Utility/Helper.h"
@@ -52,42 +54,56 @@ bool ReadPointCloudFromPTS(const std::string &filename,
         fclose(file);
         return false;
     }
+    pointcloud.Clear();
+    // The first point decides the fields of all points.
+    const long data_position = ftell(file);
+    if (!fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
+        fclose(file);
+        return true;
+    }
+    std::vector<std::string> st;
+    utility::SplitString(st, line_buffer, " ");
+    num_of_fields = (int)st.size();
+    if (num_of_fields < 3) {
+        utility::LogWarning("Read PTS failed: insufficient data fields.");
+        fclose(file);
+        return false;
+    }
+    if (fseek(file, data_position, SEEK_SET) != 0) {
+        utility::LogWarning("Read PTS failed: unable to read file.");
+        fclose(file);
+        return false;
+    }
+    pointcloud.points_.resize(num_of_pts);
+    if (num_of_fields >= 7) {
+        // X Y Z I R G B
+        pointcloud.colors_.resize(num_of_pts);
+    }
     utility::ConsoleProgressBar progress_bar(num_of_pts,
                                              "Reading PTS: ", print_progress);
+    // Points that fail to parse are kept as zeros, so that the points
+    // after them stay at their index.
     size_t idx = 0;
-    while (idx < num_of_pts &&
-           fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
-        if (num_of_fields == 0) {
-            std::vector<std::string> st;
-            utility::SplitString(st, line_buffer, " ");
-            num_of_fields = (int)st.size();
-            if (num_of_fields < 3) {
-                utility::LogWarning(
-                        "Read PTS failed: insufficient data fields.");
-                fclose(file);
-                return false;
-            }
-            pointcloud.points_.resize(num_of_pts);
+    auto append_rows = [&pointcloud, &idx, num_of_fields](const double *values,
+                                                          size_t num_rows) {
+        for (size_t i = 0; i < num_rows; i++, idx++) {
+            pointcloud.points_[idx] =
+                    Eigen::Vector3d(values[0], values[1], values[2]);
             if (num_of_fields >= 7) {
-                // X Y Z I R G B
-                pointcloud.colors_.resize(num_of_pts);
-            }
-        }
-        double x, y, z;
-        int i, r, g, b;
-        if (num_of_fields < 7) {
-            if (sscanf(line_buffer, "%lf %lf %lf", &x, &y, &z) == 3) {
-                pointcloud.points_[idx] = Eigen::Vector3d(x, y, z);
-            }
-        } else {
-            if (sscanf(line_buffer, "%lf %lf %lf %d %d %d %d", &x, &y, &z, &i,
-                       &r, &g, &b) == 7) {
-                pointcloud.points_[idx] = Eigen::Vector3d(x, y, z);
-                pointcloud.colors_[idx] = Eigen::Vector3d(r, g, b) / 255.0;
+                pointcloud.colors_[idx] =
+                        Eigen::Vector3d(values[4], values[5], values[6]) /
+                        255.0;
+                values += 7;
+            } else {
+                values += 3;
             }
         }
-        idx++;
-        ++progress_bar;
+    };
+    if (!ReadASCIIRows(file, num_of_fields >= 7 ? 7 : 3, append_rows, false,
+                       num_of_pts, &progress_bar)) {
+        utility::LogWarning("Read PTS failed: unable to read file.");
+        fclose(file);
+        return false;
     }
     fclose(file);
     return true;
@@ -107,18 +123,31 @@ bool WritePointCloudToPTS(const std::string &filename,
     utility::ConsoleProgressBar progress_bar(
             static_cast<size_t>(pointcloud.points_.size()),
             "Writing PTS: ", print_progress);
-    for (size_t i = 0; i < pointcloud.points_.size(); i++) {
+    const bool has_colors = pointcloud.HasColors();
+    auto format_row = [&pointcloud, has_colors](size_t i,
+                                                std::string &buffer) {
         const auto &point = pointcloud.points_[i];
-        if (pointcloud.HasColors() == false) {
-            fprintf(file, "%.10f %.10f %.10f\r\n", point(0), point(1),
-                    point(2));
-        } else {
-            const auto &color = pointcloud.colors_[i] * 255.0;
-            fprintf(file, "%.10f %.10f %.10f %d %d %d %d\r\n", point(0),
-                    point(1), point(2), 0, (int)color(0), (int)color(1),
-                    (int)(color(2)));
+        AppendASCIIDouble(buffer, point(0));
+        buffer += ' ';
+        AppendASCIIDouble(buffer, point(1));
+        buffer += ' ';
+        AppendASCIIDouble(buffer, point(2));
+        if (has_colors) {
+            const Eigen::Vector3d color = pointcloud.colors_[i] * 255.0;
+            buffer += " 0 ";
+            AppendASCIIInt(buffer, (int)color(0));
+            buffer += ' ';
+            AppendASCIIInt(buffer, (int)color(1));
+            buffer += ' ';
+            AppendASCIIInt(buffer, (int)color(2));
         }
-        ++progress_bar;
+        buffer += "\r\n";
+    };
+    if (!WriteASCIIRows(file, pointcloud.points_.size(), format_row,
+                        &progress_bar)) {
+        utility::LogWarning("Write PTS failed: unable to write file.");
+        fclose(file);
+        return false;
     }
     fclose(file);
     return true;
@@ -27,6 +27,7 @@
 #include <cstdio>
 
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/FileFormat/FileASCII.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
 
@@ -43,14 +44,18 @@ bool ReadPointCloudFromXYZ(const std::string &filename,
         return false;
     }
 
-    char line_buffer[DEFAULT_IO_BUFFER_SIZE];
-    double x, y, z;
     pointcloud.Clear();
-
-    while (fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
-        if (sscanf(line_buffer, "%lf %lf %lf", &x, &y, &z) == 3) {
-            pointcloud.points_.push_back(Eigen::Vector3d(x, y, z));
+    auto append_rows = [&pointcloud](const double *values, size_t num_rows) {
+        for (size_t i = 0; i < num_rows; i++, values += 3) {
+            pointcloud.points_.push_back(
+                    Eigen::Vector3d(values[0], values[1], values[2]));
         }
+    };
+    if (!ReadASCIIRows(file, 3, append_rows)) {
+        utility::LogWarning("Read XYZ failed: unable to read file: {}",
+                            filename);
+        fclose(file);
+        return false;
     }
 
     fclose(file);
@@ -69,15 +74,20 @@ bool WritePointCloudToXYZ(const std::string &filename,
         return false;
     }
 
-    for (size_t i = 0; i < pointcloud.points_.size(); i++) {
+    auto format_row = [&pointcloud](size_t i, std::string &buffer) {
         const Eigen::Vector3d &point = pointcloud.points_[i];
-        if (fprintf(file, "%.10f %.10f %.10f\n", point(0), point(1), point(2)) <
-            0) {
-            utility::LogWarning("Write XYZ failed: unable to write file: {}",
-                                filename);
-            fclose(file);
-            return false;  // error happens during writing.
-        }
+        AppendASCIIDouble(buffer, point(0));
+        buffer += ' ';
+        AppendASCIIDouble(buffer, point(1));
+        buffer += ' ';
+        AppendASCIIDouble(buffer, point(2));
+        buffer += '\n';
+    };
+    if (!WriteASCIIRows(file, pointcloud.points_.size(), format_row)) {
+        utility::LogWarning("Write XYZ failed: unable to write file: {}",
+                            filename);
+        fclose(file);
+        return false;  // error happens during writing.
     }
 
     fclose(file);
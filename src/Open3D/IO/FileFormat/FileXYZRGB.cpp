@@ -27,6 +27,7 @@
 #include <cstdio>
 
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/FileFormat/FileASCII.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
 
@@ -43,16 +44,20 @@ bool ReadPointCloudFromXYZRGB(const std::string &filename,
         return false;
     }
 
-    char line_buffer[DEFAULT_IO_BUFFER_SIZE];
-    double x, y, z, r, g, b;
     pointcloud.Clear();
-
-    while (fgets(line_buffer, DEFAULT_IO_BUFFER_SIZE, file)) {
-        if (sscanf(line_buffer, "%lf %lf %lf %lf %lf %lf", &x, &y, &z, &r, &g,
-                   &b) == 6) {
-            pointcloud.points_.push_back(Eigen::Vector3d(x, y, z));
-            pointcloud.colors_.push_back(Eigen::Vector3d(r, g, b));
+    auto append_rows = [&pointcloud](const double *values, size_t num_rows) {
+        for (size_t i = 0; i < num_rows; i++, values += 6) {
+            pointcloud.points_.push_back(
+                    Eigen::Vector3d(values[0], values[1], values[2]));
+            pointcloud.colors_.push_back(
+                    Eigen::Vector3d(values[3], values[4], values[5]));
         }
+    };
+    if (!ReadASCIIRows(file, 6, append_rows)) {
+        utility::LogWarning("Read XYZRGB failed: unable to read file: {}",
+                            filename);
+        fclose(file);
+        return false;
     }
 
     fclose(file);
@@ -75,16 +80,27 @@ bool WritePointCloudToXYZRGB(const std::string &filename,
         return false;
     }
 
-    for (size_t i = 0; i < pointcloud.points_.size(); i++) {
+    auto format_row = [&pointcloud](size_t i, std::string &buffer) {
         const Eigen::Vector3d &point = pointcloud.points_[i];
         const Eigen::Vector3d &color = pointcloud.colors_[i];
-        if (fprintf(file, "%.10f %.10f %.10f %.10f %.10f %.10f\n", point(0),
-                    point(1), point(2), color(0), color(1), color(2)) < 0) {
-            utility::LogWarning("Write XYZRGB failed: unable to write file: {}",
-                                filename);
-            fclose(file);
-            return false;  // error happens during writing.
-        }
+        AppendASCIIDouble(buffer, point(0));
+        buffer += ' ';
+        AppendASCIIDouble(buffer, point(1));
+        buffer += ' ';
+        AppendASCIIDouble(buffer, point(2));
+        buffer += ' ';
+        AppendASCIIDouble(buffer, color(0));
+        buffer += ' ';
+        AppendASCIIDouble(buffer, color(1));
+        buffer += ' ';
+        AppendASCIIDouble(buffer, color(2));
+        buffer += '\n';
+    };
+    if (!WriteASCIIRows(file, pointcloud.points_.size(), format_row)) {
+        utility::LogWarning("Write XYZRGB failed: unable to write file: {}",
+                            filename);
+        fclose(file);
+        return false;  // error happens during writing.
     }
 
     fclose(file);
@@ -0,0 +1,104 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/MarchingCubesBlock.h"
+
+namespace open3d {
+namespace integration {
+
+void ComputeMarchingCubesVertexOffsets(
+        std::vector<MarchingCubesBlock> &blocks) {
+    int offset = 0;
+    for (auto &block : blocks) {
+        block.vertex_offset_ = offset;
+        offset += int(block.vertices_.size());
+    }
+}
+
+std::shared_ptr<geometry::TriangleMesh> MergeMarchingCubesBlocks(
+        const std::vector<MarchingCubesBlock> &blocks) {
+    auto mesh = std::make_shared<geometry::TriangleMesh>();
+    const int n_blocks = int(blocks.size());
+    if (n_blocks == 0) {
+        return mesh;
+    }
+    const int n_vertices = blocks.back().vertex_offset_ +
+                           int(blocks.back().vertices_.size());
+    bool has_colors = false;
+    std::vector<int> triangle_offsets(n_blocks + 1, 0);
+    for (int b = 0; b < n_blocks; b++) {
+        has_colors |= !blocks[b].vertex_colors_.empty();
+        triangle_offsets[b + 1] =
+                triangle_offsets[b] + int(blocks[b].triangles_.size());
+    }
+
+    // Compact the used vertices with a prefix sum over the usage flags.
+    std::vector<int> new_index(n_vertices, 0);
+    for (const auto &block : blocks) {
+        for (const auto &triangle : block.triangles_) {
+            new_index[triangle(0)] = 1;
+            new_index[triangle(1)] = 1;
+            new_index[triangle(2)] = 1;
+        }
+    }
+    int n_used = 0;
+    for (int v = 0; v < n_vertices; v++) {
+        new_index[v] = new_index[v] ? n_used++ : -1;
+    }
+
+    mesh->vertices_.resize(n_used);
+    if (has_colors) {
+        mesh->vertex_colors_.resize(n_used);
+    }
+    mesh->triangles_.resize(triangle_offsets[n_blocks]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int b = 0; b < n_blocks; b++) {
+        const auto &block = blocks[b];
+        for (size_t v = 0; v < block.vertices_.size(); v++) {
+            int idx = new_index[block.vertex_offset_ + v];
+            if (idx < 0) {
+                continue;
+            }
+            mesh->vertices_[idx] = block.vertices_[v];
+            if (has_colors) {
+                mesh->vertex_colors_[idx] = block.vertex_colors_[v];
+            }
+        }
+        for (size_t t = 0; t < block.triangles_.size(); t++) {
+            const auto &triangle = block.triangles_[t];
+            mesh->triangles_[triangle_offsets[b] + t] =
+                    Eigen::Vector3i(new_index[triangle(0)],
+                                    new_index[triangle(1)],
+                                    new_index[triangle(2)]);
+        }
+    }
+    return mesh;
+}
+
+}  // namespace integration
+}  // namespace open3d
@@ -0,0 +1,79 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "Open3D/Geometry/TriangleMesh.h"
+
+namespace open3d {
+namespace integration {
+
+/// Output of the marching cubes algorithm on one block of a TSDF volume.
+/// A block owns the vertices on the edges that start at one of its voxels,
+/// so every vertex is created exactly once and blocks can be processed in
+/// parallel. The edges are identified by voxel_index * 3 + direction.
+class MarchingCubesBlock {
+public:
+    /// Returns the index of the vertex on the given edge in the concatenated
+    /// vertices of all blocks, or -1 if the edge carries no vertex.
+    int GetVertexIndex(int edge_id) const {
+        auto it = std::lower_bound(edge_ids_.begin(), edge_ids_.end(),
+                                   edge_id);
+        if (it == edge_ids_.end() || *it != edge_id) {
+            return -1;
+        }
+        return vertex_offset_ + int(it - edge_ids_.begin());
+    }
+
+public:
+    /// Sorted ids of the edges with a vertex
+    std::vector<int> edge_ids_;
+    std::vector<Eigen::Vector3d> vertices_;
+    std::vector<Eigen::Vector3d> vertex_colors_;
+    /// Triangles of the cubes of the block, indexing the concatenated
+    /// vertices of all blocks
+    std::vector<Eigen::Vector3i> triangles_;
+    /// Number of vertices in the preceding blocks
+    int vertex_offset_ = 0;
+};
+
+/// Sets the vertex_offset_ of all blocks with an exclusive prefix sum over the
+/// number of vertices per block.
+void ComputeMarchingCubesVertexOffsets(std::vector<MarchingCubesBlock> &blocks);
+
+/// Concatenates the blocks into one mesh. Vertices that are not used by any
+/// triangle (edges with a sign change but without a valid adjacent cube) are
+/// dropped.
+std::shared_ptr<geometry::TriangleMesh> MergeMarchingCubesBlocks(
+        const std::vector<MarchingCubesBlock> &blocks);
+
+}  // namespace integration
+}  // namespace open3d
@@ -26,9 +26,13 @@
 
 #include "Open3D/Integration/ScalableTSDFVolume.h"
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <unordered_set>
 
 #include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Integration/MarchingCubesBlock.h"
 #include "Open3D/Integration/MarchingCubesConst.h"
 #include "Open3D/Integration/UniformTSDFVolume.h"
 #include "Open3D/Utility/Console.h"
@@ -40,11 +44,14 @@ ScalableTSDFVolume::ScalableTSDFVolume(double voxel_length,
                                        double sdf_trunc,
                                        TSDFVolumeColorType color_type,
                                        int volume_unit_resolution /* = 16*/,
-                                       int depth_sampling_stride /* = 4*/)
+                                       int depth_sampling_stride /* = 4*/,
+                                       bool skip_occluded_volume_units
+                                       /* = false*/)
     : TSDFVolume(voxel_length, sdf_trunc, color_type),
       volume_unit_resolution_(volume_unit_resolution),
       volume_unit_length_(voxel_length * volume_unit_resolution),
-      depth_sampling_stride_(depth_sampling_stride) {}
+      depth_sampling_stride_(depth_sampling_stride),
+      skip_occluded_volume_units_(skip_occluded_volume_units) {}
 
 ScalableTSDFVolume::~ScalableTSDFVolume() {}
 
@@ -79,37 +86,87 @@ void ScalableTSDFVolume::Integrate(
     auto pointcloud = geometry::PointCloud::CreateFromDepthImage(
             image.depth_, intrinsic, extrinsic, 1000.0, 1000.0,
             depth_sampling_stride_);
+
+    // Collect the volume units within sdf_trunc_ of the depth samples. Each
+    // thread dedups into its own set, the sets are merged once.
     std::unordered_set<Eigen::Vector3i,
                        utility::hash_eigen::hash<Eigen::Vector3i>>
-            touched_volume_units_;
-    for (const auto &point : pointcloud->points_) {
-        auto min_bound = LocateVolumeUnit(
-                point - Eigen::Vector3d(sdf_trunc_, sdf_trunc_, sdf_trunc_));
-        auto max_bound = LocateVolumeUnit(
-                point + Eigen::Vector3d(sdf_trunc_, sdf_trunc_, sdf_trunc_));
-        for (auto x = min_bound(0); x <= max_bound(0); x++) {
-            for (auto y = min_bound(1); y <= max_bound(1); y++) {
-                for (auto z = min_bound(2); z <= max_bound(2); z++) {
-                    auto loc = Eigen::Vector3i(x, y, z);
-                    if (touched_volume_units_.find(loc) ==
-                        touched_volume_units_.end()) {
-                        touched_volume_units_.insert(loc);
-                        auto volume = OpenVolumeUnit(Eigen::Vector3i(x, y, z));
-                        volume->IntegrateWithDepthToCameraDistanceMultiplier(
-                                image, intrinsic, extrinsic,
-                                *depth2cameradistance);
+            touched_volume_units;
+    const Eigen::Vector3d sdf_trunc_vec(sdf_trunc_, sdf_trunc_, sdf_trunc_);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::unordered_set<Eigen::Vector3i,
+                           utility::hash_eigen::hash<Eigen::Vector3i>>
+                touched_volume_units_local;
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for (int i = 0; i < (int)pointcloud->points_.size(); i++) {
+            const Eigen::Vector3d &point = pointcloud->points_[i];
+            auto min_bound = LocateVolumeUnit(point - sdf_trunc_vec);
+            auto max_bound = LocateVolumeUnit(point + sdf_trunc_vec);
+            for (auto x = min_bound(0); x <= max_bound(0); x++) {
+                for (auto y = min_bound(1); y <= max_bound(1); y++) {
+                    for (auto z = min_bound(2); z <= max_bound(2); z++) {
+                        touched_volume_units_local.insert(
+                                Eigen::Vector3i(x, y, z));
                     }
                 }
             }
         }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        touched_volume_units.insert(touched_volume_units_local.begin(),
+                                    touched_volume_units_local.end());
+    }
+
+    // Cull the units that cannot receive any update, then allocate the
+    // others serially in a fixed order so that the layout of volume_units_
+    // does not depend on the thread scheduling.
+    std::vector<Eigen::Vector3i> indices(touched_volume_units.begin(),
+                                         touched_volume_units.end());
+    std::sort(indices.begin(), indices.end(),
+              [](const Eigen::Vector3i &a, const Eigen::Vector3i &b) {
+                  return std::lexicographical_compare(a.data(), a.data() + 3,
+                                                      b.data(), b.data() + 3);
+              });
+    std::vector<int> is_observed(indices.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < (int)indices.size(); i++) {
+        is_observed[i] = IsVolumeUnitObserved(indices[i], image.depth_,
+                                              intrinsic, extrinsic);
+    }
+    std::vector<std::shared_ptr<UniformTSDFVolume>> volumes;
+    volumes.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        if (is_observed[i]) {
+            volumes.push_back(OpenVolumeUnit(indices[i]));
+        }
+    }
+
+    // The units are independent, integrate them in parallel. The per-voxel
+    // loop inside each unit runs serially as nested parallelism is off by
+    // default.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < (int)volumes.size(); i++) {
+        volumes[i]->IntegrateWithDepthToCameraDistanceMultiplier(
+                image, intrinsic, extrinsic, *depth2cameradistance);
     }
 }
 
 std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
     auto pointcloud = std::make_shared<geometry::PointCloud>();
     double half_voxel_length = voxel_length_ * 0.5;
-    float w0, w1, f0, f1;
-    Eigen::Vector3f c0, c1;
+    float f0, f1;
+    uint16_t w0, w1;
+    Eigen::Vector3d c0, c1;
     for (const auto &unit : volume_units_) {
         if (unit.second.volume_) {
             const auto &volume0 = *unit.second.volume_;
@@ -118,12 +175,12 @@ std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
                 for (int y = 0; y < volume0.resolution_; y++) {
                     for (int z = 0; z < volume0.resolution_; z++) {
                         Eigen::Vector3i idx0(x, y, z);
-                        w0 = volume0.voxels_[volume0.IndexOf(idx0)].weight_;
-                        f0 = volume0.voxels_[volume0.IndexOf(idx0)].tsdf_;
+                        int ind0 = volume0.IndexOf(idx0);
+                        w0 = volume0.weight_[ind0];
+                        f0 = volume0.tsdf_[ind0];
                         if (color_type_ != TSDFVolumeColorType::NoColor)
-                            c0 = volume0.voxels_[volume0.IndexOf(idx0)]
-                                         .color_.cast<float>();
-                        if (w0 != 0.0f && f0 < 0.98f && f0 >= -0.98f) {
+                            c0 = volume0.GetColor(ind0);
+                        if (w0 != 0 && f0 < 0.98f && f0 >= -0.98f) {
                             Eigen::Vector3d p0 =
                                     Eigen::Vector3d(half_voxel_length +
                                                             voxel_length_ * x,
@@ -139,40 +196,31 @@ std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
                                 p1(i) += voxel_length_;
                                 idx1(i) += 1;
                                 if (idx1(i) < volume0.resolution_) {
-                                    w1 = volume0.voxels_[volume0.IndexOf(idx1)]
-                                                 .weight_;
-                                    f1 = volume0.voxels_[volume0.IndexOf(idx1)]
-                                                 .tsdf_;
+                                    int ind1 = volume0.IndexOf(idx1);
+                                    w1 = volume0.weight_[ind1];
+                                    f1 = volume0.tsdf_[ind1];
                                     if (color_type_ !=
                                         TSDFVolumeColorType::NoColor)
-                                        c1 = volume0.voxels_[volume0.IndexOf(
-                                                                     idx1)]
-                                                     .color_.cast<float>();
+                                        c1 = volume0.GetColor(ind1);
                                 } else {
                                     idx1(i) -= volume0.resolution_;
                                     index1(i) += 1;
                                     auto unit_itr = volume_units_.find(index1);
                                     if (unit_itr == volume_units_.end()) {
-                                        w1 = 0.0f;
+                                        w1 = 0;
                                         f1 = 0.0f;
                                     } else {
                                         const auto &volume1 =
                                                 *unit_itr->second.volume_;
-                                        w1 = volume1.voxels_[volume1.IndexOf(
-                                                                     idx1)]
-                                                     .weight_;
-                                        f1 = volume1.voxels_[volume1.IndexOf(
-                                                                     idx1)]
-                                                     .tsdf_;
+                                        int ind1 = volume1.IndexOf(idx1);
+                                        w1 = volume1.weight_[ind1];
+                                        f1 = volume1.tsdf_[ind1];
                                         if (color_type_ !=
                                             TSDFVolumeColorType::NoColor)
-                                            c1 = volume1.voxels_
-                                                         [volume1.IndexOf(idx1)]
-                                                                 .color_
-                                                                 .cast<float>();
+                                            c1 = volume1.GetColor(ind1);
                                     }
                                 }
-                                if (w1 != 0.0f && f1 < 0.98f && f1 >= -0.98f &&
+                                if (w1 != 0 && f1 < 0.98f && f1 >= -0.98f &&
                                     f0 * f1 < 0) {
                                     float r0 = std::fabs(f0);
                                     float r1 = std::fabs(f1);
@@ -180,18 +228,11 @@ std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
                                     p(i) = (p0(i) * r1 + p1(i) * r0) /
                                            (r0 + r1);
                                     pointcloud->points_.push_back(p);
-                                    if (color_type_ ==
-                                        TSDFVolumeColorType::RGB8) {
-                                        pointcloud->colors_.push_back(
-                                                ((c0 * r1 + c1 * r0) /
-                                                 (r0 + r1) / 255.0f)
-                                                        .cast<double>());
-                                    } else if (color_type_ ==
-                                               TSDFVolumeColorType::Gray32) {
+                                    if (color_type_ !=
+                                        TSDFVolumeColorType::NoColor) {
                                         pointcloud->colors_.push_back(
-                                                ((c0 * r1 + c1 * r0) /
-                                                 (r0 + r1))
-                                                        .cast<double>());
+                                                (c0 * r1 + c1 * r0) /
+                                                (r0 + r1));
                                     }
                                     // has_normal
                                     pointcloud->normals_.push_back(
@@ -211,150 +252,331 @@ std::shared_ptr<geometry::TriangleMesh>
 ScalableTSDFVolume::ExtractTriangleMesh() {
     // implementation of marching cubes, based on
     // http://paulbourke.net/geometry/polygonise/
-    auto mesh = std::make_shared<geometry::TriangleMesh>();
-    double half_voxel_length = voxel_length_ * 0.5;
-    std::unordered_map<
-            Eigen::Vector4i, int, utility::hash_eigen::hash<Eigen::Vector4i>,
-            std::equal_to<Eigen::Vector4i>,
-            Eigen::aligned_allocator<std::pair<const Eigen::Vector4i, int>>>
-            edgeindex_to_vertexindex;
-    int edge_to_index[12];
+    // The volume units are processed in parallel. Each unit owns the vertices
+    // on the edges starting at its voxels, which are created in a first pass.
+    // The triangles of the cubes are created in a second pass and look up the
+    // vertices of their unit and of the neighboring units in +x, +y and +z.
+    const double half_voxel_length = voxel_length_ * 0.5;
+    const bool has_color = color_type_ != TSDFVolumeColorType::NoColor;
+    const int resolution = volume_unit_resolution_;
+    std::vector<const UniformTSDFVolume *> volumes;
+    std::vector<Eigen::Vector3i> volume_indices;
+    std::unordered_map<Eigen::Vector3i, int,
+                       utility::hash_eigen::hash<Eigen::Vector3i>>
+            index_to_volume;
     for (const auto &unit : volume_units_) {
         if (unit.second.volume_) {
-            const auto &volume0 = *unit.second.volume_;
-            const auto &index0 = unit.second.index_;
-            for (int x = 0; x < volume0.resolution_; x++) {
-                for (int y = 0; y < volume0.resolution_; y++) {
-                    for (int z = 0; z < volume0.resolution_; z++) {
-                        Eigen::Vector3i idx0(x, y, z);
-                        int cube_index = 0;
-                        float w[8];
-                        float f[8];
-                        Eigen::Vector3d c[8];
-                        for (int i = 0; i < 8; i++) {
-                            Eigen::Vector3i index1 = index0;
-                            Eigen::Vector3i idx1 = idx0 + shift[i];
-                            if (idx1(0) < volume_unit_resolution_ &&
-                                idx1(1) < volume_unit_resolution_ &&
-                                idx1(2) < volume_unit_resolution_) {
-                                w[i] = volume0.voxels_[volume0.IndexOf(idx1)]
-                                               .weight_;
-                                f[i] = volume0.voxels_[volume0.IndexOf(idx1)]
-                                               .tsdf_;
-                                if (color_type_ == TSDFVolumeColorType::RGB8)
-                                    c[i] = volume0.voxels_[volume0.IndexOf(
-                                                                   idx1)]
-                                                   .color_.cast<double>() /
-                                           255.0;
-                                else if (color_type_ ==
-                                         TSDFVolumeColorType::Gray32)
-                                    c[i] = volume0.voxels_[volume0.IndexOf(
-                                                                   idx1)]
-                                                   .color_.cast<double>();
-                            } else {
-                                for (int j = 0; j < 3; j++) {
-                                    if (idx1(j) >= volume_unit_resolution_) {
-                                        idx1(j) -= volume_unit_resolution_;
-                                        index1(j) += 1;
-                                    }
-                                }
-                                auto unit_itr1 = volume_units_.find(index1);
-                                if (unit_itr1 == volume_units_.end()) {
-                                    w[i] = 0.0f;
-                                    f[i] = 0.0f;
-                                } else {
-                                    const auto &volume1 =
-                                            *unit_itr1->second.volume_;
-                                    w[i] = volume1.voxels_[volume1.IndexOf(
-                                                                   idx1)]
-                                                   .weight_;
-                                    f[i] = volume1.voxels_[volume1.IndexOf(
-                                                                   idx1)]
-                                                   .tsdf_;
-                                    if (color_type_ ==
-                                        TSDFVolumeColorType::RGB8)
-                                        c[i] = volume1.voxels_[volume1.IndexOf(
-                                                                       idx1)]
-                                                       .color_.cast<double>() /
-                                               255.0;
-                                    else if (color_type_ ==
-                                             TSDFVolumeColorType::Gray32)
-                                        c[i] = volume1.voxels_[volume1.IndexOf(
-                                                                       idx1)]
-                                                       .color_.cast<double>();
-                                }
-                            }
-                            if (w[i] == 0.0f) {
-                                cube_index = 0;
-                                break;
-                            } else {
-                                if (f[i] < 0.0f) {
-                                    cube_index |= (1 << i);
-                                }
-                            }
+            index_to_volume[unit.second.index_] = int(volumes.size());
+            volumes.push_back(unit.second.volume_.get());
+            volume_indices.push_back(unit.second.index_);
+        }
+    }
+    const int n_volumes = int(volumes.size());
+
+    // neighbors[v][k] is the unit at offset (k & 1, (k >> 1) & 1, k >> 2)
+    // from unit v, or -1 if it does not exist.
+    std::vector<std::array<int, 8>> neighbors(n_volumes);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < n_volumes; v++) {
+        for (int k = 0; k < 8; k++) {
+            auto it = index_to_volume.find(
+                    volume_indices[v] +
+                    Eigen::Vector3i(k & 1, (k >> 1) & 1, (k >> 2) & 1));
+            neighbors[v][k] = it == index_to_volume.end() ? -1 : it->second;
+        }
+    }
+    // Maps a voxel index relative to unit v, which may exceed the unit by one
+    // voxel in +x, +y and +z, to its unit and the index in that unit.
+    auto locate_voxel = [&](int v, Eigen::Vector3i &idx) {
+        int k = 0;
+        for (int j = 0; j < 3; j++) {
+            if (idx(j) >= resolution) {
+                idx(j) -= resolution;
+                k |= 1 << j;
+            }
+        }
+        return neighbors[v][k];
+    };
+
+    std::vector<MarchingCubesBlock> blocks(n_volumes);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int v = 0; v < n_volumes; v++) {
+        const auto &volume0 = *volumes[v];
+        auto &block = blocks[v];
+        for (int x = 0; x < resolution; x++) {
+            for (int y = 0; y < resolution; y++) {
+                for (int z = 0; z < resolution; z++) {
+                    Eigen::Vector3i idx0(x, y, z);
+                    int ind0 = volume0.IndexOf(idx0);
+                    if (volume0.weight_[ind0] == 0) {
+                        continue;
+                    }
+                    float f0 = volume0.tsdf_[ind0];
+                    for (int i = 0; i < 3; i++) {
+                        Eigen::Vector3i idx1 = idx0;
+                        idx1(i) += 1;
+                        int v1 = locate_voxel(v, idx1);
+                        if (v1 < 0) {
+                            continue;
                         }
-                        if (cube_index == 0 || cube_index == 255) {
+                        const auto &volume1 = *volumes[v1];
+                        int ind1 = volume1.IndexOf(idx1);
+                        float f1 = volume1.tsdf_[ind1];
+                        if (volume1.weight_[ind1] == 0 ||
+                            (f0 < 0.0f) == (f1 < 0.0f)) {
                             continue;
                         }
-                        for (int i = 0; i < 12; i++) {
-                            if (edge_table[cube_index] & (1 << i)) {
-                                Eigen::Vector4i edge_index =
-                                        Eigen::Vector4i(index0(0), index0(1),
-                                                        index0(2), 0) *
-                                                volume_unit_resolution_ +
-                                        Eigen::Vector4i(x, y, z, 0) +
-                                        edge_shift[i];
-                                if (edgeindex_to_vertexindex.find(edge_index) ==
-                                    edgeindex_to_vertexindex.end()) {
-                                    edge_to_index[i] =
-                                            (int)mesh->vertices_.size();
-                                    edgeindex_to_vertexindex[edge_index] =
-                                            (int)mesh->vertices_.size();
-                                    Eigen::Vector3d pt(
-                                            half_voxel_length +
-                                                    voxel_length_ *
-                                                            edge_index(0),
-                                            half_voxel_length +
-                                                    voxel_length_ *
-                                                            edge_index(1),
-                                            half_voxel_length +
-                                                    voxel_length_ *
-                                                            edge_index(2));
-                                    double f0 = std::abs(
-                                            (double)f[edge_to_vert[i][0]]);
-                                    double f1 = std::abs(
-                                            (double)f[edge_to_vert[i][1]]);
-                                    pt(edge_index(3)) +=
-                                            f0 * voxel_length_ / (f0 + f1);
-                                    mesh->vertices_.push_back(pt);
-                                    if (color_type_ !=
-                                        TSDFVolumeColorType::NoColor) {
-                                        const auto &c0 = c[edge_to_vert[i][0]];
-                                        const auto &c1 = c[edge_to_vert[i][1]];
-                                        mesh->vertex_colors_.push_back(
-                                                (f1 * c0 + f0 * c1) /
-                                                (f0 + f1));
-                                    }
-                                } else {
-                                    edge_to_index[i] = edgeindex_to_vertexindex
-                                            [edge_index];
-                                }
-                            }
+                        Eigen::Vector3d pt =
+                                Eigen::Vector3d::Constant(half_voxel_length) +
+                                voxel_length_ *
+                                        (volume_indices[v] * resolution +
+                                         idx0)
+                                                .cast<double>();
+                        double r0 = std::abs((double)f0);
+                        double r1 = std::abs((double)f1);
+                        pt(i) += r0 * voxel_length_ / (r0 + r1);
+                        block.edge_ids_.push_back(ind0 * 3 + i);
+                        block.vertices_.push_back(pt);
+                        if (has_color) {
+                            block.vertex_colors_.push_back(
+                                    (r1 * volume0.GetColor(ind0) +
+                                     r0 * volume1.GetColor(ind1)) /
+                                    (r0 + r1));
+                        }
+                    }
+                }
+            }
+        }
+    }
+    ComputeMarchingCubesVertexOffsets(blocks);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int v = 0; v < n_volumes; v++) {
+        auto &block = blocks[v];
+        int edge_to_index[12];
+        for (int x = 0; x < resolution; x++) {
+            for (int y = 0; y < resolution; y++) {
+                for (int z = 0; z < resolution; z++) {
+                    int cube_index = 0;
+                    for (int i = 0; i < 8; i++) {
+                        Eigen::Vector3i idx1 = Eigen::Vector3i(x, y, z) +
+                                               shift[i];
+                        int v1 = locate_voxel(v, idx1);
+                        int ind1 = v1 < 0 ? 0 : volumes[v1]->IndexOf(idx1);
+                        if (v1 < 0 || volumes[v1]->weight_[ind1] == 0) {
+                            cube_index = 0;
+                            break;
+                        } else if (volumes[v1]->tsdf_[ind1] < 0.0f) {
+                            cube_index |= (1 << i);
+                        }
+                    }
+                    if (cube_index == 0 || cube_index == 255) {
+                        continue;
+                    }
+                    for (int i = 0; i < 12; i++) {
+                        if (edge_table[cube_index] & (1 << i)) {
+                            Eigen::Vector4i edge_shift_i = edge_shift[i];
+                            Eigen::Vector3i idx1 =
+                                    Eigen::Vector3i(x, y, z) +
+                                    edge_shift_i.head<3>();
+                            int v1 = locate_voxel(v, idx1);
+                            edge_to_index[i] = blocks[v1].GetVertexIndex(
+                                    volumes[v1]->IndexOf(idx1) * 3 +
+                                    edge_shift_i(3));
                         }
-                        for (int i = 0; tri_table[cube_index][i] != -1;
-                             i += 3) {
-                            mesh->triangles_.push_back(Eigen::Vector3i(
-                                    edge_to_index[tri_table[cube_index][i]],
-                                    edge_to_index[tri_table[cube_index][i + 2]],
-                                    edge_to_index[tri_table[cube_index]
-                                                           [i + 1]]));
+                    }
+                    for (int i = 0; tri_table[cube_index][i] != -1; i += 3) {
+                        block.triangles_.push_back(Eigen::Vector3i(
+                                edge_to_index[tri_table[cube_index][i]],
+                                edge_to_index[tri_table[cube_index][i + 2]],
+                                edge_to_index[tri_table[cube_index][i + 1]]));
+                    }
+                }
+            }
+        }
+    }
+    return MergeMarchingCubesBlocks(blocks);
+}
+
+std::tuple<std::shared_ptr<geometry::Image>,
+           std::shared_ptr<geometry::Image>,
+           std::shared_ptr<geometry::Image>,
+           std::shared_ptr<geometry::Image>>
+ScalableTSDFVolume::Raycast(const camera::PinholeCameraIntrinsic &intrinsic,
+                            const Eigen::Matrix4d &extrinsic) {
+    const double fx = intrinsic.GetFocalLength().first;
+    const double fy = intrinsic.GetFocalLength().second;
+    const double cx = intrinsic.GetPrincipalPoint().first;
+    const double cy = intrinsic.GetPrincipalPoint().second;
+    const Eigen::Matrix4d pose = extrinsic.inverse();
+    const Eigen::Matrix3d R = extrinsic.block<3, 3>(0, 0);
+    const Eigen::Vector3d o = pose.block<3, 1>(0, 3);
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    // The rays are clipped to the bounding box of the volume units.
+    Eigen::Vector3i index_min =
+            Eigen::Vector3i::Constant(std::numeric_limits<int>::max());
+    Eigen::Vector3i index_max =
+            Eigen::Vector3i::Constant(std::numeric_limits<int>::lowest());
+    for (const auto &unit : volume_units_) {
+        index_min = index_min.cwiseMin(unit.first);
+        index_max = index_max.cwiseMax(unit.first);
+    }
+    const Eigen::Vector3d box_min =
+            index_min.cast<double>() * volume_unit_length_;
+    const Eigen::Vector3d box_max =
+            (index_max + Eigen::Vector3i::Ones()).cast<double>() *
+            volume_unit_length_;
+
+    auto depth = std::make_shared<geometry::Image>();
+    auto vertex_map = std::make_shared<geometry::Image>();
+    auto normal_map = std::make_shared<geometry::Image>();
+    auto color = std::make_shared<geometry::Image>();
+    depth->Prepare(intrinsic.width_, intrinsic.height_, 1, 4);
+    vertex_map->Prepare(intrinsic.width_, intrinsic.height_, 3, 4);
+    normal_map->Prepare(intrinsic.width_, intrinsic.height_, 3, 4);
+    if (color_type_ == TSDFVolumeColorType::RGB8) {
+        color->Prepare(intrinsic.width_, intrinsic.height_, 3, 1);
+    } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+        color->Prepare(intrinsic.width_, intrinsic.height_, 1, 4);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int v = 0; v < intrinsic.height_; v++) {
+        for (int u = 0; u < intrinsic.width_; u++) {
+            // A point of the ray is o + s * dir, at depth s from the camera.
+            const Eigen::Vector3d ray((u - cx) / fx, (v - cy) / fy, 1.0);
+            const Eigen::Vector3d dir = pose.block<3, 3>(0, 0) * ray;
+            const double s_per_length = 1.0 / dir.norm();
+            double s_min = 0.0;
+            double s_max = volume_units_.empty()
+                                   ? -1.0
+                                   : std::numeric_limits<double>::max();
+            for (int i = 0; i < 3; i++) {
+                if (dir(i) == 0.0) {
+                    if (o(i) < box_min(i) || o(i) > box_max(i)) s_max = -1.0;
+                    continue;
+                }
+                double s0 = (box_min(i) - o(i)) / dir(i);
+                double s1 = (box_max(i) - o(i)) / dir(i);
+                s_min = std::max(s_min, std::min(s0, s1));
+                s_max = std::min(s_max, std::max(s0, s1));
+            }
+
+            // Traverse the volume units along the ray with a 3D DDA. A unit
+            // that is not allocated is skipped at once. In the others, march
+            // in steps of the distance to the surface, at least a voxel, until
+            // the TSDF changes from positive to negative.
+            double s_hit = -1.0;
+            if (s_min < s_max) {
+                Eigen::Vector3i index = LocateVolumeUnit(o + s_min * dir)
+                                                .cwiseMax(index_min)
+                                                .cwiseMin(index_max);
+                Eigen::Vector3i index_step;
+                Eigen::Vector3d s_next, s_delta;
+                for (int i = 0; i < 3; i++) {
+                    if (dir(i) > 0.0) {
+                        index_step(i) = 1;
+                        s_next(i) = ((index(i) + 1) * volume_unit_length_ -
+                                     o(i)) /
+                                    dir(i);
+                        s_delta(i) = volume_unit_length_ / dir(i);
+                    } else if (dir(i) < 0.0) {
+                        index_step(i) = -1;
+                        s_next(i) = (index(i) * volume_unit_length_ - o(i)) /
+                                    dir(i);
+                        s_delta(i) = -volume_unit_length_ / dir(i);
+                    } else {
+                        index_step(i) = 0;
+                        s_next(i) = std::numeric_limits<double>::max();
+                        s_delta(i) = 0.0;
+                    }
+                }
+                double s = s_min, s_prev = 0.0, f_prev = 0.0;
+                while (s < s_max && s_hit < 0.0) {
+                    int axis;
+                    s_next.minCoeff(&axis);
+                    const double s_exit = std::min(s_next(axis), s_max);
+                    auto unit_itr = volume_units_.find(index);
+                    if (unit_itr == volume_units_.end()) {
+                        f_prev = 0.0;
+                        s = std::max(s, s_exit);
+                    }
+                    while (s < s_exit) {
+                        double f = GetTSDFAt(o + s * dir,
+                                             *unit_itr->second.volume_);
+                        if (f_prev > 0.0 && f < 0.0) {
+                            s_hit = s_prev +
+                                    (s - s_prev) * f_prev / (f_prev - f);
+                            break;
                         }
+                        f_prev = f;
+                        s_prev = s;
+                        s += std::max(f * sdf_trunc_, voxel_length_) *
+                             s_per_length;
+                    }
+                    index(axis) += index_step(axis);
+                    s_next(axis) += s_delta(axis);
+                }
+            }
+
+            float *vertex = vertex_map->PointerAt<float>(u, v, 0);
+            float *normal = normal_map->PointerAt<float>(u, v, 0);
+            if (s_hit < 0.0) {
+                for (int i = 0; i < 3; i++) {
+                    vertex[i] = nan;
+                    normal[i] = nan;
+                }
+                continue;
+            }
+            const Eigen::Vector3d p = o + s_hit * dir;
+            auto unit_itr = volume_units_.find(LocateVolumeUnit(p));
+            if (unit_itr == volume_units_.end()) {
+                // Only if p is rounded out of the unit it was found in.
+                for (int i = 0; i < 3; i++) {
+                    vertex[i] = nan;
+                    normal[i] = nan;
+                }
+                continue;
+            }
+            auto &volume = *unit_itr->second.volume_;
+            const Eigen::Vector3d n = R * GetNormalAt(p, volume);
+            *depth->PointerAt<float>(u, v) = (float)s_hit;
+            for (int i = 0; i < 3; i++) {
+                vertex[i] = (float)(s_hit * ray(i));
+                normal[i] = (float)n(i);
+            }
+            if (color_type_ != TSDFVolumeColorType::NoColor) {
+                // The color of the voxel containing the hit.
+                Eigen::Vector3i idx;
+                for (int i = 0; i < 3; i++) {
+                    idx(i) = std::min(
+                            std::max((int)((p(i) - volume.origin_(i)) /
+                                           voxel_length_),
+                                     0),
+                            volume_unit_resolution_ - 1);
+                }
+                const Eigen::Vector3d c = volume.GetColor(volume.IndexOf(idx));
+                if (color_type_ == TSDFVolumeColorType::RGB8) {
+                    uint8_t *rgb = color->PointerAt<uint8_t>(u, v, 0);
+                    for (int i = 0; i < 3; i++) {
+                        rgb[i] = (uint8_t)(c(i) * 255.0 + 0.5);
                     }
+                } else {
+                    *color->PointerAt<float>(u, v) = (float)c(0);
                 }
             }
         }
     }
-    return mesh;
+    return std::make_tuple(depth, vertex_map, normal_map, color);
 }
 
 std::shared_ptr<geometry::PointCloud>
@@ -381,6 +603,73 @@ std::shared_ptr<UniformTSDFVolume> ScalableTSDFVolume::OpenVolumeUnit(
     return unit.volume_;
 }
 
+bool ScalableTSDFVolume::IsVolumeUnitObserved(
+        const Eigen::Vector3i &index,
+        const geometry::Image &depth,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic) const {
+    const double fx = intrinsic.GetFocalLength().first;
+    const double fy = intrinsic.GetFocalLength().second;
+    const double cx = intrinsic.GetPrincipalPoint().first;
+    const double cy = intrinsic.GetPrincipalPoint().second;
+    const Eigen::Vector3d origin = index.cast<double>() * volume_unit_length_;
+
+    // Project the corners of the unit, which bound all its voxel centers.
+    // The bounding rectangle follows the rounding of
+    // UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier.
+    double min_z = std::numeric_limits<double>::max();
+    double u_min = std::numeric_limits<double>::max();
+    double v_min = std::numeric_limits<double>::max();
+    double u_max = std::numeric_limits<double>::lowest();
+    double v_max = std::numeric_limits<double>::lowest();
+    for (int i = 0; i < 8; i++) {
+        Eigen::Vector3d corner =
+                origin + volume_unit_length_ *
+                                 Eigen::Vector3d(i & 1, (i >> 1) & 1,
+                                                 (i >> 2) & 1);
+        Eigen::Vector3d pt = extrinsic.block<3, 3>(0, 0) * corner +
+                             extrinsic.block<3, 1>(0, 3);
+        if (pt(2) <= 0.0) {
+            // The unit crosses the image plane, do not cull it.
+            return true;
+        }
+        min_z = std::min(min_z, pt(2));
+        double u = pt(0) * fx / pt(2) + cx + 0.5;
+        double v = pt(1) * fy / pt(2) + cy + 0.5;
+        u_min = std::min(u_min, u);
+        u_max = std::max(u_max, u);
+        v_min = std::min(v_min, v);
+        v_max = std::max(v_max, v);
+    }
+    if (u_max < 0.0 || v_max < 0.0 || u_min >= depth.width_ ||
+        v_min >= depth.height_) {
+        return false;
+    }
+    if (!skip_occluded_volume_units_) {
+        return true;
+    }
+
+    // The voxels of the unit are at least min_z away from the camera. If every
+    // observed depth over the footprint of the unit is closer than
+    // min_z - sdf_trunc_, every voxel gets sdf < -sdf_trunc_ and is skipped
+    // by the integration anyway. Every pixel is checked, since a single one
+    // that sees past the unit keeps it.
+    int u0 = std::max(0, (int)u_min);
+    int v0 = std::max(0, (int)v_min);
+    int u1 = std::min(depth.width_ - 1, (int)u_max);
+    int v1 = std::min(depth.height_ - 1, (int)v_max);
+    const double min_visible_depth = min_z - sdf_trunc_;
+    for (int v = v0; v <= v1; v++) {
+        const float *d = depth.PointerAt<float>(0, v);
+        for (int u = u0; u <= u1; u++) {
+            if (d[u] > 0.0f && d[u] >= min_visible_depth) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 Eigen::Vector3d ScalableTSDFVolume::GetNormalAt(const Eigen::Vector3d &p) {
     Eigen::Vector3d n;
     const double half_gap = 0.99 * voxel_length_;
@@ -421,7 +710,7 @@ double ScalableTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p) {
         if (idx1(0) < volume_unit_resolution_ &&
             idx1(1) < volume_unit_resolution_ &&
             idx1(2) < volume_unit_resolution_) {
-            f[i] = volume0.voxels_[volume0.IndexOf(idx1)].tsdf_;
+            f[i] = volume0.tsdf_[volume0.IndexOf(idx1)];
         } else {
             for (int j = 0; j < 3; j++) {
                 if (idx1(j) >= volume_unit_resolution_) {
@@ -434,7 +723,7 @@ double ScalableTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p) {
                 f[i] = 0.0f;
             } else {
                 const auto &volume1 = *unit_itr1->second.volume_;
-                f[i] = volume1.voxels_[volume1.IndexOf(idx1)].tsdf_;
+                f[i] = volume1.tsdf_[volume1.IndexOf(idx1)];
             }
         }
     }
@@ -444,5 +733,25 @@ double ScalableTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p) {
                    r(1) * ((1 - r(2)) * f[2] + r(2) * f[6]));
 }
 
+Eigen::Vector3d ScalableTSDFVolume::GetNormalAt(const Eigen::Vector3d &p,
+                                                UniformTSDFVolume &volume) {
+    const Eigen::Vector3d p_grid = (p - volume.origin_) / voxel_length_;
+    if ((p_grid.array() >= 1.5).all() &&
+        (p_grid.array() < volume_unit_resolution_ - 1.5).all()) {
+        return volume.GetNormalAt(p - volume.origin_);
+    }
+    return GetNormalAt(p);
+}
+
+double ScalableTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p,
+                                     UniformTSDFVolume &volume) {
+    const Eigen::Vector3d p_grid = (p - volume.origin_) / voxel_length_;
+    if ((p_grid.array() >= 0.5).all() &&
+        (p_grid.array() < volume_unit_resolution_ - 0.5).all()) {
+        return volume.GetTSDFAt(p - volume.origin_);
+    }
+    return GetTSDFAt(p);
+}
+
 }  // namespace integration
 }  // namespace open3d
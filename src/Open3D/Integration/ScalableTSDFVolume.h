@@ -71,7 +71,8 @@ public:
                        double sdf_trunc,
                        TSDFVolumeColorType color_type,
                        int volume_unit_resolution = 16,
-                       int depth_sampling_stride = 4);
+                       int depth_sampling_stride = 4,
+                       bool skip_occluded_volume_units = false);
     ~ScalableTSDFVolume() override;
 
 public:
@@ -81,12 +82,22 @@ public:
                    const Eigen::Matrix4d &extrinsic) override;
     std::shared_ptr<geometry::PointCloud> ExtractPointCloud() override;
     std::shared_ptr<geometry::TriangleMesh> ExtractTriangleMesh() override;
+    /// The rays skip the space of the volume units that are not allocated.
+    std::tuple<std::shared_ptr<geometry::Image>,
+               std::shared_ptr<geometry::Image>,
+               std::shared_ptr<geometry::Image>,
+               std::shared_ptr<geometry::Image>>
+    Raycast(const camera::PinholeCameraIntrinsic &intrinsic,
+            const Eigen::Matrix4d &extrinsic) override;
     std::shared_ptr<geometry::PointCloud> ExtractVoxelPointCloud();
 
 public:
     int volume_unit_resolution_;
     double volume_unit_length_;
     int depth_sampling_stride_;
+    /// If true, Integrate() skips volume units that lie entirely more than
+    /// sdf_trunc_ behind the observed depth at every pixel of their footprint.
+    bool skip_occluded_volume_units_;
 
     /// Assume the index of the volume unit is (x, y, z), then the unit spans
     /// from (x, y, z) * volume_unit_length_
@@ -106,9 +117,24 @@ private:
     std::shared_ptr<UniformTSDFVolume> OpenVolumeUnit(
             const Eigen::Vector3i &index);
 
+    /// Returns false if no voxel of the volume unit can be updated by the
+    /// depth image, i.e., the unit is outside of the view frustum or (with
+    /// skip_occluded_volume_units_) behind the observed surface.
+    bool IsVolumeUnitObserved(const Eigen::Vector3i &index,
+                              const geometry::Image &depth,
+                              const camera::PinholeCameraIntrinsic &intrinsic,
+                              const Eigen::Matrix4d &extrinsic) const;
+
     Eigen::Vector3d GetNormalAt(const Eigen::Vector3d &p);
 
     double GetTSDFAt(const Eigen::Vector3d &p);
+
+    /// Same as GetNormalAt(p) and GetTSDFAt(p), but without looking up the
+    /// volume units if the samples only interpolate voxels of volume.
+    Eigen::Vector3d GetNormalAt(const Eigen::Vector3d &p,
+                                UniformTSDFVolume &volume);
+
+    double GetTSDFAt(const Eigen::Vector3d &p, UniformTSDFVolume &volume);
 };
 
 }  // namespace integration
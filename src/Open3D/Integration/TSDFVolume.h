@@ -26,6 +26,9 @@
 
 #pragma once
 
+#include <memory>
+#include <tuple>
+
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/RGBDImage.h"
@@ -73,6 +76,20 @@ public:
     /// (https://en.wikipedia.org/wiki/Marching_cubes)
     virtual std::shared_ptr<geometry::TriangleMesh> ExtractTriangleMesh() = 0;
 
+    /// Function to render the surface seen by a camera, by casting a ray
+    /// through each pixel to the first zero crossing of the TSDF from positive
+    /// to negative. The images are of the size of intrinsic.
+    /// output: depth (1 channel float, 0 where no surface is hit), vertex map
+    /// and normal map (3 channel float in camera coordinates, NaN where no
+    /// surface is hit), color (in the format of the integrated color images,
+    /// empty for TSDFVolumeColorType::NoColor)
+    virtual std::tuple<std::shared_ptr<geometry::Image>,
+                       std::shared_ptr<geometry::Image>,
+                       std::shared_ptr<geometry::Image>,
+                       std::shared_ptr<geometry::Image>>
+    Raycast(const camera::PinholeCameraIntrinsic &intrinsic,
+            const Eigen::Matrix4d &extrinsic) = 0;
+
 public:
     double voxel_length_;
     double sdf_trunc_;
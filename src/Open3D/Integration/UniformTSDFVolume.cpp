@@ -26,11 +26,14 @@
 
 #include "Open3D/Integration/UniformTSDFVolume.h"
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <thread>
 #include <unordered_map>
 
 #include "Open3D/Geometry/VoxelGrid.h"
+#include "Open3D/Integration/MarchingCubesBlock.h"
 #include "Open3D/Integration/MarchingCubesConst.h"
 #include "Open3D/Utility/Helper.h"
 
@@ -48,12 +51,22 @@ UniformTSDFVolume::UniformTSDFVolume(
       length_(length),
       resolution_(resolution),
       voxel_num_(resolution * resolution * resolution) {
-    voxels_.resize(voxel_num_);
+    Reset();
 }
 
 UniformTSDFVolume::~UniformTSDFVolume() {}
 
-void UniformTSDFVolume::Reset() { voxels_.clear(); }
+void UniformTSDFVolume::Reset() {
+    tsdf_.assign(voxel_num_, 0.0f);
+    weight_.assign(voxel_num_, 0);
+    color_.clear();
+    intensity_.clear();
+    if (color_type_ == TSDFVolumeColorType::RGB8) {
+        color_.assign(voxel_num_ * 3, 0.0f);
+    } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+        intensity_.assign(voxel_num_, 0.0f);
+    }
+}
 
 void UniformTSDFVolume::Integrate(
         const geometry::RGBDImage &image,
@@ -95,11 +108,9 @@ std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
         for (int y = 1; y < resolution_ - 1; y++) {
             for (int z = 1; z < resolution_ - 1; z++) {
                 Eigen::Vector3i idx0(x, y, z);
-                float w0 = voxels_[IndexOf(idx0)].weight_;
-                float f0 = voxels_[IndexOf(idx0)].tsdf_;
-                const Eigen::Vector3d &c0 = voxels_[IndexOf(idx0)].color_;
-
-                if (!(w0 != 0.0f && f0 < 0.98f && f0 >= -0.98f)) {
+                int ind0 = IndexOf(idx0);
+                float f0 = tsdf_[ind0];
+                if (!(weight_[ind0] != 0 && f0 < 0.98f && f0 >= -0.98f)) {
                     continue;
                 }
                 Eigen::Vector3d p0(half_voxel_length + voxel_length_ * x,
@@ -111,27 +122,20 @@ std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
                     Eigen::Vector3i idx1 = idx0;
                     idx1(i) += 1;
                     if (idx1(i) < resolution_ - 1) {
-                        float w1 = voxels_[IndexOf(idx1)].weight_;
-                        float f1 = voxels_[IndexOf(idx1)].tsdf_;
-                        const Eigen::Vector3d &c1 =
-                                voxels_[IndexOf(idx1)].color_;
-                        if (w1 != 0.0f && f1 < 0.98f && f1 >= -0.98f &&
+                        int ind1 = IndexOf(idx1);
+                        float f1 = tsdf_[ind1];
+                        if (weight_[ind1] != 0 && f1 < 0.98f && f1 >= -0.98f &&
                             f0 * f1 < 0) {
                             float r0 = std::fabs(f0);
                             float r1 = std::fabs(f1);
                             Eigen::Vector3d p = p0;
                             p(i) = (p0(i) * r1 + p1(i) * r0) / (r0 + r1);
                             pointcloud->points_.push_back(p + origin_);
-                            if (color_type_ == TSDFVolumeColorType::RGB8) {
-                                pointcloud->colors_.push_back(
-                                        ((c0 * r1 + c1 * r0) / (r0 + r1) /
-                                         255.0f)
-                                                .cast<double>());
-                            } else if (color_type_ ==
-                                       TSDFVolumeColorType::Gray32) {
+                            if (color_type_ != TSDFVolumeColorType::NoColor) {
                                 pointcloud->colors_.push_back(
-                                        ((c0 * r1 + c1 * r0) / (r0 + r1))
-                                                .cast<double>());
+                                        (GetColor(ind0) * r1 +
+                                         GetColor(ind1) * r0) /
+                                        (r0 + r1));
                             }
                             // has_normal
                             pointcloud->normals_.push_back(GetNormalAt(p));
@@ -148,38 +152,72 @@ std::shared_ptr<geometry::TriangleMesh>
 UniformTSDFVolume::ExtractTriangleMesh() {
     // implementation of marching cubes, based on
     // http://paulbourke.net/geometry/polygonise/
-    auto mesh = std::make_shared<geometry::TriangleMesh>();
-    double half_voxel_length = voxel_length_ * 0.5;
-    // Map of "edge_index = (x, y, z, 0) + edge_shift" to "global vertex index"
-    std::unordered_map<
-            Eigen::Vector4i, int, utility::hash_eigen::hash<Eigen::Vector4i>,
-            std::equal_to<Eigen::Vector4i>,
-            Eigen::aligned_allocator<std::pair<const Eigen::Vector4i, int>>>
-            edgeindex_to_vertexindex;
-    int edge_to_index[12];
+    // The volume is split into slabs of constant x that are processed in
+    // parallel. Each slab owns the vertices on the edges starting at its
+    // voxels, which are created in a first pass. The triangles of the cubes
+    // are created in a second pass and look up the vertices of their slab
+    // and of the next one.
+    const double half_voxel_length = voxel_length_ * 0.5;
+    const bool has_color = color_type_ != TSDFVolumeColorType::NoColor;
+    std::vector<MarchingCubesBlock> slabs(resolution_);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int x = 0; x < resolution_; x++) {
+        auto &slab = slabs[x];
+        for (int y = 0; y < resolution_; y++) {
+            for (int z = 0; z < resolution_; z++) {
+                Eigen::Vector3i idx0(x, y, z);
+                int ind0 = IndexOf(idx0);
+                if (weight_[ind0] == 0) {
+                    continue;
+                }
+                for (int i = 0; i < 3; i++) {
+                    Eigen::Vector3i idx1 = idx0;
+                    idx1(i) += 1;
+                    if (idx1(i) >= resolution_) {
+                        continue;
+                    }
+                    int ind1 = IndexOf(idx1);
+                    if (weight_[ind1] == 0 ||
+                        (tsdf_[ind0] < 0.0f) == (tsdf_[ind1] < 0.0f)) {
+                        continue;
+                    }
+                    Eigen::Vector3d pt(half_voxel_length + voxel_length_ * x,
+                                       half_voxel_length + voxel_length_ * y,
+                                       half_voxel_length + voxel_length_ * z);
+                    double f0 = std::abs((double)tsdf_[ind0]);
+                    double f1 = std::abs((double)tsdf_[ind1]);
+                    pt(i) += f0 * voxel_length_ / (f0 + f1);
+                    slab.edge_ids_.push_back((y * resolution_ + z) * 3 + i);
+                    slab.vertices_.push_back(pt + origin_);
+                    if (has_color) {
+                        slab.vertex_colors_.push_back(
+                                (f1 * GetColor(ind0) + f0 * GetColor(ind1)) /
+                                (f0 + f1));
+                    }
+                }
+            }
+        }
+    }
+    ComputeMarchingCubesVertexOffsets(slabs);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
     for (int x = 0; x < resolution_ - 1; x++) {
+        auto &slab = slabs[x];
+        int edge_to_index[12];
         for (int y = 0; y < resolution_ - 1; y++) {
             for (int z = 0; z < resolution_ - 1; z++) {
                 int cube_index = 0;
-                float f[8];
-                Eigen::Vector3d c[8];
                 for (int i = 0; i < 8; i++) {
-                    Eigen::Vector3i idx = Eigen::Vector3i(x, y, z) + shift[i];
-
-                    if (voxels_[IndexOf(idx)].weight_ == 0.0f) {
+                    int ind = IndexOf(Eigen::Vector3i(x, y, z) + shift[i]);
+                    if (weight_[ind] == 0) {
                         cube_index = 0;
                         break;
-                    } else {
-                        f[i] = voxels_[IndexOf(idx)].tsdf_;
-                        if (f[i] < 0.0f) {
-                            cube_index |= (1 << i);
-                        }
-                        if (color_type_ == TSDFVolumeColorType::RGB8) {
-                            c[i] = voxels_[IndexOf(idx)].color_.cast<double>() /
-                                   255.0;
-                        } else if (color_type_ == TSDFVolumeColorType::Gray32) {
-                            c[i] = voxels_[IndexOf(idx)].color_.cast<double>();
-                        }
+                    } else if (tsdf_[ind] < 0.0f) {
+                        cube_index |= (1 << i);
                     }
                 }
                 if (cube_index == 0 || cube_index == 255) {
@@ -189,37 +227,16 @@ UniformTSDFVolume::ExtractTriangleMesh() {
                     if (edge_table[cube_index] & (1 << i)) {
                         Eigen::Vector4i edge_index =
                                 Eigen::Vector4i(x, y, z, 0) + edge_shift[i];
-                        if (edgeindex_to_vertexindex.find(edge_index) ==
-                            edgeindex_to_vertexindex.end()) {
-                            edge_to_index[i] = (int)mesh->vertices_.size();
-                            edgeindex_to_vertexindex[edge_index] =
-                                    (int)mesh->vertices_.size();
-                            Eigen::Vector3d pt(
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(0),
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(1),
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(2));
-                            double f0 = std::abs((double)f[edge_to_vert[i][0]]);
-                            double f1 = std::abs((double)f[edge_to_vert[i][1]]);
-                            pt(edge_index(3)) += f0 * voxel_length_ / (f0 + f1);
-                            mesh->vertices_.push_back(pt + origin_);
-                            if (color_type_ != TSDFVolumeColorType::NoColor) {
-                                const auto &c0 = c[edge_to_vert[i][0]];
-                                const auto &c1 = c[edge_to_vert[i][1]];
-                                mesh->vertex_colors_.push_back(
-                                        (f1 * c0 + f0 * c1) / (f0 + f1));
-                            }
-                        } else {
-                            edge_to_index[i] =
-                                    edgeindex_to_vertexindex.find(edge_index)
-                                            ->second;
-                        }
+                        edge_to_index[i] =
+                                slabs[edge_index(0)].GetVertexIndex(
+                                        (edge_index(1) * resolution_ +
+                                         edge_index(2)) *
+                                                3 +
+                                        edge_index(3));
                     }
                 }
                 for (int i = 0; tri_table[cube_index][i] != -1; i += 3) {
-                    mesh->triangles_.push_back(Eigen::Vector3i(
+                    slab.triangles_.push_back(Eigen::Vector3i(
                             edge_to_index[tri_table[cube_index][i]],
                             edge_to_index[tri_table[cube_index][i + 2]],
                             edge_to_index[tri_table[cube_index][i + 1]]));
@@ -227,7 +244,118 @@ UniformTSDFVolume::ExtractTriangleMesh() {
             }
         }
     }
-    return mesh;
+    return MergeMarchingCubesBlocks(slabs);
+}
+
+std::tuple<std::shared_ptr<geometry::Image>,
+           std::shared_ptr<geometry::Image>,
+           std::shared_ptr<geometry::Image>,
+           std::shared_ptr<geometry::Image>>
+UniformTSDFVolume::Raycast(const camera::PinholeCameraIntrinsic &intrinsic,
+                           const Eigen::Matrix4d &extrinsic) {
+    const double fx = intrinsic.GetFocalLength().first;
+    const double fy = intrinsic.GetFocalLength().second;
+    const double cx = intrinsic.GetPrincipalPoint().first;
+    const double cy = intrinsic.GetPrincipalPoint().second;
+    const Eigen::Matrix4d pose = extrinsic.inverse();
+    const Eigen::Matrix3d R = extrinsic.block<3, 3>(0, 0);
+    // The rays are traced in the coordinates of the volume, where GetTSDFAt()
+    // samples.
+    const Eigen::Vector3d o = pose.block<3, 1>(0, 3) - origin_;
+    // Samples and normals between the margins do not interpolate beyond the
+    // outermost voxels.
+    const Eigen::Vector3d box_min =
+            Eigen::Vector3d::Constant(1.5 * voxel_length_);
+    const Eigen::Vector3d box_max =
+            Eigen::Vector3d::Constant(length_ - 1.5 * voxel_length_);
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    auto depth = std::make_shared<geometry::Image>();
+    auto vertex_map = std::make_shared<geometry::Image>();
+    auto normal_map = std::make_shared<geometry::Image>();
+    auto color = std::make_shared<geometry::Image>();
+    depth->Prepare(intrinsic.width_, intrinsic.height_, 1, 4);
+    vertex_map->Prepare(intrinsic.width_, intrinsic.height_, 3, 4);
+    normal_map->Prepare(intrinsic.width_, intrinsic.height_, 3, 4);
+    if (color_type_ == TSDFVolumeColorType::RGB8) {
+        color->Prepare(intrinsic.width_, intrinsic.height_, 3, 1);
+    } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+        color->Prepare(intrinsic.width_, intrinsic.height_, 1, 4);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int v = 0; v < intrinsic.height_; v++) {
+        for (int u = 0; u < intrinsic.width_; u++) {
+            // A point of the ray is o + s * dir, at depth s from the camera.
+            const Eigen::Vector3d ray((u - cx) / fx, (v - cy) / fy, 1.0);
+            const Eigen::Vector3d dir = pose.block<3, 3>(0, 0) * ray;
+            const double s_per_length = 1.0 / dir.norm();
+            double s_min = 0.0;
+            double s_max = std::numeric_limits<double>::max();
+            for (int i = 0; i < 3; i++) {
+                if (dir(i) == 0.0) {
+                    if (o(i) < box_min(i) || o(i) > box_max(i)) s_max = -1.0;
+                    continue;
+                }
+                double s0 = (box_min(i) - o(i)) / dir(i);
+                double s1 = (box_max(i) - o(i)) / dir(i);
+                s_min = std::max(s_min, std::min(s0, s1));
+                s_max = std::min(s_max, std::max(s0, s1));
+            }
+
+            // March in steps of the distance to the surface, at least a voxel,
+            // until the TSDF changes from positive to negative.
+            double s_hit = -1.0;
+            double s = s_min, s_prev = 0.0, f_prev = 0.0;
+            while (s <= s_max) {
+                double f = GetTSDFAt(o + s * dir);
+                if (f_prev > 0.0 && f < 0.0) {
+                    s_hit = s_prev + (s - s_prev) * f_prev / (f_prev - f);
+                    break;
+                }
+                f_prev = f;
+                s_prev = s;
+                s += std::max(f * sdf_trunc_, voxel_length_) * s_per_length;
+            }
+
+            float *vertex = vertex_map->PointerAt<float>(u, v, 0);
+            float *normal = normal_map->PointerAt<float>(u, v, 0);
+            if (s_hit < 0.0) {
+                for (int i = 0; i < 3; i++) {
+                    vertex[i] = nan;
+                    normal[i] = nan;
+                }
+                continue;
+            }
+            const Eigen::Vector3d p = o + s_hit * dir;
+            const Eigen::Vector3d n = R * GetNormalAt(p);
+            *depth->PointerAt<float>(u, v) = (float)s_hit;
+            for (int i = 0; i < 3; i++) {
+                vertex[i] = (float)(s_hit * ray(i));
+                normal[i] = (float)n(i);
+            }
+            if (color_type_ != TSDFVolumeColorType::NoColor) {
+                // The color of the voxel containing the hit.
+                Eigen::Vector3i idx;
+                for (int i = 0; i < 3; i++) {
+                    idx(i) = std::min(std::max((int)(p(i) / voxel_length_), 0),
+                                      resolution_ - 1);
+                }
+                const Eigen::Vector3d c = GetColor(IndexOf(idx));
+                if (color_type_ == TSDFVolumeColorType::RGB8) {
+                    uint8_t *rgb = color->PointerAt<uint8_t>(u, v, 0);
+                    for (int i = 0; i < 3; i++) {
+                        rgb[i] = (uint8_t)(c(i) * 255.0 + 0.5);
+                    }
+                } else {
+                    *color->PointerAt<float>(u, v) = (float)c(0);
+                }
+            }
+        }
+    }
+    return std::make_tuple(depth, vertex_map, normal_map, color);
 }
 
 std::shared_ptr<geometry::PointCloud>
@@ -244,11 +372,10 @@ UniformTSDFVolume::ExtractVoxelPointCloud() const {
                                    half_voxel_length + voxel_length_ * y,
                                    half_voxel_length + voxel_length_ * z);
                 int ind = IndexOf(x, y, z);
-                if (voxels_[ind].weight_ != 0.0f &&
-                    voxels_[ind].tsdf_ < 0.98f &&
-                    voxels_[ind].tsdf_ >= -0.98f) {
+                if (weight_[ind] != 0 && tsdf_[ind] < 0.98f &&
+                    tsdf_[ind] >= -0.98f) {
                     voxel->points_.push_back(pt + origin_);
-                    double c = (voxels_[ind].tsdf_ + 1.0) * 0.5;
+                    double c = (tsdf_[ind] + 1.0) * 0.5;
                     voxel->colors_.push_back(Eigen::Vector3d(c, c, c));
                 }
             }
@@ -267,9 +394,8 @@ std::shared_ptr<geometry::VoxelGrid> UniformTSDFVolume::ExtractVoxelGrid()
         for (int y = 0; y < resolution_; y++) {
             for (int z = 0; z < resolution_; z++) {
                 const int ind = IndexOf(x, y, z);
-                const float w = voxels_[ind].weight_;
-                const float f = voxels_[ind].tsdf_;
-                if (w != 0.0f && f < 0.98f && f >= -0.98f) {
+                const float f = tsdf_[ind];
+                if (weight_[ind] != 0 && f < 0.98f && f >= -0.98f) {
                     double c = (f + 1.0) * 0.5;
                     Eigen::Vector3d color = Eigen::Vector3d(c, c, c);
                     Eigen::Vector3i index = Eigen::Vector3i(x, y, z);
@@ -346,29 +472,27 @@ void UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
                 if (sdf > -sdf_trunc_f) {
                     // integrate
                     float tsdf = std::min(1.0f, sdf * sdf_trunc_inv_f);
-                    voxels_[v_ind].tsdf_ =
-                            (voxels_[v_ind].tsdf_ * voxels_[v_ind].weight_ +
-                             tsdf) /
-                            (voxels_[v_ind].weight_ + 1.0f);
+                    float weight = weight_[v_ind];
+                    tsdf_[v_ind] =
+                            (tsdf_[v_ind] * weight + tsdf) / (weight + 1.0f);
                     if (color_type_ == TSDFVolumeColorType::RGB8) {
                         const uint8_t *rgb =
                                 image.color_.PointerAt<uint8_t>(u, v, 0);
-                        Eigen::Vector3d rgb_f(rgb[0], rgb[1], rgb[2]);
-                        voxels_[v_ind].color_ =
-                                (voxels_[v_ind].color_ *
-                                         voxels_[v_ind].weight_ +
-                                 rgb_f) /
-                                (voxels_[v_ind].weight_ + 1.0f);
+                        float *color = &color_[3 * v_ind];
+                        for (int c = 0; c < 3; c++) {
+                            color[c] = (color[c] * weight + rgb[c]) /
+                                       (weight + 1.0f);
+                        }
                     } else if (color_type_ == TSDFVolumeColorType::Gray32) {
                         const float *intensity =
                                 image.color_.PointerAt<float>(u, v, 0);
-                        voxels_[v_ind].color_ =
-                                (voxels_[v_ind].color_.array() *
-                                         voxels_[v_ind].weight_ +
-                                 (*intensity)) /
-                                (voxels_[v_ind].weight_ + 1.0f);
+                        intensity_[v_ind] =
+                                (intensity_[v_ind] * weight + (*intensity)) /
+                                (weight + 1.0f);
+                    }
+                    if (weight_[v_ind] < std::numeric_limits<uint16_t>::max()) {
+                        weight_[v_ind]++;
                     }
-                    voxels_[v_ind].weight_ += 1.0f;
                 }
             }
         }
@@ -398,21 +522,21 @@ double UniformTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p) {
 
     double tsdf = 0;
     tsdf += (1 - r(0)) * (1 - r(1)) * (1 - r(2)) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(0, 0, 0))].tsdf_;
+            tsdf_[IndexOf(idx + Eigen::Vector3i(0, 0, 0))];
     tsdf += (1 - r(0)) * (1 - r(1)) * r(2) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(0, 0, 1))].tsdf_;
+            tsdf_[IndexOf(idx + Eigen::Vector3i(0, 0, 1))];
     tsdf += (1 - r(0)) * r(1) * (1 - r(2)) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(0, 1, 0))].tsdf_;
+            tsdf_[IndexOf(idx + Eigen::Vector3i(0, 1, 0))];
     tsdf += (1 - r(0)) * r(1) * r(2) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(0, 1, 1))].tsdf_;
+            tsdf_[IndexOf(idx + Eigen::Vector3i(0, 1, 1))];
     tsdf += r(0) * (1 - r(1)) * (1 - r(2)) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(1, 0, 0))].tsdf_;
+            tsdf_[IndexOf(idx + Eigen::Vector3i(1, 0, 0))];
     tsdf += r(0) * (1 - r(1)) * r(2) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(1, 0, 1))].tsdf_;
+            tsdf_[IndexOf(idx + Eigen::Vector3i(1, 0, 1))];
     tsdf += r(0) * r(1) * (1 - r(2)) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(1, 1, 0))].tsdf_;
+            tsdf_[IndexOf(idx + Eigen::Vector3i(1, 1, 0))];
     tsdf += r(0) * r(1) * r(2) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(1, 1, 1))].tsdf_;
+            tsdf_[IndexOf(idx + Eigen::Vector3i(1, 1, 1))];
     return tsdf;
 }
 
@@ -26,28 +26,13 @@
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "Open3D/Geometry/VoxelGrid.h"
 #include "Open3D/Integration/TSDFVolume.h"
 
 namespace open3d {
-
-namespace geometry {
-
-class TSDFVoxel : public Voxel {
-public:
-    TSDFVoxel() : Voxel() {}
-    TSDFVoxel(const Eigen::Vector3i &grid_index) : Voxel(grid_index) {}
-    TSDFVoxel(const Eigen::Vector3i &grid_index, const Eigen::Vector3d &color)
-        : Voxel(grid_index, color) {}
-    ~TSDFVoxel() {}
-
-public:
-    float tsdf_ = 0;
-    float weight_ = 0;
-};
-
-}  // namespace geometry
-
 namespace integration {
 
 class UniformTSDFVolume : public TSDFVolume {
@@ -66,6 +51,12 @@ public:
                    const Eigen::Matrix4d &extrinsic) override;
     std::shared_ptr<geometry::PointCloud> ExtractPointCloud() override;
     std::shared_ptr<geometry::TriangleMesh> ExtractTriangleMesh() override;
+    std::tuple<std::shared_ptr<geometry::Image>,
+               std::shared_ptr<geometry::Image>,
+               std::shared_ptr<geometry::Image>,
+               std::shared_ptr<geometry::Image>>
+    Raycast(const camera::PinholeCameraIntrinsic &intrinsic,
+            const Eigen::Matrix4d &extrinsic) override;
 
     /// Debug function to extract the voxel data into a VoxelGrid
     std::shared_ptr<geometry::PointCloud> ExtractVoxelPointCloud() const;
@@ -87,14 +78,38 @@ public:
         return IndexOf(xyz(0), xyz(1), xyz(2));
     }
 
+    /// Returns the color of the voxel with index ind, normalized to [0, 1]
+    inline Eigen::Vector3d GetColor(int ind) const {
+        if (color_type_ == TSDFVolumeColorType::RGB8) {
+            return Eigen::Vector3d(color_[3 * ind], color_[3 * ind + 1],
+                                   color_[3 * ind + 2]) /
+                   255.0;
+        } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+            return Eigen::Vector3d::Constant(intensity_[ind]);
+        }
+        return Eigen::Vector3d::Zero();
+    }
+
 public:
-    std::vector<geometry::TSDFVoxel> voxels_;
+    /// The voxels are stored as structure of arrays, all indexed by IndexOf().
+    /// Truncated signed distance of each voxel, normalized to [-1, 1]
+    std::vector<float> tsdf_;
+    /// Number of observations integrated into each voxel, saturates at 65535
+    std::vector<uint16_t> weight_;
+    /// Interleaved RGB colors in [0, 255], only allocated for
+    /// TSDFVolumeColorType::RGB8. Kept in float so that the running average
+    /// keeps moving after many observations.
+    std::vector<float> color_;
+    /// Intensities, only allocated for TSDFVolumeColorType::Gray32
+    std::vector<float> intensity_;
     Eigen::Vector3d origin_;
     double length_;
     int resolution_;
     int voxel_num_;
 
 private:
+    friend class ScalableTSDFVolume;
+
     Eigen::Vector3d GetNormalAt(const Eigen::Vector3d &p);
 
     double GetTSDFAt(const Eigen::Vector3d &p);
@@ -27,6 +27,7 @@
 #include "Open3D/Odometry/Odometry.h"
 
 #include <Eigen/Dense>
+#include <cstring>
 
 #include "Open3D/Geometry/Image.h"
 #include "Open3D/Geometry/RGBDImage.h"
@@ -39,162 +40,172 @@ namespace open3d {
 namespace {
 using namespace odometry;
 
-std::tuple<std::shared_ptr<geometry::Image>, std::shared_ptr<geometry::Image>>
-InitializeCorrespondenceMap(int width, int height) {
-    // initialization: filling with any (u,v) to (-1,-1)
-    auto correspondence_map = std::make_shared<geometry::Image>();
-    auto depth_buffer = std::make_shared<geometry::Image>();
-    correspondence_map->Prepare(width, height, 2, 4);
-    depth_buffer->Prepare(width, height, 1, 4);
-    for (int v = 0; v < correspondence_map->height_; v++) {
-        for (int u = 0; u < correspondence_map->width_; u++) {
-            *correspondence_map->PointerAt<int>(u, v, 0) = -1;
-            *correspondence_map->PointerAt<int>(u, v, 1) = -1;
-            *depth_buffer->PointerAt<float>(u, v, 0) = -1.0f;
-        }
+/// Scratch buffers of the correspondence search, which are reused by all
+/// the iterations of an odometry.
+struct CorrespondenceBuffer {
+    /// Per source pixel, the index of the corresponding target pixel, or -1.
+    std::vector<int> target_index_;
+    /// Per source row, the offset of its correspondences in the output.
+    std::vector<int> row_offset_;
+};
+
+/// Writes the correspondences found by the first pass of a correspondence
+/// search at the offsets of their source rows. On input, row_offset_[v + 1]
+/// holds the number of correspondences of source row v.
+void CompactCorrespondence(int width,
+                           int height,
+                           int target_width,
+                           CorrespondenceBuffer &buffer,
+                           CorrespondenceSetPixelWise &correspondence) {
+    for (int v_s = 0; v_s < height; v_s++) {
+        buffer.row_offset_[v_s + 1] += buffer.row_offset_[v_s];
     }
-    return std::make_tuple(correspondence_map, depth_buffer);
-}
+    correspondence.resize(buffer.row_offset_[height]);
 
-inline void AddElementToCorrespondenceMap(geometry::Image &correspondence_map,
-                                          geometry::Image &depth_buffer,
-                                          int u_s,
-                                          int v_s,
-                                          int u_t,
-                                          int v_t,
-                                          float transformed_d_t) {
-    int exist_u_t, exist_v_t;
-    double exist_d_t;
-    exist_u_t = *correspondence_map.PointerAt<int>(u_s, v_s, 0);
-    exist_v_t = *correspondence_map.PointerAt<int>(u_s, v_s, 1);
-    if (exist_u_t != -1 && exist_v_t != -1) {
-        exist_d_t = *depth_buffer.PointerAt<float>(u_s, v_s);
-        if (transformed_d_t <
-            exist_d_t) {  // update nearer point as correspondence
-            *correspondence_map.PointerAt<int>(u_s, v_s, 0) = u_t;
-            *correspondence_map.PointerAt<int>(u_s, v_s, 1) = v_t;
-            *depth_buffer.PointerAt<float>(u_s, v_s) = transformed_d_t;
-        }
-    } else {  // register correspondence
-        *correspondence_map.PointerAt<int>(u_s, v_s, 0) = u_t;
-        *correspondence_map.PointerAt<int>(u_s, v_s, 1) = v_t;
-        *depth_buffer.PointerAt<float>(u_s, v_s) = transformed_d_t;
-    }
-}
-
-void MergeCorrespondenceMaps(geometry::Image &correspondence_map,
-                             geometry::Image &depth_buffer,
-                             geometry::Image &correspondence_map_part,
-                             geometry::Image &depth_buffer_part) {
-    for (int v_s = 0; v_s < correspondence_map.height_; v_s++) {
-        for (int u_s = 0; u_s < correspondence_map.width_; u_s++) {
-            int u_t = *correspondence_map_part.PointerAt<int>(u_s, v_s, 0);
-            int v_t = *correspondence_map_part.PointerAt<int>(u_s, v_s, 1);
-            if (u_t != -1 && v_t != -1) {
-                float transformed_d_t =
-                        *depth_buffer_part.PointerAt<float>(u_s, v_s);
-                AddElementToCorrespondenceMap(correspondence_map, depth_buffer,
-                                              u_s, v_s, u_t, v_t,
-                                              transformed_d_t);
-            }
-        }
-    }
-}
-
-int CountCorrespondence(const geometry::Image &correspondence_map) {
-    int correspondence_count = 0;
-    for (int v_s = 0; v_s < correspondence_map.height_; v_s++) {
-        for (int u_s = 0; u_s < correspondence_map.width_; u_s++) {
-            int u_t = *correspondence_map.PointerAt<int>(u_s, v_s, 0);
-            int v_t = *correspondence_map.PointerAt<int>(u_s, v_s, 1);
-            if (u_t != -1 && v_t != -1) {
-                correspondence_count++;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v_s = 0; v_s < height; v_s++) {
+        const int *target_index_row = buffer.target_index_.data() + v_s * width;
+        int cnt = buffer.row_offset_[v_s];
+        for (int u_s = 0; u_s < width; u_s++) {
+            const int index_t = target_index_row[u_s];
+            if (index_t != -1) {
+                correspondence[cnt++] =
+                        Eigen::Vector4i(u_s, v_s, index_t % target_width,
+                                        index_t / target_width);
             }
         }
     }
-    return correspondence_count;
 }
 
-std::shared_ptr<CorrespondenceSetPixelWise> ComputeCorrespondence(
-        const Eigen::Matrix3d intrinsic_matrix,
-        const Eigen::Matrix4d &extrinsic,
-        const geometry::Image &depth_s,
-        const geometry::Image &depth_t,
-        const OdometryOption &option) {
+/// Finds the target pixel of every source pixel with a valid depth, in two
+/// parallel passes. The first pass finds the target pixels and counts them
+/// per row, and the second pass writes them at the row offsets. Each source
+/// pixel has at most one target pixel, so the passes need no locking and
+/// the correspondences are in row-major order of the source pixels.
+void ComputeCorrespondence(const Eigen::Matrix3d intrinsic_matrix,
+                           const Eigen::Matrix4d &extrinsic,
+                           const geometry::Image &depth_s,
+                           const geometry::Image &depth_t,
+                           const OdometryOption &option,
+                           CorrespondenceBuffer &buffer,
+                           CorrespondenceSetPixelWise &correspondence) {
     const Eigen::Matrix3d K = intrinsic_matrix;
     const Eigen::Matrix3d K_inv = K.inverse();
     const Eigen::Matrix3d R = extrinsic.block<3, 3>(0, 0);
     const Eigen::Matrix3d KRK_inv = K * R * K_inv;
     Eigen::Vector3d Kt = K * extrinsic.block<3, 1>(0, 3);
 
-    std::shared_ptr<geometry::Image> correspondence_map;
-    std::shared_ptr<geometry::Image> depth_buffer;
-    std::tie(correspondence_map, depth_buffer) =
-            InitializeCorrespondenceMap(depth_t.width_, depth_t.height_);
+    const int width = depth_s.width_;
+    const int height = depth_s.height_;
+    buffer.target_index_.resize((size_t)width * height);
+    buffer.row_offset_.resize(height + 1);
+    buffer.row_offset_[0] = 0;
+    const float *depth_t_data = depth_t.PointerAt<float>(0, 0);
 
 #ifdef _OPENMP
-#pragma omp parallel
-    {
-#endif
-        std::shared_ptr<geometry::Image> correspondence_map_private;
-        std::shared_ptr<geometry::Image> depth_buffer_private;
-        std::tie(correspondence_map_private, depth_buffer_private) =
-                InitializeCorrespondenceMap(depth_t.width_, depth_t.height_);
-#ifdef _OPENMP
-#pragma omp for nowait
+#pragma omp parallel for schedule(static)
 #endif
-        for (int v_s = 0; v_s < depth_s.height_; v_s++) {
-            for (int u_s = 0; u_s < depth_s.width_; u_s++) {
-                double d_s = *depth_s.PointerAt<float>(u_s, v_s);
-                if (!std::isnan(d_s)) {
-                    Eigen::Vector3d uv_in_s =
-                            d_s * KRK_inv * Eigen::Vector3d(u_s, v_s, 1.0) + Kt;
-                    double transformed_d_s = uv_in_s(2);
-                    int u_t = (int)(uv_in_s(0) / transformed_d_s + 0.5);
-                    int v_t = (int)(uv_in_s(1) / transformed_d_s + 0.5);
-                    if (u_t >= 0 && u_t < depth_t.width_ && v_t >= 0 &&
-                        v_t < depth_t.height_) {
-                        double d_t = *depth_t.PointerAt<float>(u_t, v_t);
-                        if (!std::isnan(d_t) &&
-                            std::abs(transformed_d_s - d_t) <=
-                                    option.max_depth_diff_) {
-                            AddElementToCorrespondenceMap(
-                                    *correspondence_map_private,
-                                    *depth_buffer_private, u_s, v_s, u_t, v_t,
-                                    (float)d_s);
-                        }
+    for (int v_s = 0; v_s < height; v_s++) {
+        const float *depth_s_row = depth_s.PointerAt<float>(0, v_s);
+        int *target_index_row = buffer.target_index_.data() + v_s * width;
+        int row_count = 0;
+        for (int u_s = 0; u_s < width; u_s++) {
+            target_index_row[u_s] = -1;
+            double d_s = depth_s_row[u_s];
+            if (!std::isnan(d_s)) {
+                Eigen::Vector3d uv_in_s =
+                        d_s * KRK_inv * Eigen::Vector3d(u_s, v_s, 1.0) + Kt;
+                double transformed_d_s = uv_in_s(2);
+                int u_t = (int)(uv_in_s(0) / transformed_d_s + 0.5);
+                int v_t = (int)(uv_in_s(1) / transformed_d_s + 0.5);
+                if (u_t >= 0 && u_t < depth_t.width_ && v_t >= 0 &&
+                    v_t < depth_t.height_) {
+                    const int index_t = v_t * depth_t.width_ + u_t;
+                    double d_t = depth_t_data[index_t];
+                    if (!std::isnan(d_t) &&
+                        std::abs(transformed_d_s - d_t) <=
+                                option.max_depth_diff_) {
+                        target_index_row[u_s] = index_t;
+                        row_count++;
                     }
                 }
             }
         }
+        buffer.row_offset_[v_s + 1] = row_count;
+    }
+    CompactCorrespondence(width, height, depth_t.width_, buffer,
+                          correspondence);
+}
+
+/// Finds the target pixel of every source vertex with projective data
+/// association: the transformed vertex is projected into the target maps,
+/// and it is kept if it is within max_depth_diff_ of the target plane there
+/// and the target normal is within 30 degrees of its normal.
+void ComputeProjectiveCorrespondence(
+        const Eigen::Matrix3d intrinsic_matrix,
+        const Eigen::Matrix4d &extrinsic,
+        const geometry::Image &xyz_s,
+        const geometry::Image &normal_map_s,
+        const geometry::Image &vertex_map_t,
+        const geometry::Image &normal_map_t,
+        const OdometryOption &option,
+        CorrespondenceBuffer &buffer,
+        CorrespondenceSetPixelWise &correspondence) {
+    const Eigen::Matrix3d R = extrinsic.block<3, 3>(0, 0);
+    const Eigen::Vector3d t = extrinsic.block<3, 1>(0, 3);
+    const double fx = intrinsic_matrix(0, 0), fy = intrinsic_matrix(1, 1);
+    const double cx = intrinsic_matrix(0, 2), cy = intrinsic_matrix(1, 2);
+    const double min_normal_cos = std::cos(30.0 / 180.0 * M_PI);
+
+    const int width = xyz_s.width_;
+    const int height = xyz_s.height_;
+    const int width_t = vertex_map_t.width_;
+    const int height_t = vertex_map_t.height_;
+    buffer.target_index_.resize((size_t)width * height);
+    buffer.row_offset_.resize(height + 1);
+    buffer.row_offset_[0] = 0;
+    const float *vertex_t_data = vertex_map_t.PointerAt<float>(0, 0, 0);
+    const float *normal_t_data = normal_map_t.PointerAt<float>(0, 0, 0);
+
 #ifdef _OPENMP
-#pragma omp critical
-        {
-#endif
-            MergeCorrespondenceMaps(*correspondence_map, *depth_buffer,
-                                    *correspondence_map_private,
-                                    *depth_buffer_private);
-#ifdef _OPENMP
-        }  //    omp critical
-    }      //    omp parallel
+#pragma omp parallel for schedule(static)
 #endif
-
-    auto correspondence = std::make_shared<CorrespondenceSetPixelWise>();
-    int correspondence_count = CountCorrespondence(*correspondence_map);
-    correspondence->resize(correspondence_count);
-    int cnt = 0;
-    for (int v_s = 0; v_s < correspondence_map->height_; v_s++) {
-        for (int u_s = 0; u_s < correspondence_map->width_; u_s++) {
-            int u_t = *correspondence_map->PointerAt<int>(u_s, v_s, 0);
-            int v_t = *correspondence_map->PointerAt<int>(u_s, v_s, 1);
-            if (u_t != -1 && v_t != -1) {
-                Eigen::Vector4i pixel_correspondence(u_s, v_s, u_t, v_t);
-                (*correspondence)[cnt] = pixel_correspondence;
-                cnt++;
+    for (int v_s = 0; v_s < height; v_s++) {
+        const float *xyz_s_row = xyz_s.PointerAt<float>(0, v_s, 0);
+        const float *normal_s_row = normal_map_s.PointerAt<float>(0, v_s, 0);
+        int *target_index_row = buffer.target_index_.data() + v_s * width;
+        int row_count = 0;
+        for (int u_s = 0; u_s < width; u_s++) {
+            target_index_row[u_s] = -1;
+            const float *ps = xyz_s_row + 3 * u_s;
+            const float *ns = normal_s_row + 3 * u_s;
+            if (std::isnan(ps[2]) || std::isnan(ns[2])) continue;
+            const Eigen::Vector3d p =
+                    R * Eigen::Vector3d(ps[0], ps[1], ps[2]) + t;
+            if (p(2) <= 0.0) continue;
+            int u_t = (int)(fx * p(0) / p(2) + cx + 0.5);
+            int v_t = (int)(fy * p(1) / p(2) + cy + 0.5);
+            if (u_t < 0 || u_t >= width_t || v_t < 0 || v_t >= height_t) {
+                continue;
+            }
+            const int index_t = v_t * width_t + u_t;
+            const float *pt = vertex_t_data + 3 * index_t;
+            const float *nt = normal_t_data + 3 * index_t;
+            if (std::isnan(pt[2]) || std::isnan(nt[2])) continue;
+            const Eigen::Vector3d normal_t(nt[0], nt[1], nt[2]);
+            if (std::abs((p - Eigen::Vector3d(pt[0], pt[1], pt[2]))
+                                 .dot(normal_t)) <= option.max_depth_diff_ &&
+                (R * Eigen::Vector3d(ns[0], ns[1], ns[2])).dot(normal_t) >=
+                        min_normal_cos) {
+                target_index_row[u_s] = index_t;
+                row_count++;
             }
         }
+        buffer.row_offset_[v_s + 1] = row_count;
     }
-    return correspondence;
+    CompactCorrespondence(width, height, width_t, buffer, correspondence);
 }
 
 std::shared_ptr<geometry::Image> ConvertDepthImageToXYZImage(
@@ -241,19 +252,11 @@ std::vector<Eigen::Matrix3d> CreateCameraMatrixPyramid(
     return pyramid_camera_matrix;
 }
 
-Eigen::Matrix6d CreateInformationMatrix(
-        const Eigen::Matrix4d &extrinsic,
-        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic,
-        const geometry::Image &depth_s,
-        const geometry::Image &depth_t,
-        const OdometryOption &option) {
-    auto correspondence =
-            ComputeCorrespondence(pinhole_camera_intrinsic.intrinsic_matrix_,
-                                  extrinsic, depth_s, depth_t, option);
-
-    auto xyz_t = ConvertDepthImageToXYZImage(
-            depth_t, pinhole_camera_intrinsic.intrinsic_matrix_);
-
+/// Returns the information matrix of the correspondences, from the target
+/// vertex map xyz_t.
+Eigen::Matrix6d ComputeInformationMatrix(
+        const CorrespondenceSetPixelWise &correspondence,
+        const geometry::Image &xyz_t) {
     // write q^*
     // see http://redwood-data.org/indoor/registration.html
     // note: I comes first and q_skew is scaled by factor 2.
@@ -267,12 +270,12 @@ Eigen::Matrix6d CreateInformationMatrix(
 #ifdef _OPENMP
 #pragma omp for nowait
 #endif
-        for (int row = 0; row < int(correspondence->size()); row++) {
-            int u_t = (*correspondence)[row](2);
-            int v_t = (*correspondence)[row](3);
-            double x = *xyz_t->PointerAt<float>(u_t, v_t, 0);
-            double y = *xyz_t->PointerAt<float>(u_t, v_t, 1);
-            double z = *xyz_t->PointerAt<float>(u_t, v_t, 2);
+        for (int row = 0; row < int(correspondence.size()); row++) {
+            int u_t = correspondence[row](2);
+            int v_t = correspondence[row](3);
+            double x = *xyz_t.PointerAt<float>(u_t, v_t, 0);
+            double y = *xyz_t.PointerAt<float>(u_t, v_t, 1);
+            double z = *xyz_t.PointerAt<float>(u_t, v_t, 2);
             G_r_private.setZero();
             G_r_private(1) = z;
             G_r_private(2) = -y;
@@ -299,13 +302,31 @@ Eigen::Matrix6d CreateInformationMatrix(
     return GTG;
 }
 
-void NormalizeIntensity(geometry::Image &image_s,
-                        geometry::Image &image_t,
-                        CorrespondenceSetPixelWise &correspondence) {
+Eigen::Matrix6d CreateInformationMatrix(
+        const Eigen::Matrix4d &extrinsic,
+        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic,
+        const geometry::Image &depth_s,
+        const geometry::Image &depth_t,
+        const geometry::Image &xyz_t,
+        const OdometryOption &option) {
+    CorrespondenceBuffer buffer;
+    CorrespondenceSetPixelWise correspondence;
+    ComputeCorrespondence(pinhole_camera_intrinsic.intrinsic_matrix_,
+                          extrinsic, depth_s, depth_t, option, buffer,
+                          correspondence);
+    return ComputeInformationMatrix(correspondence, xyz_t);
+}
+
+/// Returns the scales that bring the mean intensities of the corresponding
+/// pixels of both images to 0.5.
+std::tuple<double, double> ComputeIntensityScales(
+        const geometry::Image &image_s,
+        const geometry::Image &image_t,
+        const CorrespondenceSetPixelWise &correspondence) {
     if (image_s.width_ != image_t.width_ ||
         image_s.height_ != image_t.height_) {
         utility::LogError(
-                "[NormalizeIntensity] Size of two input images should be "
+                "[ComputeIntensityScales] Size of two input images should be "
                 "same");
     }
     double mean_s = 0.0, mean_t = 0.0;
@@ -319,8 +340,7 @@ void NormalizeIntensity(geometry::Image &image_s,
     }
     mean_s /= (double)correspondence.size();
     mean_t /= (double)correspondence.size();
-    image_s.LinearTransform(0.5 / mean_s, 0.0);
-    image_t.LinearTransform(0.5 / mean_t, 0.0);
+    return std::make_tuple(0.5 / mean_s, 0.5 / mean_t);
 }
 
 inline std::shared_ptr<geometry::RGBDImage> PackRGBDImage(
@@ -329,6 +349,14 @@ inline std::shared_ptr<geometry::RGBDImage> PackRGBDImage(
             geometry::RGBDImage(color, depth));
 }
 
+/// Packs a copy of image whose intensity is multiplied by scale.
+inline std::shared_ptr<geometry::RGBDImage> PackScaledRGBDImage(
+        const geometry::RGBDImage &image, double scale) {
+    auto image_scaled = PackRGBDImage(image.color_, image.depth_);
+    image_scaled->color_.LinearTransform(scale, 0.0);
+    return image_scaled;
+}
+
 std::shared_ptr<geometry::Image> PreprocessDepth(
         const geometry::Image &depth_orig, const OdometryOption &option) {
     std::shared_ptr<geometry::Image> depth_processed =
@@ -350,50 +378,43 @@ inline bool CheckImagePair(const geometry::Image &image_s,
             image_s.height_ == image_t.height_);
 }
 
+inline bool CheckRGBDImage(const geometry::RGBDImage &image) {
+    return (CheckImagePair(image.color_, image.depth_) &&
+            image.color_.num_of_channels_ == 1 &&
+            image.depth_.num_of_channels_ == 1 &&
+            image.color_.bytes_per_channel_ == 4 &&
+            image.depth_.bytes_per_channel_ == 4);
+}
+
 inline bool CheckRGBDImagePair(const geometry::RGBDImage &source,
                                const geometry::RGBDImage &target) {
-    return (CheckImagePair(source.color_, target.color_) &&
-            CheckImagePair(source.depth_, target.depth_) &&
-            CheckImagePair(source.color_, source.depth_) &&
-            CheckImagePair(target.color_, target.depth_) &&
-            CheckImagePair(source.color_, target.color_) &&
-            source.color_.num_of_channels_ == 1 &&
-            source.depth_.num_of_channels_ == 1 &&
-            target.color_.num_of_channels_ == 1 &&
-            target.depth_.num_of_channels_ == 1 &&
-            source.color_.bytes_per_channel_ == 4 &&
-            target.color_.bytes_per_channel_ == 4 &&
-            source.depth_.bytes_per_channel_ == 4 &&
-            target.depth_.bytes_per_channel_ == 4);
+    return (CheckRGBDImage(source) && CheckRGBDImage(target) &&
+            CheckImagePair(source.color_, target.color_));
 }
 
-std::tuple<std::shared_ptr<geometry::RGBDImage>,
-           std::shared_ptr<geometry::RGBDImage>>
-InitializeRGBDOdometry(
-        const geometry::RGBDImage &source,
-        const geometry::RGBDImage &target,
-        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic,
-        const Eigen::Matrix4d &odo_init,
-        const OdometryOption &option) {
-    auto source_gray =
-            source.color_.Filter(geometry::Image::FilterType::Gaussian3);
-    auto target_gray =
-            target.color_.Filter(geometry::Image::FilterType::Gaussian3);
-    auto source_depth_preprocessed = PreprocessDepth(source.depth_, option);
-    auto target_depth_preprocessed = PreprocessDepth(target.depth_, option);
-    auto source_depth = source_depth_preprocessed->Filter(
-            geometry::Image::FilterType::Gaussian3);
-    auto target_depth = target_depth_preprocessed->Filter(
+/// Smooths the intensity and the preprocessed depth of image, and returns
+/// their pyramid.
+geometry::RGBDImagePyramid CreateOdometryPyramid(
+        const geometry::RGBDImage &image, const OdometryOption &option) {
+    auto gray = image.color_.Filter(geometry::Image::FilterType::Gaussian3);
+    auto depth_preprocessed = PreprocessDepth(image.depth_, option);
+    auto depth = depth_preprocessed->Filter(
             geometry::Image::FilterType::Gaussian3);
+    return PackRGBDImage(*gray, *depth)->CreatePyramid(
+            option.iteration_number_per_pyramid_level_.size());
+}
 
-    auto correspondence = ComputeCorrespondence(
-            pinhole_camera_intrinsic.intrinsic_matrix_, odo_init, *source_depth,
-            *target_depth, option);
-    NormalizeIntensity(*source_gray, *target_gray, *correspondence);
-
-    auto source_out = PackRGBDImage(*source_gray, *source_depth);
-    auto target_out = PackRGBDImage(*target_gray, *target_depth);
-    return std::make_tuple(source_out, target_out);
+/// Returns the vertex map of every level of pyramid.
+geometry::ImagePyramid CreateXYZPyramid(
+        const geometry::RGBDImagePyramid &pyramid,
+        const std::vector<Eigen::Matrix3d> &pyramid_camera_matrix) {
+    geometry::ImagePyramid xyz_pyramid;
+    xyz_pyramid.reserve(pyramid.size());
+    for (size_t level = 0; level < pyramid.size(); level++) {
+        xyz_pyramid.push_back(ConvertDepthImageToXYZImage(
+                pyramid[level]->depth_, pyramid_camera_matrix[level]));
+    }
+    return xyz_pyramid;
 }
 
 std::tuple<bool, Eigen::Matrix4d> DoSingleIteration(
@@ -407,10 +428,12 @@ std::tuple<bool, Eigen::Matrix4d> DoSingleIteration(
         const Eigen::Matrix3d intrinsic,
         const Eigen::Matrix4d &extrinsic_initial,
         const RGBDOdometryJacobian &jacobian_method,
-        const OdometryOption &option) {
-    auto correspondence = ComputeCorrespondence(
-            intrinsic, extrinsic_initial, source.depth_, target.depth_, option);
-    int corresps_count = (int)correspondence->size();
+        const OdometryOption &option,
+        CorrespondenceBuffer &buffer,
+        CorrespondenceSetPixelWise &correspondence) {
+    ComputeCorrespondence(intrinsic, extrinsic_initial, source.depth_,
+                          target.depth_, option, buffer, correspondence);
+    int corresps_count = (int)correspondence.size();
 
     auto f_lambda =
             [&](int i,
@@ -419,7 +442,7 @@ std::tuple<bool, Eigen::Matrix4d> DoSingleIteration(
                 jacobian_method.ComputeJacobianAndResidual(
                         i, J_r, r, source, target, source_xyz, target_dx,
                         target_dy, intrinsic, extrinsic_initial,
-                        *correspondence);
+                        correspondence);
             };
     utility::LogDebug("Iter : {:d}, Level : {:d}, ", iter, level);
     Eigen::Matrix6d JTJ;
@@ -442,52 +465,50 @@ std::tuple<bool, Eigen::Matrix4d> DoSingleIteration(
 }
 
 std::tuple<bool, Eigen::Matrix4d> ComputeMultiscale(
-        const geometry::RGBDImage &source,
-        const geometry::RGBDImage &target,
-        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic,
+        const geometry::RGBDImagePyramid &source_pyramid,
+        const geometry::ImagePyramid &source_xyz_pyramid,
+        const geometry::RGBDImagePyramid &target_pyramid,
+        const geometry::RGBDImagePyramid &target_pyramid_dx,
+        const geometry::RGBDImagePyramid &target_pyramid_dy,
+        double scale_s,
+        double scale_t,
+        const std::vector<Eigen::Matrix3d> &pyramid_camera_matrix,
         const Eigen::Matrix4d &extrinsic_initial,
         const RGBDOdometryJacobian &jacobian_method,
         const OdometryOption &option) {
     std::vector<int> iter_counts = option.iteration_number_per_pyramid_level_;
     int num_levels = (int)iter_counts.size();
 
-    auto source_pyramid = source.CreatePyramid(num_levels);
-    auto target_pyramid = target.CreatePyramid(num_levels);
-    auto target_pyramid_dx = geometry::RGBDImage::FilterPyramid(
-            target_pyramid, geometry::Image::FilterType::Sobel3Dx);
-    auto target_pyramid_dy = geometry::RGBDImage::FilterPyramid(
-            target_pyramid, geometry::Image::FilterType::Sobel3Dy);
-
     Eigen::Matrix4d result_odo = extrinsic_initial.isZero()
                                          ? Eigen::Matrix4d::Identity()
                                          : extrinsic_initial;
 
-    std::vector<Eigen::Matrix3d> pyramid_camera_matrix =
-            CreateCameraMatrixPyramid(pinhole_camera_intrinsic,
-                                      (int)iter_counts.size());
-
+    // The correspondence search reuses the same buffers at every iteration.
+    CorrespondenceBuffer buffer;
+    CorrespondenceSetPixelWise correspondence;
     for (int level = num_levels - 1; level >= 0; level--) {
         const Eigen::Matrix3d level_camera_matrix =
                 pyramid_camera_matrix[level];
 
-        auto source_xyz_level = ConvertDepthImageToXYZImage(
-                source_pyramid[level]->depth_, level_camera_matrix);
-        auto source_level = PackRGBDImage(source_pyramid[level]->color_,
-                                          source_pyramid[level]->depth_);
-        auto target_level = PackRGBDImage(target_pyramid[level]->color_,
-                                          target_pyramid[level]->depth_);
-        auto target_dx_level = PackRGBDImage(target_pyramid_dx[level]->color_,
-                                             target_pyramid_dx[level]->depth_);
-        auto target_dy_level = PackRGBDImage(target_pyramid_dy[level]->color_,
-                                             target_pyramid_dy[level]->depth_);
+        // The intensities are normalized on the level copies, so that the
+        // pyramids of a frame serve every pair the frame is part of.
+        auto source_level =
+                PackScaledRGBDImage(*source_pyramid[level], scale_s);
+        auto target_level =
+                PackScaledRGBDImage(*target_pyramid[level], scale_t);
+        auto target_dx_level =
+                PackScaledRGBDImage(*target_pyramid_dx[level], scale_t);
+        auto target_dy_level =
+                PackScaledRGBDImage(*target_pyramid_dy[level], scale_t);
 
         for (int iter = 0; iter < iter_counts[num_levels - level - 1]; iter++) {
             Eigen::Matrix4d curr_odo;
             bool is_success;
             std::tie(is_success, curr_odo) = DoSingleIteration(
                     iter, level, *source_level, *target_level,
-                    *source_xyz_level, *target_dx_level, *target_dy_level,
-                    level_camera_matrix, result_odo, jacobian_method, option);
+                    *source_xyz_pyramid[level], *target_dx_level,
+                    *target_dy_level, level_camera_matrix, result_odo,
+                    jacobian_method, option, buffer, correspondence);
             result_odo = curr_odo * result_odo;
 
             if (!is_success) {
@@ -499,6 +520,208 @@ std::tuple<bool, Eigen::Matrix4d> ComputeMultiscale(
     return std::make_tuple(true, result_odo);
 }
 
+/// Estimates the odometry between two preprocessed RGB-D images.
+std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d>
+ComputeRGBDOdometryFromPyramids(
+        const geometry::RGBDImagePyramid &source_pyramid,
+        const geometry::ImagePyramid &source_xyz_pyramid,
+        const geometry::RGBDImagePyramid &target_pyramid,
+        const geometry::Image &target_xyz,
+        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic,
+        const Eigen::Matrix4d &odo_init,
+        const RGBDOdometryJacobian &jacobian_method,
+        const OdometryOption &option) {
+    const geometry::RGBDImage &source_processed = *source_pyramid[0];
+    const geometry::RGBDImage &target_processed = *target_pyramid[0];
+    CorrespondenceBuffer buffer;
+    CorrespondenceSetPixelWise correspondence;
+    ComputeCorrespondence(pinhole_camera_intrinsic.intrinsic_matrix_, odo_init,
+                          source_processed.depth_, target_processed.depth_,
+                          option, buffer, correspondence);
+    double scale_s, scale_t;
+    std::tie(scale_s, scale_t) =
+            ComputeIntensityScales(source_processed.color_,
+                                   target_processed.color_, correspondence);
+
+    auto target_pyramid_dx = geometry::RGBDImage::FilterPyramid(
+            target_pyramid, geometry::Image::FilterType::Sobel3Dx);
+    auto target_pyramid_dy = geometry::RGBDImage::FilterPyramid(
+            target_pyramid, geometry::Image::FilterType::Sobel3Dy);
+    std::vector<Eigen::Matrix3d> pyramid_camera_matrix =
+            CreateCameraMatrixPyramid(pinhole_camera_intrinsic,
+                                      (int)source_pyramid.size());
+
+    Eigen::Matrix4d extrinsic;
+    bool is_success;
+    std::tie(is_success, extrinsic) = ComputeMultiscale(
+            source_pyramid, source_xyz_pyramid, target_pyramid,
+            target_pyramid_dx, target_pyramid_dy, scale_s, scale_t,
+            pyramid_camera_matrix, odo_init, jacobian_method, option);
+
+    if (is_success) {
+        Eigen::Matrix4d trans_output = extrinsic;
+        Eigen::MatrixXd info_output = CreateInformationMatrix(
+                extrinsic, pinhole_camera_intrinsic, source_processed.depth_,
+                target_processed.depth_, target_xyz, option);
+        return std::make_tuple(true, trans_output, info_output);
+    } else {
+        return std::make_tuple(false, Eigen::Matrix4d::Identity(),
+                               Eigen::Matrix6d::Identity());
+    }
+}
+
+/// Returns a copy of image with every second pixel of every second row.
+std::shared_ptr<geometry::Image> SubsampleImage(const geometry::Image &image) {
+    auto output = std::make_shared<geometry::Image>();
+    output->Prepare(image.width_ / 2, image.height_ / 2,
+                    image.num_of_channels_, image.bytes_per_channel_);
+    const int bytes_per_pixel =
+            image.num_of_channels_ * image.bytes_per_channel_;
+    for (int v = 0; v < output->height_; v++) {
+        const uint8_t *src = image.data_.data() + 2 * v * image.BytesPerLine();
+        uint8_t *dst = output->data_.data() + v * output->BytesPerLine();
+        for (int u = 0; u < output->width_; u++) {
+            memcpy(dst + u * bytes_per_pixel, src + 2 * u * bytes_per_pixel,
+                   bytes_per_pixel);
+        }
+    }
+    return output;
+}
+
+/// Returns the normals of a vertex map from the differences to the next
+/// pixels, facing the camera, or NaN where a vertex is missing.
+std::shared_ptr<geometry::Image> ComputeNormalMap(const geometry::Image &xyz) {
+    auto normal_map = std::make_shared<geometry::Image>();
+    normal_map->Prepare(xyz.width_, xyz.height_, 3, 4);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < xyz.height_; v++) {
+        for (int u = 0; u < xyz.width_; u++) {
+            float *n = normal_map->PointerAt<float>(u, v, 0);
+            n[0] = n[1] = n[2] = std::numeric_limits<float>::quiet_NaN();
+            if (u + 1 == xyz.width_ || v + 1 == xyz.height_) continue;
+            const float *p0 = xyz.PointerAt<float>(u, v, 0);
+            const float *pu = xyz.PointerAt<float>(u + 1, v, 0);
+            const float *pv = xyz.PointerAt<float>(u, v + 1, 0);
+            if (std::isnan(p0[2]) || std::isnan(pu[2]) || std::isnan(pv[2])) {
+                continue;
+            }
+            const Eigen::Vector3d p(p0[0], p0[1], p0[2]);
+            Eigen::Vector3d normal =
+                    (Eigen::Vector3d(pu[0], pu[1], pu[2]) - p)
+                            .cross(Eigen::Vector3d(pv[0], pv[1], pv[2]) - p);
+            const double norm = normal.norm();
+            if (norm == 0.0) continue;
+            normal /= normal.dot(p) > 0.0 ? -norm : norm;
+            n[0] = (float)normal(0);
+            n[1] = (float)normal(1);
+            n[2] = (float)normal(2);
+        }
+    }
+    return normal_map;
+}
+
+/// Returns the vertex map of the preprocessed depth, and the subsampled
+/// vertex maps of the coarser levels. Unlike averaged depth, the subsampled
+/// vertices stay on the surface and at the pixels of the level cameras.
+geometry::ImagePyramid CreateDepthXYZPyramid(
+        const geometry::Image &depth,
+        const std::vector<Eigen::Matrix3d> &pyramid_camera_matrix,
+        const OdometryOption &option) {
+    geometry::ImagePyramid xyz_pyramid;
+    xyz_pyramid.reserve(pyramid_camera_matrix.size());
+    xyz_pyramid.push_back(ConvertDepthImageToXYZImage(
+            *PreprocessDepth(depth, option), pyramid_camera_matrix[0]));
+    for (size_t level = 1; level < pyramid_camera_matrix.size(); level++) {
+        xyz_pyramid.push_back(SubsampleImage(*xyz_pyramid[level - 1]));
+    }
+    return xyz_pyramid;
+}
+
+/// Point to plane ICP from the source vertex maps to the target vertex and
+/// normal maps, from the coarsest level to the finest.
+std::tuple<bool, Eigen::Matrix4d> ComputeProjectiveICPMultiscale(
+        const geometry::ImagePyramid &source_xyz_pyramid,
+        const geometry::ImagePyramid &source_normal_pyramid,
+        const std::vector<const geometry::Image *> &target_vertex_pyramid,
+        const std::vector<const geometry::Image *> &target_normal_pyramid,
+        const std::vector<Eigen::Matrix3d> &pyramid_camera_matrix,
+        const Eigen::Matrix4d &extrinsic_initial,
+        const OdometryOption &option) {
+    std::vector<int> iter_counts = option.iteration_number_per_pyramid_level_;
+    int num_levels = (int)iter_counts.size();
+
+    Eigen::Matrix4d result_odo = extrinsic_initial.isZero()
+                                         ? Eigen::Matrix4d::Identity()
+                                         : extrinsic_initial;
+
+    CorrespondenceBuffer buffer;
+    CorrespondenceSetPixelWise correspondence;
+    for (int level = num_levels - 1; level >= 0; level--) {
+        const geometry::Image &xyz_s = *source_xyz_pyramid[level];
+        const geometry::Image &normal_map_s = *source_normal_pyramid[level];
+        const geometry::Image &vertex_map_t = *target_vertex_pyramid[level];
+        const geometry::Image &normal_map_t = *target_normal_pyramid[level];
+        for (int iter = 0; iter < iter_counts[num_levels - level - 1]; iter++) {
+            ComputeProjectiveCorrespondence(
+                    pyramid_camera_matrix[level], result_odo, xyz_s,
+                    normal_map_s, vertex_map_t, normal_map_t, option, buffer,
+                    correspondence);
+            if (correspondence.size() < 6) {
+                utility::LogWarning(
+                        "[ComputeProjectiveICPOdometry] too few "
+                        "correspondences!");
+                return std::make_tuple(false, Eigen::Matrix4d::Identity());
+            }
+
+            const Eigen::Matrix3d R = result_odo.block<3, 3>(0, 0);
+            const Eigen::Vector3d t = result_odo.block<3, 1>(0, 3);
+            auto compute_jacobian_and_residual =
+                    [&](int i, utility::JTJandJTrAccumulator &sum) {
+                        const Eigen::Vector4i &c = correspondence[i];
+                        const float *ps = xyz_s.PointerAt<float>(c(0), c(1), 0);
+                        const float *pt =
+                                vertex_map_t.PointerAt<float>(c(2), c(3), 0);
+                        const float *nt_data =
+                                normal_map_t.PointerAt<float>(c(2), c(3), 0);
+                        const Eigen::Vector3d vs =
+                                R * Eigen::Vector3d(ps[0], ps[1], ps[2]) + t;
+                        const Eigen::Vector3d vt(pt[0], pt[1], pt[2]);
+                        const Eigen::Vector3d nt(nt_data[0], nt_data[1],
+                                                 nt_data[2]);
+                        Eigen::Vector6d J_r;
+                        J_r.block<3, 1>(0, 0) = vs.cross(nt);
+                        J_r.block<3, 1>(3, 0) = nt;
+                        sum.AddRow(J_r, (vs - vt).dot(nt));
+                    };
+            Eigen::Matrix6d JTJ;
+            Eigen::Vector6d JTr;
+            double r2;
+            std::tie(JTJ, JTr, r2) = utility::ReduceJTJandJTr(
+                    compute_jacobian_and_residual, (int)correspondence.size(),
+                    false);
+            utility::LogDebug(
+                    "Iter : {:d}, Level : {:d}, Residual : {:.2e} (# of "
+                    "elements : {:d})",
+                    iter, level, r2 / (double)correspondence.size(),
+                    (int)correspondence.size());
+
+            bool is_success;
+            Eigen::Matrix4d extrinsic;
+            std::tie(is_success, extrinsic) =
+                    utility::SolveJacobianSystemAndObtainExtrinsicMatrix(JTJ,
+                                                                         JTr);
+            if (!is_success) {
+                utility::LogWarning("[ComputeOdometry] no solution!");
+                return std::make_tuple(false, Eigen::Matrix4d::Identity());
+            }
+            result_odo = extrinsic * result_odo;
+        }
+    }
+    return std::make_tuple(true, result_odo);
+}
+
 }  // unnamed namespace
 
 namespace odometry {
@@ -519,26 +742,156 @@ std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> ComputeRGBDOdometry(
                                Eigen::Matrix6d::Zero());
     }
 
-    std::shared_ptr<geometry::RGBDImage> source_processed, target_processed;
-    std::tie(source_processed, target_processed) = InitializeRGBDOdometry(
-            source, target, pinhole_camera_intrinsic, odo_init, option);
+    std::vector<Eigen::Matrix3d> pyramid_camera_matrix =
+            CreateCameraMatrixPyramid(
+                    pinhole_camera_intrinsic,
+                    (int)option.iteration_number_per_pyramid_level_.size());
+    auto source_pyramid = CreateOdometryPyramid(source, option);
+    auto source_xyz_pyramid =
+            CreateXYZPyramid(source_pyramid, pyramid_camera_matrix);
+    auto target_pyramid = CreateOdometryPyramid(target, option);
+    auto target_xyz = ConvertDepthImageToXYZImage(
+            target_pyramid[0]->depth_,
+            pinhole_camera_intrinsic.intrinsic_matrix_);
+    return ComputeRGBDOdometryFromPyramids(
+            source_pyramid, source_xyz_pyramid, target_pyramid, *target_xyz,
+            pinhole_camera_intrinsic, odo_init, jacobian_method, option);
+}
+
+std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> ComputeProjectiveICPOdometry(
+        const geometry::Image &source_depth,
+        const geometry::Image &target_vertex_map,
+        const geometry::Image &target_normal_map,
+        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic
+        /*= camera::PinholeCameraIntrinsic()*/,
+        const Eigen::Matrix4d &odo_init /*= Eigen::Matrix4d::Identity()*/,
+        const OdometryOption &option /*= OdometryOption()*/) {
+    if (source_depth.num_of_channels_ != 1 ||
+        source_depth.bytes_per_channel_ != 4 ||
+        target_vertex_map.num_of_channels_ != 3 ||
+        target_vertex_map.bytes_per_channel_ != 4 ||
+        target_normal_map.num_of_channels_ != 3 ||
+        target_normal_map.bytes_per_channel_ != 4) {
+        utility::LogWarning(
+                "[ComputeProjectiveICPOdometry] Unsupported image format.");
+        return std::make_tuple(false, Eigen::Matrix4d::Identity(),
+                               Eigen::Matrix6d::Zero());
+    }
+    if (!CheckImagePair(source_depth, target_vertex_map) ||
+        !CheckImagePair(source_depth, target_normal_map)) {
+        utility::LogWarning(
+                "[ComputeProjectiveICPOdometry] Depth image and model maps "
+                "should be same in size.");
+        return std::make_tuple(false, Eigen::Matrix4d::Identity(),
+                               Eigen::Matrix6d::Zero());
+    }
+
+    std::vector<Eigen::Matrix3d> pyramid_camera_matrix =
+            CreateCameraMatrixPyramid(
+                    pinhole_camera_intrinsic,
+                    (int)option.iteration_number_per_pyramid_level_.size());
+    auto source_xyz_pyramid =
+            CreateDepthXYZPyramid(source_depth, pyramid_camera_matrix, option);
+    geometry::ImagePyramid source_normal_pyramid;
+    for (const auto &xyz : source_xyz_pyramid) {
+        source_normal_pyramid.push_back(ComputeNormalMap(*xyz));
+    }
+
+    // The coarser model maps are subsampled as the source vertex maps are.
+    geometry::ImagePyramid target_subsampled;
+    std::vector<const geometry::Image *> target_vertex_pyramid(
+            1, &target_vertex_map);
+    std::vector<const geometry::Image *> target_normal_pyramid(
+            1, &target_normal_map);
+    for (size_t level = 1; level < pyramid_camera_matrix.size(); level++) {
+        target_subsampled.push_back(
+                SubsampleImage(*target_vertex_pyramid[level - 1]));
+        target_vertex_pyramid.push_back(target_subsampled.back().get());
+        target_subsampled.push_back(
+                SubsampleImage(*target_normal_pyramid[level - 1]));
+        target_normal_pyramid.push_back(target_subsampled.back().get());
+    }
 
     Eigen::Matrix4d extrinsic;
     bool is_success;
-    std::tie(is_success, extrinsic) = ComputeMultiscale(
-            *source_processed, *target_processed, pinhole_camera_intrinsic,
-            odo_init, jacobian_method, option);
-
-    if (is_success) {
-        Eigen::Matrix4d trans_output = extrinsic;
-        Eigen::MatrixXd info_output = CreateInformationMatrix(
-                extrinsic, pinhole_camera_intrinsic, source_processed->depth_,
-                target_processed->depth_, option);
-        return std::make_tuple(true, trans_output, info_output);
-    } else {
+    std::tie(is_success, extrinsic) = ComputeProjectiveICPMultiscale(
+            source_xyz_pyramid, source_normal_pyramid, target_vertex_pyramid,
+            target_normal_pyramid, pyramid_camera_matrix, odo_init, option);
+    if (!is_success) {
         return std::make_tuple(false, Eigen::Matrix4d::Identity(),
                                Eigen::Matrix6d::Identity());
     }
+
+    CorrespondenceBuffer buffer;
+    CorrespondenceSetPixelWise correspondence;
+    ComputeProjectiveCorrespondence(pinhole_camera_intrinsic.intrinsic_matrix_,
+                                    extrinsic, *source_xyz_pyramid[0],
+                                    *source_normal_pyramid[0],
+                                    target_vertex_map, target_normal_map,
+                                    option, buffer, correspondence);
+    return std::make_tuple(
+            true, extrinsic,
+            ComputeInformationMatrix(correspondence, target_vertex_map));
+}
+
+RGBDOdometryTracker::RGBDOdometryTracker(
+        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic
+        /*= camera::PinholeCameraIntrinsic()*/,
+        const OdometryOption &option /*= OdometryOption()*/)
+    : pinhole_camera_intrinsic_(pinhole_camera_intrinsic),
+      option_(option),
+      pyramid_camera_matrix_(CreateCameraMatrixPyramid(
+              pinhole_camera_intrinsic,
+              (int)option.iteration_number_per_pyramid_level_.size())) {}
+
+std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> RGBDOdometryTracker::Track(
+        const geometry::RGBDImage &frame,
+        const Eigen::Matrix4d &odo_init /*= Eigen::Matrix4d::Identity()*/,
+        const RGBDOdometryJacobian &jacobian_method
+        /*=RGBDOdometryJacobianFromHybridTerm*/) {
+    if (!CheckRGBDImage(frame)) {
+        utility::LogWarning("[RGBDOdometryTracker] Unsupported RGBD image.");
+        return std::make_tuple(false, Eigen::Matrix4d::Identity(),
+                               Eigen::Matrix6d::Zero());
+    }
+    if (!HasKeyframe()) {
+        SetKeyframe(frame);
+        return std::make_tuple(false, Eigen::Matrix4d::Identity(),
+                               Eigen::Matrix6d::Zero());
+    }
+    if (!CheckImagePair(keyframe_pyramid_[0]->color_, frame.color_)) {
+        utility::LogWarning(
+                "[RGBDOdometryTracker] Frames should be same in size.");
+        return std::make_tuple(false, Eigen::Matrix4d::Identity(),
+                               Eigen::Matrix6d::Zero());
+    }
+
+    auto frame_pyramid = CreateOdometryPyramid(frame, option_);
+    auto frame_xyz_pyramid =
+            CreateXYZPyramid(frame_pyramid, pyramid_camera_matrix_);
+    auto result = ComputeRGBDOdometryFromPyramids(
+            keyframe_pyramid_, keyframe_xyz_pyramid_, frame_pyramid,
+            *frame_xyz_pyramid[0], pinhole_camera_intrinsic_, odo_init,
+            jacobian_method, option_);
+    keyframe_pyramid_ = std::move(frame_pyramid);
+    keyframe_xyz_pyramid_ = std::move(frame_xyz_pyramid);
+    return result;
+}
+
+void RGBDOdometryTracker::SetKeyframe(const geometry::RGBDImage &frame) {
+    if (!CheckRGBDImage(frame)) {
+        utility::LogWarning("[RGBDOdometryTracker] Unsupported RGBD image.");
+        Reset();
+        return;
+    }
+    keyframe_pyramid_ = CreateOdometryPyramid(frame, option_);
+    keyframe_xyz_pyramid_ =
+            CreateXYZPyramid(keyframe_pyramid_, pyramid_camera_matrix_);
+}
+
+void RGBDOdometryTracker::Reset() {
+    keyframe_pyramid_.clear();
+    keyframe_xyz_pyramid_.clear();
 }
 
 }  // namespace odometry
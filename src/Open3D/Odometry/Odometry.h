@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/RGBDImage.h"
 #include "Open3D/Odometry/OdometryOption.h"
 #include "Open3D/Odometry/RGBDOdometryJacobian.h"
 #include "Open3D/Utility/Console.h"
@@ -39,10 +40,6 @@
 
 namespace open3d {
 
-namespace geometry {
-class RGBDImage;
-}
-
 namespace odometry {
 /// Function to estimate 6D odometry between two RGB-D images
 /// output: is_success, 4x4 motion matrix, 6x6 information matrix
@@ -56,5 +53,69 @@ std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> ComputeRGBDOdometry(
                 RGBDOdometryJacobianFromHybridTerm(),
         const OdometryOption &option = OdometryOption());
 
+/// Function to estimate 6D motion from a depth image to the vertex and
+/// normal maps of a model, e.g. rendered by raycasting a TSDF volume, by
+/// point to plane ICP with projective data association. The maps are 3
+/// channel float images in the target camera coordinates, with NaN where
+/// the model is missing, and of the same size as the depth image. A source
+/// vertex is matched to the model pixel it projects to, if it is within
+/// max_depth_diff_ of the model surface there and their normals are within
+/// 30 degrees.
+/// output: is_success, 4x4 motion matrix, 6x6 information matrix
+std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> ComputeProjectiveICPOdometry(
+        const geometry::Image &source_depth,
+        const geometry::Image &target_vertex_map,
+        const geometry::Image &target_normal_map,
+        const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic =
+                camera::PinholeCameraIntrinsic(),
+        const Eigen::Matrix4d &odo_init = Eigen::Matrix4d::Identity(),
+        const OdometryOption &option = OdometryOption());
+
+/// \class RGBDOdometryTracker
+///
+/// \brief Estimates the odometry between consecutive frames of an RGB-D
+/// stream.
+///
+/// Each frame is preprocessed once into its image and vertex map pyramids.
+/// The last frame is kept as the keyframe, the source of the next odometry.
+class RGBDOdometryTracker {
+public:
+    RGBDOdometryTracker(
+            const camera::PinholeCameraIntrinsic &pinhole_camera_intrinsic =
+                    camera::PinholeCameraIntrinsic(),
+            const OdometryOption &option = OdometryOption());
+    ~RGBDOdometryTracker() {}
+
+public:
+    /// Function to estimate 6D odometry from the keyframe to frame, as
+    /// ComputeRGBDOdometry(keyframe, frame) does. frame then becomes the
+    /// keyframe. Without a keyframe, frame only becomes the keyframe and the
+    /// estimation fails.
+    /// output: is_success, 4x4 motion matrix, 6x6 information matrix
+    std::tuple<bool, Eigen::Matrix4d, Eigen::Matrix6d> Track(
+            const geometry::RGBDImage &frame,
+            const Eigen::Matrix4d &odo_init = Eigen::Matrix4d::Identity(),
+            const RGBDOdometryJacobian &jacobian_method =
+                    RGBDOdometryJacobianFromHybridTerm());
+    /// Makes frame the keyframe without estimating odometry.
+    void SetKeyframe(const geometry::RGBDImage &frame);
+    /// Drops the keyframe.
+    void Reset();
+    bool HasKeyframe() const { return !keyframe_pyramid_.empty(); }
+    const camera::PinholeCameraIntrinsic &GetPinholeCameraIntrinsic() const {
+        return pinhole_camera_intrinsic_;
+    }
+    const OdometryOption &GetOption() const { return option_; }
+
+private:
+    camera::PinholeCameraIntrinsic pinhole_camera_intrinsic_;
+    OdometryOption option_;
+    std::vector<Eigen::Matrix3d> pyramid_camera_matrix_;
+    /// Smoothed intensity and preprocessed depth of the keyframe.
+    geometry::RGBDImagePyramid keyframe_pyramid_;
+    /// Vertex maps of the keyframe.
+    geometry::ImagePyramid keyframe_xyz_pyramid_;
+};
+
 }  // namespace odometry
 }  // namespace open3d
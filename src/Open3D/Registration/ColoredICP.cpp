@@ -155,21 +155,17 @@ Eigen::Matrix4d TransformationEstimationForColoredICP::ComputeTransformation(
     const auto &target_c = (const PointCloudForColoredICP &)target;
 
     auto compute_jacobian_and_residual =
-            [&](int i,
-                std::vector<Eigen::Vector6d, utility::Vector6d_allocator> &J_r,
-                std::vector<double> &r) {
+            [&](int i, utility::JTJandJTrAccumulator &sum) {
                 size_t cs = corres[i][0];
                 size_t ct = corres[i][1];
                 const Eigen::Vector3d &vs = source.points_[cs];
                 const Eigen::Vector3d &vt = target.points_[ct];
                 const Eigen::Vector3d &nt = target.normals_[ct];
 
-                J_r.resize(2);
-                r.resize(2);
-
-                J_r[0].block<3, 1>(0, 0) = sqrt_lambda_geometric * vs.cross(nt);
-                J_r[0].block<3, 1>(3, 0) = sqrt_lambda_geometric * nt;
-                r[0] = sqrt_lambda_geometric * (vs - vt).dot(nt);
+                Eigen::Vector6d J_r;
+                J_r.block<3, 1>(0, 0) = sqrt_lambda_geometric * vs.cross(nt);
+                J_r.block<3, 1>(3, 0) = sqrt_lambda_geometric * nt;
+                sum.AddRow(J_r, sqrt_lambda_geometric * (vs - vt).dot(nt));
 
                 // project vs into vt's tangential plane
                 Eigen::Vector3d vs_proj = vs - (vs - vt).dot(nt) * nt;
@@ -190,18 +186,17 @@ Eigen::Matrix4d TransformationEstimationForColoredICP::ComputeTransformation(
                                 .finished();
 
                 const Eigen::Vector3d &ditM = -dit.transpose() * M;
-                J_r[1].block<3, 1>(0, 0) =
+                J_r.block<3, 1>(0, 0) =
                         sqrt_lambda_photometric * vs.cross(ditM);
-                J_r[1].block<3, 1>(3, 0) = sqrt_lambda_photometric * ditM;
-                r[1] = sqrt_lambda_photometric * (is - is0_proj);
+                J_r.block<3, 1>(3, 0) = sqrt_lambda_photometric * ditM;
+                sum.AddRow(J_r, sqrt_lambda_photometric * (is - is0_proj));
             };
 
     Eigen::Matrix6d JTJ;
     Eigen::Vector6d JTr;
     double r2;
-    std::tie(JTJ, JTr, r2) =
-            utility::ComputeJTJandJTr<Eigen::Matrix6d, Eigen::Vector6d>(
-                    compute_jacobian_and_residual, (int)corres.size());
+    std::tie(JTJ, JTr, r2) = utility::ReduceJTJandJTr(
+            compute_jacobian_and_residual, (int)corres.size());
 
     bool is_success;
     Eigen::Matrix4d extrinsic;
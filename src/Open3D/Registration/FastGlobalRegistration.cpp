@@ -26,7 +26,9 @@
 
 #include "Open3D/Registration/FastGlobalRegistration.h"
 
-#include "Open3D/Geometry/KDTreeFlann.h"
+#include <algorithm>
+#include <random>
+
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Registration/Feature.h"
 #include "Open3D/Registration/Registration.h"
@@ -38,6 +40,12 @@ namespace open3d {
 namespace {
 using namespace registration;
 
+/// Number of tuple trials drawn from one generator in AdvancedMatching.
+const int kTupleTrialChunkSize = 1024;
+/// Number of trial chunks tested in parallel before checking whether enough
+/// tuples have been found.
+const int kTupleChunkBatchSize = 64;
+
 std::vector<std::pair<int, int>> AdvancedMatching(
         const std::vector<geometry::PointCloud>& point_cloud_vec,
         const std::vector<Feature>& features_vec,
@@ -57,115 +65,122 @@ std::vector<std::pair<int, int>> AdvancedMatching(
     // STEP 1) Initial matching
     int nPti = int(point_cloud_vec[fi].points_.size());
     int nPtj = int(point_cloud_vec[fj].points_.size());
-    geometry::KDTreeFlann feature_tree_i(features_vec[fi]);
-    geometry::KDTreeFlann feature_tree_j(features_vec[fj]);
-    std::vector<int> corresK;
-    std::vector<double> dis;
-    std::vector<std::pair<int, int>> corres;
-    std::vector<std::pair<int, int>> corres_ij;
-    std::vector<std::pair<int, int>> corres_ji;
+    // The nearest features are found by batched searches in both directions.
+    // Only the points of fi that are the nearest neighbor of a point of fj
+    // keep their own nearest neighbor.
+    const std::vector<int> j_to_i =
+            FindNearestFeatures(features_vec[fj], features_vec[fi]);
+    const std::vector<int> nearest_i_to_j =
+            FindNearestFeatures(features_vec[fi], features_vec[fj]);
     std::vector<int> i_to_j(nPti, -1);
+    int ncorres_ji = 0;
     for (int j = 0; j < nPtj; j++) {
-        feature_tree_i.SearchKNN(Eigen::VectorXd(features_vec[fj].data_.col(j)),
-                                 1, corresK, dis);
-        int i = corresK[0];
-        if (i_to_j[i] == -1) {
-            feature_tree_j.SearchKNN(
-                    Eigen::VectorXd(features_vec[fi].data_.col(i)), 1, corresK,
-                    dis);
-            int ij = corresK[0];
-            i_to_j[i] = ij;
-        }
-        corres_ji.push_back(std::pair<int, int>(i, j));
+        int i = j_to_i[j];
+        if (i < 0) continue;
+        i_to_j[i] = nearest_i_to_j[i];
+        ncorres_ji++;
     }
+    int ncorres_ij = 0;
     for (int i = 0; i < nPti; i++) {
-        if (i_to_j[i] != -1)
-            corres_ij.push_back(std::pair<int, int>(i, i_to_j[i]));
+        if (i_to_j[i] != -1) ncorres_ij++;
     }
-    int ncorres_ij = int(corres_ij.size());
-    int ncorres_ji = int(corres_ji.size());
-    for (int i = 0; i < ncorres_ij; ++i)
-        corres.push_back(
-                std::pair<int, int>(corres_ij[i].first, corres_ij[i].second));
-    for (int j = 0; j < ncorres_ji; ++j)
-        corres.push_back(
-                std::pair<int, int>(corres_ji[j].first, corres_ji[j].second));
-    utility::LogDebug("points are remained : {:d}", (int)corres.size());
+    utility::LogDebug("points are remained : {:d}", ncorres_ij + ncorres_ji);
 
     // STEP 2) CROSS CHECK
+    // Every point has at most one nearest neighbor in each direction, so a
+    // pair is reciprocal when each point is the nearest neighbor of the other.
     utility::LogDebug("\t[cross check] ");
     std::vector<std::pair<int, int>> corres_cross;
-    std::vector<std::vector<int>> Mi(nPti), Mj(nPtj);
-    int ci, cj;
-    for (int i = 0; i < ncorres_ij; ++i) {
-        ci = corres_ij[i].first;
-        cj = corres_ij[i].second;
-        Mi[ci].push_back(cj);
-    }
-    for (int j = 0; j < ncorres_ji; ++j) {
-        ci = corres_ji[j].first;
-        cj = corres_ji[j].second;
-        Mj[cj].push_back(ci);
-    }
     for (int i = 0; i < nPti; ++i) {
-        for (size_t ii = 0; ii < Mi[i].size(); ++ii) {
-            int j = Mi[i][ii];
-            for (size_t jj = 0; jj < Mj[j].size(); ++jj) {
-                if (Mj[j][jj] == i)
-                    corres_cross.push_back(std::pair<int, int>(i, j));
-            }
+        int j = i_to_j[i];
+        if (j != -1 && j_to_i[j] == i) {
+            corres_cross.push_back(std::pair<int, int>(i, j));
         }
     }
-    utility::LogDebug("points are remained : %d", (int)corres_cross.size());
+    utility::LogDebug("points are remained : {:d}", (int)corres_cross.size());
 
     // STEP 3) TUPLE CONSTRAINT
+    // Trials are split into chunks, each drawing from its own generator, and
+    // chunks are tested in parallel batches. Tuples are collected in chunk
+    // order until maximum_tuple_count_ of them are found.
     utility::LogDebug("\t[tuple constraint] ");
-    int rand0, rand1, rand2, i, cnt = 0;
-    int idi0, idi1, idi2, idj0, idj1, idj2;
-    double scale = option.tuple_scale_;
-    int ncorr = static_cast<int>(corres_cross.size());
-    int number_of_trial = ncorr * 100;
+    const double scale = option.tuple_scale_;
+    const int ncorr = static_cast<int>(corres_cross.size());
+    const int number_of_trial = ncorr * 100;
+    const int num_chunks =
+            (number_of_trial + kTupleTrialChunkSize - 1) / kTupleTrialChunkSize;
+    const unsigned int seed = utility::GetRANSACSeed(option.seed_);
+    const auto &points_i = point_cloud_vec[fi].points_;
+    const auto &points_j = point_cloud_vec[fj].points_;
 
     std::vector<std::pair<int, int>> corres_tuple;
-    for (i = 0; i < number_of_trial; i++) {
-        rand0 = utility::UniformRandInt(0, ncorr - 1);
-        rand1 = utility::UniformRandInt(0, ncorr - 1);
-        rand2 = utility::UniformRandInt(0, ncorr - 1);
-        idi0 = corres_cross[rand0].first;
-        idj0 = corres_cross[rand0].second;
-        idi1 = corres_cross[rand1].first;
-        idj1 = corres_cross[rand1].second;
-        idi2 = corres_cross[rand2].first;
-        idj2 = corres_cross[rand2].second;
-
-        // collect 3 points from i-th fragment
-        Eigen::Vector3d pti0 = point_cloud_vec[fi].points_[idi0];
-        Eigen::Vector3d pti1 = point_cloud_vec[fi].points_[idi1];
-        Eigen::Vector3d pti2 = point_cloud_vec[fi].points_[idi2];
-        double li0 = (pti0 - pti1).norm();
-        double li1 = (pti1 - pti2).norm();
-        double li2 = (pti2 - pti0).norm();
-
-        // collect 3 points from j-th fragment
-        Eigen::Vector3d ptj0 = point_cloud_vec[fj].points_[idj0];
-        Eigen::Vector3d ptj1 = point_cloud_vec[fj].points_[idj1];
-        Eigen::Vector3d ptj2 = point_cloud_vec[fj].points_[idj2];
-        double lj0 = (ptj0 - ptj1).norm();
-        double lj1 = (ptj1 - ptj2).norm();
-        double lj2 = (ptj2 - ptj0).norm();
-
-        // check tuple constraint
-        if ((li0 * scale < lj0) && (lj0 < li0 / scale) && (li1 * scale < lj1) &&
-            (lj1 < li1 / scale) && (li2 * scale < lj2) && (lj2 < li2 / scale)) {
-            corres_tuple.push_back(std::pair<int, int>(idi0, idj0));
-            corres_tuple.push_back(std::pair<int, int>(idi1, idj1));
-            corres_tuple.push_back(std::pair<int, int>(idi2, idj2));
-            cnt++;
+    std::vector<std::vector<std::pair<int, int>>> chunk_tuples(
+            kTupleChunkBatchSize);
+    std::vector<int> chunk_trials(kTupleChunkBatchSize);
+    int cnt = 0, trials = 0;
+    for (int batch = 0; batch < num_chunks && cnt < option.maximum_tuple_count_;
+         batch += kTupleChunkBatchSize) {
+        const int batch_size =
+                std::min(kTupleChunkBatchSize, num_chunks - batch);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int c = 0; c < batch_size; c++) {
+            std::seed_seq seed_seq{seed, (unsigned int)(batch + c)};
+            std::mt19937 rng(seed_seq);
+            std::uniform_int_distribution<int> distribution(0, ncorr - 1);
+            const int begin = (batch + c) * kTupleTrialChunkSize;
+            const int end =
+                    std::min(begin + kTupleTrialChunkSize, number_of_trial);
+            auto &tuples = chunk_tuples[c];
+            tuples.clear();
+            int t = begin;
+            while (t < end &&
+                   (int)tuples.size() < 3 * option.maximum_tuple_count_) {
+                t++;
+                const auto &c0 = corres_cross[distribution(rng)];
+                const auto &c1 = corres_cross[distribution(rng)];
+                const auto &c2 = corres_cross[distribution(rng)];
+
+                // collect 3 points from i-th fragment
+                double li0 = (points_i[c0.first] - points_i[c1.first]).norm();
+                double li1 = (points_i[c1.first] - points_i[c2.first]).norm();
+                double li2 = (points_i[c2.first] - points_i[c0.first]).norm();
+
+                // collect 3 points from j-th fragment
+                double lj0 =
+                        (points_j[c0.second] - points_j[c1.second]).norm();
+                double lj1 =
+                        (points_j[c1.second] - points_j[c2.second]).norm();
+                double lj2 =
+                        (points_j[c2.second] - points_j[c0.second]).norm();
+
+                // check tuple constraint
+                if ((li0 * scale < lj0) && (lj0 < li0 / scale) &&
+                    (li1 * scale < lj1) && (lj1 < li1 / scale) &&
+                    (li2 * scale < lj2) && (lj2 < li2 / scale)) {
+                    tuples.push_back(c0);
+                    tuples.push_back(c1);
+                    tuples.push_back(c2);
+                }
+            }
+            chunk_trials[c] = t - begin;
+        }
+        // Merge the chunks in order so that the tuples do not depend on the
+        // number of threads.
+        for (int c = 0; c < batch_size && cnt < option.maximum_tuple_count_;
+             c++) {
+            const auto &tuples = chunk_tuples[c];
+            const int take = std::min((int)tuples.size() / 3,
+                                      option.maximum_tuple_count_ - cnt);
+            corres_tuple.insert(corres_tuple.end(), tuples.begin(),
+                                tuples.begin() + 3 * take);
+            cnt += take;
+            trials += chunk_trials[c];
         }
-        if (cnt >= option.maximum_tuple_count_) break;
     }
     utility::LogDebug("{:d} tuples ({:d} trial, {:d} actual).", cnt,
-                      number_of_trial, i);
+                      number_of_trial, trials);
 
     if (swapped) {
         std::vector<std::pair<int, int>> temp;
@@ -24,11 +24,18 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4267)
+#endif
+
 #include "Open3D/Registration/Feature.h"
 
 #include <Eigen/Dense>
+#include <algorithm>
+#include <flann/flann.hpp>
 
-#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/NeighborhoodGraph.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Utility/Console.h"
 
@@ -71,46 +78,81 @@ Eigen::Vector4d ComputePairFeatures(const Eigen::Vector3d &p1,
     return result;
 }
 
-std::shared_ptr<Feature> ComputeSPFHFeature(
-        const geometry::PointCloud &input,
-        const geometry::KDTreeFlann &kdtree,
-        const geometry::KDTreeSearchParam &search_param) {
-    auto feature = std::make_shared<Feature>();
-    feature->Resize(33, (int)input.points_.size());
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < (int)input.points_.size(); i++) {
-        const auto &point = input.points_[i];
-        const auto &normal = input.normals_[i];
-        std::vector<int> indices;
-        std::vector<double> distance2;
-        if (kdtree.Search(point, search_param, indices, distance2) > 1) {
-            // only compute SPFH feature when a point has neighbors
-            double hist_incr = 100.0 / (double)(indices.size() - 1);
-            for (size_t k = 1; k < indices.size(); k++) {
-                // skip the point itself, compute histogram
-                auto pf = ComputePairFeatures(point, normal,
-                                              input.points_[indices[k]],
-                                              input.normals_[indices[k]]);
-                int h_index = (int)(floor(11 * (pf(0) + M_PI) / (2.0 * M_PI)));
-                if (h_index < 0) h_index = 0;
-                if (h_index >= 11) h_index = 10;
-                feature->data_(h_index, i) += hist_incr;
-                h_index = (int)(floor(11 * (pf(1) + 1.0) * 0.5));
-                if (h_index < 0) h_index = 0;
-                if (h_index >= 11) h_index = 10;
-                feature->data_(h_index + 11, i) += hist_incr;
-                h_index = (int)(floor(11 * (pf(2) + 1.0) * 0.5));
-                if (h_index < 0) h_index = 0;
-                if (h_index >= 11) h_index = 10;
-                feature->data_(h_index + 22, i) += hist_incr;
-            }
+/// Computes the SPFH histogram of point i from its neighbors, which start with
+/// the point itself.
+void ComputeSPFHHistogram(const geometry::PointCloud &input,
+                          int i,
+                          const int *indices,
+                          int num_indices,
+                          Eigen::MatrixXd &spfh) {
+    if (num_indices <= 1) {
+        // only compute SPFH feature when a point has neighbors
+        return;
+    }
+    const auto &point = input.points_[i];
+    const auto &normal = input.normals_[i];
+    double hist_incr = 100.0 / (double)(num_indices - 1);
+    for (int k = 1; k < num_indices; k++) {
+        // skip the point itself, compute histogram
+        auto pf = ComputePairFeatures(point, normal, input.points_[indices[k]],
+                                      input.normals_[indices[k]]);
+        int h_index = (int)(floor(11 * (pf(0) + M_PI) / (2.0 * M_PI)));
+        if (h_index < 0) h_index = 0;
+        if (h_index >= 11) h_index = 10;
+        spfh(h_index, i) += hist_incr;
+        h_index = (int)(floor(11 * (pf(1) + 1.0) * 0.5));
+        if (h_index < 0) h_index = 0;
+        if (h_index >= 11) h_index = 10;
+        spfh(h_index + 11, i) += hist_incr;
+        h_index = (int)(floor(11 * (pf(2) + 1.0) * 0.5));
+        if (h_index < 0) h_index = 0;
+        if (h_index >= 11) h_index = 10;
+        spfh(h_index + 22, i) += hist_incr;
+    }
+}
+
+/// Computes the FPFH feature of point i by weighting the SPFH histograms of
+/// its neighbors, which start with the point itself. The histogram is
+/// accumulated in double precision and stored in single precision.
+void ComputeFPFHHistogram(const Eigen::MatrixXd &spfh,
+                          int i,
+                          const int *indices,
+                          const double *distance2,
+                          int num_indices,
+                          Feature &feature) {
+    if (num_indices <= 1) {
+        return;
+    }
+    Eigen::Matrix<double, 33, 1> histogram;
+    histogram.setZero();
+    double sum[3] = {0.0, 0.0, 0.0};
+    for (int k = 1; k < num_indices; k++) {
+        // skip the point itself
+        double dist = distance2[k];
+        if (dist == 0.0) continue;
+        for (int j = 0; j < 33; j++) {
+            double val = spfh(j, indices[k]) / dist;
+            sum[j / 11] += val;
+            histogram(j) += val;
         }
     }
-    return feature;
+    for (int j = 0; j < 3; j++)
+        if (sum[j] != 0.0) sum[j] = 100.0 / sum[j];
+    for (int j = 0; j < 33; j++) {
+        histogram(j) *= sum[j / 11];
+        // The commented line is the fpfh function in the paper.
+        // But according to PCL implementation, it is skipped.
+        // Our initial test shows that the full fpfh function in the
+        // paper seems to be better than PCL implementation. Further
+        // test required.
+        histogram(j) += spfh(j, i);
+    }
+    feature.data_.col(i) = histogram.cast<float>();
 }
 
+/// Number of consecutive queries handled by one task of FindNearestFeatures.
+const int kFeatureQueryChunkSize = 256;
+
 }  // unnamed namespace
 
 namespace registration {
@@ -118,6 +160,19 @@ std::shared_ptr<Feature> ComputeFPFHFeature(
         const geometry::PointCloud &input,
         const geometry::KDTreeSearchParam
                 &search_param /* = geometry::KDTreeSearchParamKNN()*/) {
+    if (input.HasNormals() == false) {
+        utility::LogError(
+                "[ComputeFPFHFeature] Failed because input point cloud has no "
+                "normal.");
+    }
+    auto graph = geometry::NeighborhoodGraph::CreateFromPointCloud(
+            input, search_param);
+    return ComputeFPFHFeature(input, *graph);
+}
+
+std::shared_ptr<Feature> ComputeFPFHFeature(
+        const geometry::PointCloud &input,
+        const geometry::NeighborhoodGraph &graph) {
     auto feature = std::make_shared<Feature>();
     feature->Resize(33, (int)input.points_.size());
     if (input.HasNormals() == false) {
@@ -125,42 +180,96 @@ std::shared_ptr<Feature> ComputeFPFHFeature(
                 "[ComputeFPFHFeature] Failed because input point cloud has no "
                 "normal.");
     }
-    geometry::KDTreeFlann kdtree(input);
-    auto spfh = ComputeSPFHFeature(input, kdtree, search_param);
+    if (graph.NumPoints() != input.points_.size()) {
+        utility::LogError(
+                "[ComputeFPFHFeature] The neighborhood graph does not match "
+                "the point cloud.");
+    }
+    Eigen::MatrixXd spfh = Eigen::MatrixXd::Zero(33, input.points_.size());
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
     for (int i = 0; i < (int)input.points_.size(); i++) {
-        const auto &point = input.points_[i];
-        std::vector<int> indices;
-        std::vector<double> distance2;
-        if (kdtree.Search(point, search_param, indices, distance2) > 1) {
-            double sum[3] = {0.0, 0.0, 0.0};
-            for (size_t k = 1; k < indices.size(); k++) {
-                // skip the point itself
-                double dist = distance2[k];
-                if (dist == 0.0) continue;
-                for (int j = 0; j < 33; j++) {
-                    double val = spfh->data_(j, indices[k]) / dist;
-                    sum[j / 11] += val;
-                    feature->data_(j, i) += val;
-                }
-            }
-            for (int j = 0; j < 3; j++)
-                if (sum[j] != 0.0) sum[j] = 100.0 / sum[j];
-            for (int j = 0; j < 33; j++) {
-                feature->data_(j, i) *= sum[j / 11];
-                // The commented line is the fpfh function in the paper.
-                // But according to PCL implementation, it is skipped.
-                // Our initial test shows that the full fpfh function in the
-                // paper seems to be better than PCL implementation. Further
-                // test required.
-                feature->data_(j, i) += spfh->data_(j, i);
-            }
-        }
+        ComputeSPFHHistogram(input, i,
+                             graph.indices_.data() + graph.offsets_[i],
+                             graph.NumNeighbors(i), spfh);
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < (int)input.points_.size(); i++) {
+        ComputeFPFHHistogram(spfh, i, graph.indices_.data() + graph.offsets_[i],
+                             graph.distance2_.data() + graph.offsets_[i],
+                             graph.NumNeighbors(i), *feature);
     }
     return feature;
 }
 
+std::vector<int> FindNearestFeatures(const Feature &query,
+                                     const Feature &reference) {
+    std::vector<int> nearest(query.Num(), -1);
+    if (query.Dimension() != reference.Dimension()) {
+        utility::LogError(
+                "[FindNearestFeatures] Features have different dimensions.");
+    }
+    if (reference.Num() == 0 || query.Num() == 0) {
+        return nearest;
+    }
+
+    // The columns of the features are the rows of flann matrices, so the
+    // index and the queries use the feature data in place.
+    const int dimension = (int)reference.Dimension();
+    flann::Matrix<float> reference_flann((float *)reference.data_.data(),
+                                         reference.Num(), dimension);
+    flann::Index<flann::L2<float>> index(reference_flann,
+                                         flann::KDTreeSingleIndexParams(15));
+    index.buildIndex();
+    const int num_query = (int)query.Num();
+    const int num_chunks =
+            (num_query + kFeatureQueryChunkSize - 1) / kFeatureQueryChunkSize;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int c = 0; c < num_chunks; c++) {
+        const int begin = c * kFeatureQueryChunkSize;
+        const int n = std::min(kFeatureQueryChunkSize, num_query - begin);
+        std::vector<float> distance2(n);
+        flann::Matrix<float> query_flann(
+                (float *)query.data_.data() + (size_t)begin * dimension, n,
+                dimension);
+        flann::Matrix<int> indices_flann(nearest.data() + begin, n, 1);
+        flann::Matrix<float> dists_flann(distance2.data(), n, 1);
+        index.knnSearch(query_flann, indices_flann, dists_flann, 1,
+                        flann::SearchParams(-1, 0.0));
+    }
+    return nearest;
+}
+
+CorrespondenceSet CorrespondencesFromFeatures(
+        const Feature &source_feature,
+        const Feature &target_feature,
+        bool mutual_filter /* = false*/) {
+    CorrespondenceSet corres;
+    const std::vector<int> source_to_target =
+            FindNearestFeatures(source_feature, target_feature);
+    std::vector<int> target_to_source;
+    if (mutual_filter) {
+        target_to_source = FindNearestFeatures(target_feature, source_feature);
+    }
+    corres.reserve(source_to_target.size());
+    for (int i = 0; i < (int)source_to_target.size(); i++) {
+        const int j = source_to_target[i];
+        if (j < 0 || (mutual_filter && target_to_source[j] != i)) {
+            continue;
+        }
+        corres.push_back(Eigen::Vector2i(i, j));
+    }
+    return corres;
+}
+
 }  // namespace registration
 }  // namespace open3d
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
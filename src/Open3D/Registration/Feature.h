@@ -31,15 +31,20 @@
 #include <vector>
 
 #include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Registration/TransformationEstimation.h"
 
 namespace open3d {
 
 namespace geometry {
+class NeighborhoodGraph;
 class PointCloud;
 }
 
 namespace registration {
 
+/// Features of the points of a point cloud, one column per point. They are
+/// stored in single precision, which halves their memory and the cost of
+/// matching them compared to double precision.
 class Feature {
 public:
     void Resize(int dim, int n) {
@@ -50,7 +55,7 @@ public:
     size_t Num() const { return data_.cols(); }
 
 public:
-    Eigen::MatrixXd data_;
+    Eigen::MatrixXf data_;
 };
 
 /// Function to compute FPFH feature for a point cloud
@@ -59,5 +64,28 @@ std::shared_ptr<Feature> ComputeFPFHFeature(
         const geometry::KDTreeSearchParam &search_param =
                 geometry::KDTreeSearchParamKNN());
 
+/// Function to compute FPFH feature for a point cloud from the neighbors in
+/// graph, which must have been created from input. Both passes of the
+/// algorithm use the graph instead of searching the neighbors again.
+std::shared_ptr<Feature> ComputeFPFHFeature(
+        const geometry::PointCloud &input,
+        const geometry::NeighborhoodGraph &graph);
+
+/// Function to find the nearest feature in reference of every feature in
+/// query. The search is exact, in single precision, with a KDTree built on
+/// the reference features in place and parallelized over the queries.
+/// Returns the index of the nearest reference feature for every column of
+/// query, or -1 for all of them if reference is empty.
+std::vector<int> FindNearestFeatures(const Feature &query,
+                                     const Feature &reference);
+
+/// Function to find correspondences between the points of source and target
+/// from the nearest neighbors of their features. If mutual_filter is true,
+/// only correspondences whose points are nearest neighbors of each other in
+/// both directions are kept.
+CorrespondenceSet CorrespondencesFromFeatures(const Feature &source_feature,
+                                              const Feature &target_feature,
+                                              bool mutual_filter = false);
+
 }  // namespace registration
 }  // namespace open3d
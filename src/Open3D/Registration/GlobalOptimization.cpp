@@ -28,6 +28,7 @@
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <algorithm>
 #include <tuple>
 #include <vector>
 
@@ -203,48 +204,164 @@ Eigen::VectorXd ComputeZeta(const PoseGraph &pose_graph) {
 /// https ://github.com/RainerKuemmerle/g2o/blob/master/doc/g2o.pdf
 /// Eq (20) and Eq (21). (There is a typo in the equation though. B should be J)
 ///
-/// This function focuses the case that every edge has two nodes (not hyper
-/// graph) so we have two Jacobian matrices from one constraint.
-std::tuple<Eigen::MatrixXd, Eigen::VectorXd> ComputeLinearSystem(
-        const PoseGraph &pose_graph, const Eigen::VectorXd &zeta) {
-    int n_nodes = (int)pose_graph.nodes_.size();
-    int n_edges = (int)pose_graph.edges_.size();
-    Eigen::MatrixXd H(n_nodes * 6, n_nodes * 6);
-    Eigen::VectorXd b(n_nodes * 6);
-    H.setZero();
-    b.setZero();
+/// This class focuses the case that every edge has two nodes (not hyper
+/// graph) so we have two Jacobian matrices from one constraint. H is stored as
+/// a sparse matrix made of dense 6x6 blocks: one on the diagonal for every
+/// node and two off-diagonal blocks for every edge. The sparsity pattern only
+/// depends on the edge set, so it is built once together with the symbolic
+/// Cholesky analysis, and every iteration only refills the numerical values.
+class PoseGraphLinearSystem {
+public:
+    explicit PoseGraphLinearSystem(const PoseGraph &pose_graph) {
+        int n_nodes = (int)pose_graph.nodes_.size();
+        int n_edges = (int)pose_graph.edges_.size();
+
+        std::vector<Eigen::Triplet<double>> triplets;
+        triplets.reserve((n_nodes + 2 * n_edges) * 36);
+        auto add_block_pattern = [&triplets](int id_i, int id_j) {
+            for (int c = 0; c < 6; c++) {
+                for (int r = 0; r < 6; r++) {
+                    triplets.emplace_back(id_i * 6 + r, id_j * 6 + c, 0.0);
+                }
+            }
+        };
+        for (int iter_node = 0; iter_node < n_nodes; iter_node++) {
+            add_block_pattern(iter_node, iter_node);
+        }
+        for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
+            const PoseGraphEdge &t = pose_graph.edges_[iter_edge];
+            if (t.source_node_id_ != t.target_node_id_) {
+                add_block_pattern(t.source_node_id_, t.target_node_id_);
+                add_block_pattern(t.target_node_id_, t.source_node_id_);
+            }
+        }
+        // Duplicated blocks (parallel edges) are summed into a single block.
+        H_.resize(n_nodes * 6, n_nodes * 6);
+        H_.setFromTriplets(triplets.begin(), triplets.end());
+        H_.makeCompressed();
+        H_LM_ = H_;
+        b_.resize(n_nodes * 6);
+
+        diagonal_offsets_.resize(n_nodes * 6);
+        for (int i = 0; i < n_nodes * 6; i++) {
+            diagonal_offsets_[i] = GetValueOffset(i, i);
+        }
+        edge_block_offsets_.resize(n_edges * 4);
+        for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
+            const PoseGraphEdge &t = pose_graph.edges_[iter_edge];
+            int id_i = t.source_node_id_ * 6;
+            int id_j = t.target_node_id_ * 6;
+            edge_block_offsets_[iter_edge * 4 + 0] = GetValueOffset(id_i, id_i);
+            edge_block_offsets_[iter_edge * 4 + 1] = GetValueOffset(id_i, id_j);
+            edge_block_offsets_[iter_edge * 4 + 2] = GetValueOffset(id_j, id_i);
+            edge_block_offsets_[iter_edge * 4 + 3] = GetValueOffset(id_j, id_j);
+        }
 
-    for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
-        const PoseGraphEdge &t = pose_graph.edges_[iter_edge];
-        Eigen::Vector6d e = zeta.block<6, 1>(iter_edge * 6, 0);
+        solver_.analyzePattern(H_);
+    }
 
-        Eigen::Matrix4d X_inv, Ts, Tt_inv;
-        std::tie(X_inv, Ts, Tt_inv) = GetRelativePoses(pose_graph, iter_edge);
+public:
+    /// Function to fill H and b from the current poses and residuals.
+    void Compute(const PoseGraph &pose_graph, const Eigen::VectorXd &zeta) {
+        int n_edges = (int)pose_graph.edges_.size();
+        std::fill(H_.valuePtr(), H_.valuePtr() + H_.nonZeros(), 0.0);
+        b_.setZero();
+
+        for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
+            const PoseGraphEdge &t = pose_graph.edges_[iter_edge];
+            Eigen::Vector6d e = zeta.block<6, 1>(iter_edge * 6, 0);
 
-        Eigen::Matrix6d Js, Jt;
-        std::tie(Js, Jt) = GetJacobian(X_inv, Ts, Tt_inv);
-        Eigen::Matrix6d JsT_Info = Js.transpose() * t.information_;
-        Eigen::Matrix6d JtT_Info = Jt.transpose() * t.information_;
-        Eigen::Vector6d eT_Info = e.transpose() * t.information_;
-        double line_process_iter = t.confidence_;
-
-        int id_i = t.source_node_id_ * 6;
-        int id_j = t.target_node_id_ * 6;
-        H.block<6, 6>(id_i, id_i).noalias() +=
-                line_process_iter * JsT_Info * Js;
-        H.block<6, 6>(id_i, id_j).noalias() +=
-                line_process_iter * JsT_Info * Jt;
-        H.block<6, 6>(id_j, id_i).noalias() +=
-                line_process_iter * JtT_Info * Js;
-        H.block<6, 6>(id_j, id_j).noalias() +=
-                line_process_iter * JtT_Info * Jt;
-        b.block<6, 1>(id_i, 0).noalias() -=
-                line_process_iter * eT_Info.transpose() * Js;
-        b.block<6, 1>(id_j, 0).noalias() -=
-                line_process_iter * eT_Info.transpose() * Jt;
+            Eigen::Matrix4d X_inv, Ts, Tt_inv;
+            std::tie(X_inv, Ts, Tt_inv) =
+                    GetRelativePoses(pose_graph, iter_edge);
+
+            Eigen::Matrix6d Js, Jt;
+            std::tie(Js, Jt) = GetJacobian(X_inv, Ts, Tt_inv);
+            Eigen::Matrix6d JsT_Info = Js.transpose() * t.information_;
+            Eigen::Matrix6d JtT_Info = Jt.transpose() * t.information_;
+            Eigen::Vector6d eT_Info = e.transpose() * t.information_;
+            double line_process_iter = t.confidence_;
+
+            int id_i = t.source_node_id_ * 6;
+            int id_j = t.target_node_id_ * 6;
+            const int *offsets = &edge_block_offsets_[iter_edge * 4];
+            AddBlock(id_i, offsets[0], line_process_iter * JsT_Info * Js);
+            AddBlock(id_j, offsets[1], line_process_iter * JsT_Info * Jt);
+            AddBlock(id_i, offsets[2], line_process_iter * JtT_Info * Js);
+            AddBlock(id_j, offsets[3], line_process_iter * JtT_Info * Jt);
+            b_.block<6, 1>(id_i, 0).noalias() -=
+                    line_process_iter * eT_Info.transpose() * Js;
+            b_.block<6, 1>(id_j, 0).noalias() -=
+                    line_process_iter * eT_Info.transpose() * Jt;
+        }
+    }
+
+    /// Function to solve (H + lambda * I) @ delta == b, reusing the symbolic
+    /// factorization computed in the constructor.
+    std::tuple<bool, Eigen::VectorXd> Solve(double lambda = 0.0) {
+        const Eigen::SparseMatrix<double> *A = &H_;
+        if (lambda != 0.0) {
+            std::copy(H_.valuePtr(), H_.valuePtr() + H_.nonZeros(),
+                      H_LM_.valuePtr());
+            for (const int offset : diagonal_offsets_) {
+                H_LM_.valuePtr()[offset] += lambda;
+            }
+            A = &H_LM_;
+        }
+        Eigen::VectorXd delta(b_.rows());
+        solver_.factorize(*A);
+        if (solver_.info() == Eigen::Success) {
+            delta = solver_.solve(b_);
+            if (solver_.info() == Eigen::Success) {
+                return std::make_tuple(true, std::move(delta));
+            } else {
+                utility::LogWarning(
+                        "Cholesky solve failed, switched to dense solver");
+            }
+        } else {
+            utility::LogWarning(
+                    "Cholesky decompose failed, switched to dense solver");
+        }
+        delta = Eigen::MatrixXd(*A).ldlt().solve(b_);
+        return std::make_tuple(true, std::move(delta));
     }
-    return std::make_tuple(std::move(H), std::move(b));
-}
+
+    const Eigen::SparseMatrix<double> &GetH() const { return H_; }
+    const Eigen::VectorXd &Getb() const { return b_; }
+
+private:
+    /// Index into the value array of H_ of the entry (row, col). All columns
+    /// of a 6x6 block column share the same row structure, so the entries of
+    /// column col + c of a block start at this offset + c * (column size).
+    int GetValueOffset(int row, int col) const {
+        const int *outer = H_.outerIndexPtr();
+        const int *inner = H_.innerIndexPtr();
+        const int *it = std::lower_bound(inner + outer[col],
+                                         inner + outer[col + 1], row);
+        return (int)(it - inner);
+    }
+
+    void AddBlock(int col, int offset, const Eigen::Matrix6d &block) {
+        const int *outer = H_.outerIndexPtr();
+        int column_size = outer[col + 1] - outer[col];
+        double *values = H_.valuePtr() + offset;
+        for (int c = 0; c < 6; c++) {
+            for (int r = 0; r < 6; r++) {
+                values[c * column_size + r] += block(r, c);
+            }
+        }
+    }
+
+private:
+    Eigen::SparseMatrix<double> H_;
+    Eigen::SparseMatrix<double> H_LM_;
+    Eigen::VectorXd b_;
+    /// Value offsets of the (source, source), (source, target),
+    /// (target, source) and (target, target) blocks of every edge.
+    std::vector<int> edge_block_offsets_;
+    std::vector<int> diagonal_offsets_;
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver_;
+};
 
 Eigen::VectorXd UpdatePoseVector(const PoseGraph &pose_graph) {
     int n_nodes = (int)pose_graph.nodes_.size();
@@ -511,16 +628,15 @@ void GlobalOptimizationGaussNewton::OptimizePoseGraph(
     valid_edges_num =
             UpdateConfidence(pose_graph, zeta, line_process_weight, option);
 
-    Eigen::MatrixXd H;
-    Eigen::VectorXd b;
     Eigen::VectorXd x = UpdatePoseVector(pose_graph);
 
-    std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+    PoseGraphLinearSystem linear_system(pose_graph);
+    linear_system.Compute(pose_graph, zeta);
 
     utility::LogDebug("[Initial     ] residual : {:e}", current_residual);
 
     bool stop = false;
-    if (CheckRightTerm(b, criteria)) return;
+    if (CheckRightTerm(linear_system.Getb(), criteria)) return;
 
     utility::Timer timer_overall;
     timer_overall.Start();
@@ -529,13 +645,11 @@ void GlobalOptimizationGaussNewton::OptimizePoseGraph(
         utility::Timer timer_iter;
         timer_iter.Start();
 
-        Eigen::VectorXd delta(H.cols());
+        Eigen::VectorXd delta;
         bool solver_success = false;
 
-        // Solve H_LM @ delta == b using a sparse solver
-        std::tie(solver_success, delta) = utility::SolveLinearSystemPSD(
-                H, b, /*prefer_sparse=*/true, /*check_symmetric=*/false,
-                /*check_det=*/false, /*check_psd=*/false);
+        // Solve H @ delta == b using a sparse solver
+        std::tie(solver_success, delta) = linear_system.Solve();
 
         stop = stop || CheckRelativeIncrement(delta, x, criteria);
         if (stop) {
@@ -558,9 +672,9 @@ void GlobalOptimizationGaussNewton::OptimizePoseGraph(
             x = UpdatePoseVector(pose_graph);
             valid_edges_num = UpdateConfidence(pose_graph, zeta,
                                                line_process_weight, option);
-            std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+            linear_system.Compute(pose_graph, zeta);
 
-            stop = stop || CheckRightTerm(b, criteria);
+            stop = stop || CheckRightTerm(linear_system.Getb(), criteria);
             if (stop) break;
         }
         timer_iter.Stop();
@@ -602,14 +716,12 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
     int valid_edges_num =
             UpdateConfidence(pose_graph, zeta, line_process_weight, option);
 
-    Eigen::MatrixXd H_I = Eigen::MatrixXd::Identity(n_nodes * 6, n_nodes * 6);
-    Eigen::MatrixXd H;
-    Eigen::VectorXd b;
     Eigen::VectorXd x = UpdatePoseVector(pose_graph);
 
-    std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+    PoseGraphLinearSystem linear_system(pose_graph);
+    linear_system.Compute(pose_graph, zeta);
 
-    Eigen::VectorXd H_diag = H.diagonal();
+    Eigen::VectorXd H_diag = linear_system.GetH().diagonal();
     double tau = 1e-5;
     double current_lambda = tau * H_diag.maxCoeff();
     double ni = 2.0;
@@ -619,7 +731,7 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
                       current_residual, current_lambda);
 
     bool stop = false;
-    stop = stop || CheckRightTerm(b, criteria);
+    stop = stop || CheckRightTerm(linear_system.Getb(), criteria);
     if (stop) return;
 
     utility::Timer timer_overall;
@@ -629,14 +741,13 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
         timer_iter.Start();
         int lm_count = 0;
         do {
-            Eigen::MatrixXd H_LM = H + current_lambda * H_I;
-            Eigen::VectorXd delta(H_LM.cols());
+            Eigen::VectorXd delta;
             bool solver_success = false;
 
-            // Solve H_LM @ delta == b using a sparse solver
-            std::tie(solver_success, delta) = utility::SolveLinearSystemPSD(
-                    H_LM, b, /*prefer_sparse=*/true, /*check_symmetric=*/false,
-                    /*check_det=*/false, /*check_psd=*/false);
+            // Solve H_LM @ delta == b using a sparse solver, where
+            // H_LM = H + current_lambda * I
+            std::tie(solver_success, delta) =
+                    linear_system.Solve(current_lambda);
 
             stop = stop || CheckRelativeIncrement(delta, x, criteria);
             if (!stop) {
@@ -648,7 +759,9 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
                 new_residual = ComputeResidual(pose_graph, zeta_new,
                                                line_process_weight, option);
                 rho = (current_residual - new_residual) /
-                      (delta.dot(current_lambda * delta + b) + 1e-3);
+                      (delta.dot(current_lambda * delta +
+                                 linear_system.Getb()) +
+                       1e-3);
                 if (rho > 0) {
                     stop = stop ||
                            CheckRelativeResidualIncrement(
@@ -667,9 +780,10 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
                     x = UpdatePoseVector(pose_graph);
                     valid_edges_num = UpdateConfidence(
                             pose_graph, zeta, line_process_weight, option);
-                    std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+                    linear_system.Compute(pose_graph, zeta);
 
-                    stop = stop || CheckRightTerm(b, criteria);
+                    stop = stop ||
+                           CheckRightTerm(linear_system.Getb(), criteria);
                     if (stop) break;
                 } else {
                     current_lambda *= ni;
@@ -26,7 +26,13 @@
 
 #include "Open3D/Registration/Registration.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstdlib>
+#include <numeric>
+#include <random>
+#include <typeinfo>
 
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
@@ -39,60 +45,194 @@ namespace open3d {
 namespace {
 using namespace registration;
 
-RegistrationResult GetRegistrationResultAndCorrespondences(
+/// Number of consecutive feature matching RANSAC iterations that a thread
+/// claims at once and draws from one generator.
+const int kRANSACIterationBlockSize = 256;
+
+/// Computes the correspondences of the source points within
+/// max_correspondence_distance of the target, and the fitness and rmse, into
+/// result. The memory of the correspondence set of result and of the search
+/// buffers indices, dists and offsets is reused across calls.
+void UpdateRegistrationResultAndCorrespondences(
         const geometry::PointCloud &source,
-        const geometry::PointCloud &target,
         const geometry::KDTreeFlann &target_kdtree,
         double max_correspondence_distance,
-        const Eigen::Matrix4d &transformation) {
-    RegistrationResult result(transformation);
+        const Eigen::Matrix4d &transformation,
+        std::vector<int> &indices,
+        std::vector<double> &dists,
+        std::vector<int> &offsets,
+        RegistrationResult &result) {
+    result.transformation_ = transformation;
+    result.correspondence_set_.clear();
+    result.fitness_ = 0.0;
+    result.inlier_rmse_ = 0.0;
     if (max_correspondence_distance <= 0.0) {
-        return result;
+        return;
     }
 
     double error2 = 0.0;
+    if (target_kdtree.SearchHybrid(
+                Eigen::Map<const Eigen::MatrixXd>(
+                        (const double *)source.points_.data(), 3,
+                        source.points_.size()),
+                max_correspondence_distance, 1, indices, dists, offsets) > 0) {
+        result.correspondence_set_.reserve(indices.size());
+        for (int i = 0; i < (int)source.points_.size(); i++) {
+            if (offsets[i + 1] > offsets[i]) {
+                error2 += dists[offsets[i]];
+                result.correspondence_set_.push_back(
+                        Eigen::Vector2i(i, indices[offsets[i]]));
+            }
+        }
+    }
 
+    if (!result.correspondence_set_.empty()) {
+        size_t corres_number = result.correspondence_set_.size();
+        result.fitness_ = (double)corres_number / (double)source.points_.size();
+        result.inlier_rmse_ = std::sqrt(error2 / (double)corres_number);
+    }
+}
+
+RegistrationResult GetRegistrationResultAndCorrespondences(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const geometry::KDTreeFlann &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &transformation) {
+    RegistrationResult result;
+    std::vector<int> indices;
+    std::vector<double> dists;
+    std::vector<int> offsets;
+    UpdateRegistrationResultAndCorrespondences(
+            source, target_kdtree, max_correspondence_distance, transformation,
+            indices, dists, offsets, result);
+    return result;
+}
+
+/// One pass of point to plane ICP at transformation. Every transformed source
+/// point is matched to its nearest target point within
+/// max_correspondence_distance, and the weighted residuals of the matches are
+/// summed into JTJ and JTr. target_index receives the match of every source
+/// point, or -1. Returns the number of matches and their sum of squared
+/// distances.
+std::pair<int, double> LinearizePointToPlane(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const geometry::KDTreeFlann &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &transformation,
+        const RobustKernel &kernel,
+        std::vector<int> &target_index,
+        Eigen::Matrix6d &JTJ,
+        Eigen::Vector6d &JTr) {
+    const Eigen::Matrix3d rotation = transformation.block<3, 3>(0, 0);
+    const Eigen::Vector3d translation = transformation.block<3, 1>(0, 3);
+    const int num_points = (int)source.points_.size();
+    target_index.resize(num_points);
+    int num_corres = 0;
+    double error2 = 0.0;
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel reduction(+ : num_corres, error2)
     {
 #endif
-        double error2_private = 0.0;
-        CorrespondenceSet correspondence_set_private;
+        std::vector<int> indices(1);
+        std::vector<double> dists(1);
 #ifdef _OPENMP
 #pragma omp for nowait
 #endif
-        for (int i = 0; i < (int)source.points_.size(); i++) {
-            std::vector<int> indices(1);
-            std::vector<double> dists(1);
-            const auto &point = source.points_[i];
-            if (target_kdtree.SearchHybrid(point, max_correspondence_distance,
-                                           1, indices, dists) > 0) {
-                error2_private += dists[0];
-                correspondence_set_private.push_back(
-                        Eigen::Vector2i(i, indices[0]));
-            }
-        }
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-        {
-            for (int i = 0; i < (int)correspondence_set_private.size(); i++) {
-                result.correspondence_set_.push_back(
-                        correspondence_set_private[i]);
+        for (int i = 0; i < num_points; i++) {
+            const Eigen::Vector3d vs =
+                    rotation * source.points_[i] + translation;
+            if (target_kdtree.SearchHybrid(vs, max_correspondence_distance, 1,
+                                           indices, dists) <= 0) {
+                target_index[i] = -1;
+                continue;
             }
-            error2 += error2_private;
+            target_index[i] = indices[0];
+            num_corres++;
+            error2 += dists[0];
         }
 #ifdef _OPENMP
     }
 #endif
 
-    if (result.correspondence_set_.empty()) {
-        result.fitness_ = 0.0;
-        result.inlier_rmse_ = 0.0;
-    } else {
-        size_t corres_number = result.correspondence_set_.size();
-        result.fitness_ = (double)corres_number / (double)source.points_.size();
-        result.inlier_rmse_ = std::sqrt(error2 / (double)corres_number);
+    auto compute_jacobian_and_residual =
+            [&](int i, utility::JTJandJTrAccumulator &sum) {
+                if (target_index[i] < 0) {
+                    return;
+                }
+                const Eigen::Vector3d vs =
+                        rotation * source.points_[i] + translation;
+                const Eigen::Vector3d &vt = target.points_[target_index[i]];
+                const Eigen::Vector3d &nt = target.normals_[target_index[i]];
+                const double r = (vs - vt).dot(nt);
+                Eigen::Vector6d J_r;
+                J_r.block<3, 1>(0, 0) = vs.cross(nt);
+                J_r.block<3, 1>(3, 0) = nt;
+                sum.AddRow(J_r, r, kernel.Weight(r));
+            };
+    double r2;
+    std::tie(JTJ, JTr, r2) = utility::ReduceJTJandJTr(
+            compute_jacobian_and_residual, num_points, false);
+    utility::LogDebug("Residual : {:.2e} (# of elements : {:d})",
+                      num_corres > 0 ? r2 / (double)num_corres : 0.0,
+                      num_corres);
+    return std::make_pair(num_corres, error2);
+}
+
+/// Point to plane ICP that linearizes the residuals during the
+/// correspondence search. The source is transformed on the fly, and the
+/// correspondence set is only built for the result.
+RegistrationResult RegistrationICPPointToPlane(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const geometry::KDTreeFlann &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init,
+        const TransformationEstimationPointToPlane &estimation,
+        const ICPConvergenceCriteria &criteria) {
+    RegistrationResult result(init);
+    const int num_points = (int)source.points_.size();
+    std::vector<int> target_index;
+    Eigen::Matrix6d JTJ;
+    Eigen::Vector6d JTr;
+    int num_corres = 0;
+    for (int i = 0;; i++) {
+        double error2;
+        std::tie(num_corres, error2) = LinearizePointToPlane(
+                source, target, target_kdtree, max_correspondence_distance,
+                result.transformation_, *estimation.kernel_, target_index, JTJ,
+                JTr);
+        const double prev_fitness = result.fitness_;
+        const double prev_inlier_rmse = result.inlier_rmse_;
+        result.fitness_ =
+                num_points > 0 ? (double)num_corres / (double)num_points : 0.0;
+        result.inlier_rmse_ =
+                num_corres > 0 ? std::sqrt(error2 / (double)num_corres) : 0.0;
+        if (i >= criteria.max_iteration_ ||
+            (i > 0 &&
+             std::abs(prev_fitness - result.fitness_) <
+                     criteria.relative_fitness_ &&
+             std::abs(prev_inlier_rmse - result.inlier_rmse_) <
+                     criteria.relative_rmse_)) {
+            break;
+        }
+        utility::LogDebug("ICP Iteration #{:d}: Fitness {:.4f}, RMSE {:.4f}", i,
+                          result.fitness_, result.inlier_rmse_);
+        bool is_success;
+        Eigen::Matrix4d update;
+        std::tie(is_success, update) =
+                utility::SolveJacobianSystemAndObtainExtrinsicMatrix(JTJ, JTr);
+        if (is_success) {
+            result.transformation_ = update * result.transformation_;
+        }
+    }
+    result.correspondence_set_.reserve(num_corres);
+    for (int i = 0; i < num_points; i++) {
+        if (target_index[i] >= 0) {
+            result.correspondence_set_.push_back(
+                    Eigen::Vector2i(i, target_index[i]));
+        }
     }
     return result;
 }
@@ -102,18 +242,24 @@ RegistrationResult EvaluateRANSACBasedOnCorrespondence(
         const geometry::PointCloud &target,
         const CorrespondenceSet &corres,
         double max_correspondence_distance,
-        const Eigen::Matrix4d &transformation) {
+        const Eigen::Matrix4d &transformation,
+        bool get_correspondences) {
     RegistrationResult result(transformation);
+    const Eigen::Matrix3d rotation = transformation.block<3, 3>(0, 0);
+    const Eigen::Vector3d translation = transformation.block<3, 1>(0, 3);
     double error2 = 0.0;
     int good = 0;
     double max_dis2 = max_correspondence_distance * max_correspondence_distance;
     for (const auto &c : corres) {
-        double dis2 =
-                (source.points_[c[0]] - target.points_[c[1]]).squaredNorm();
+        double dis2 = (rotation * source.points_[c[0]] + translation -
+                       target.points_[c[1]])
+                              .squaredNorm();
         if (dis2 < max_dis2) {
             good++;
             error2 += dis2;
-            result.correspondence_set_.push_back(c);
+            if (get_correspondences) {
+                result.correspondence_set_.push_back(c);
+            }
         }
     }
     if (good == 0) {
@@ -126,34 +272,83 @@ RegistrationResult EvaluateRANSACBasedOnCorrespondence(
     return result;
 }
 
-}  // unnamed namespace
-
-namespace registration {
-RegistrationResult EvaluateRegistration(
+/// Validates a RANSAC hypothesis on the source points listed in sample,
+/// transforming them on the fly. Returns the number of inliers, or -1 without
+/// a result as soon as the hypothesis cannot reach min_inliers inliers
+/// anymore. indices and dists are reused across calls to avoid allocations.
+int EvaluateRANSACBasedOnFeatureMatching(
         const geometry::PointCloud &source,
-        const geometry::PointCloud &target,
+        const geometry::KDTreeFlann &target_kdtree,
+        const std::vector<int> &sample,
         double max_correspondence_distance,
-        const Eigen::Matrix4d
-                &transformation /* = Eigen::Matrix4d::Identity()*/) {
-    geometry::KDTreeFlann kdtree;
-    kdtree.SetGeometry(target);
-    geometry::PointCloud pcd = source;
-    if (transformation.isIdentity() == false) {
-        pcd.Transform(transformation);
+        const Eigen::Matrix4d &transformation,
+        int min_inliers,
+        std::vector<int> &indices,
+        std::vector<double> &dists,
+        RegistrationResult &result) {
+    const Eigen::Matrix3d rotation = transformation.block<3, 3>(0, 0);
+    const Eigen::Vector3d translation = transformation.block<3, 1>(0, 3);
+    const int sample_size = (int)sample.size();
+    double error2 = 0.0;
+    int inliers = 0;
+    for (int i = 0; i < sample_size; i++) {
+        if (inliers + sample_size - i < min_inliers) {
+            return -1;
+        }
+        const Eigen::Vector3d point =
+                rotation * source.points_[sample[i]] + translation;
+        if (target_kdtree.SearchHybrid(point, max_correspondence_distance, 1,
+                                       indices, dists) > 0) {
+            inliers++;
+            error2 += dists[0];
+        }
     }
-    return GetRegistrationResultAndCorrespondences(
-            pcd, target, kdtree, max_correspondence_distance, transformation);
+    if (inliers < min_inliers) {
+        return -1;
+    }
+    result = RegistrationResult(transformation);
+    if (inliers > 0) {
+        result.fitness_ = (double)inliers / (double)sample_size;
+        result.inlier_rmse_ = std::sqrt(error2 / (double)inliers);
+    }
+    return inliers;
 }
 
-RegistrationResult RegistrationICP(
+/// Returns the fraction of the putative feature correspondences
+/// (i, similar_features[i]) that transformation aligns within
+/// max_correspondence_distance, the inlier ratio of the RANSAC samples.
+double GetFeatureMatchingInlierRatio(const geometry::PointCloud &source,
+                                     const geometry::PointCloud &target,
+                                     const std::vector<int> &similar_features,
+                                     double max_correspondence_distance,
+                                     const Eigen::Matrix4d &transformation) {
+    if (similar_features.empty()) {
+        return 0.0;
+    }
+    const Eigen::Matrix3d rotation = transformation.block<3, 3>(0, 0);
+    const Eigen::Vector3d translation = transformation.block<3, 1>(0, 3);
+    const double max_dis2 =
+            max_correspondence_distance * max_correspondence_distance;
+    int inliers = 0;
+    for (size_t i = 0; i < similar_features.size(); i++) {
+        if ((rotation * source.points_[i] + translation -
+             target.points_[similar_features[i]])
+                    .squaredNorm() < max_dis2) {
+            inliers++;
+        }
+    }
+    return (double)inliers / (double)similar_features.size();
+}
+
+/// RegistrationICP with a prebuilt KDTree of the target.
+RegistrationResult RegistrationICPWithKDTree(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
+        const geometry::KDTreeFlann &kdtree,
         double max_correspondence_distance,
-        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
-        const TransformationEstimation &estimation
-        /* = TransformationEstimationPointToPoint(false)*/,
-        const ICPConvergenceCriteria
-                &criteria /* = ICPConvergenceCriteria()*/) {
+        const Eigen::Matrix4d &init,
+        const TransformationEstimation &estimation,
+        const ICPConvergenceCriteria &criteria) {
     if (max_correspondence_distance <= 0.0) {
         utility::LogError("Invalid max_correspondence_distance.");
     }
@@ -168,16 +363,30 @@ RegistrationResult RegistrationICP(
                 "require pre-computed normal vectors.");
     }
 
+    // Subclasses may override ComputeTransformation, so only the exact class
+    // takes the fused path.
+    if (typeid(estimation) == typeid(TransformationEstimationPointToPlane)) {
+        return RegistrationICPPointToPlane(
+                source, target, kdtree, max_correspondence_distance, init,
+                static_cast<const TransformationEstimationPointToPlane &>(
+                        estimation),
+                criteria);
+    }
+
     Eigen::Matrix4d transformation = init;
-    geometry::KDTreeFlann kdtree;
-    kdtree.SetGeometry(target);
     geometry::PointCloud pcd = source;
     if (init.isIdentity() == false) {
         pcd.Transform(init);
     }
+    // The correspondence set and the search buffers are reused across
+    // iterations.
+    std::vector<int> indices;
+    std::vector<double> dists;
+    std::vector<int> offsets;
     RegistrationResult result;
-    result = GetRegistrationResultAndCorrespondences(
-            pcd, target, kdtree, max_correspondence_distance, transformation);
+    UpdateRegistrationResultAndCorrespondences(
+            pcd, kdtree, max_correspondence_distance, transformation, indices,
+            dists, offsets, result);
     for (int i = 0; i < criteria.max_iteration_; i++) {
         utility::LogDebug("ICP Iteration #{:d}: Fitness {:.4f}, RMSE {:.4f}", i,
                           result.fitness_, result.inlier_rmse_);
@@ -185,13 +394,14 @@ RegistrationResult RegistrationICP(
                 pcd, target, result.correspondence_set_);
         transformation = update * transformation;
         pcd.Transform(update);
-        RegistrationResult backup = result;
-        result = GetRegistrationResultAndCorrespondences(
-                pcd, target, kdtree, max_correspondence_distance,
-                transformation);
-        if (std::abs(backup.fitness_ - result.fitness_) <
+        const double prev_fitness = result.fitness_;
+        const double prev_inlier_rmse = result.inlier_rmse_;
+        UpdateRegistrationResultAndCorrespondences(
+                pcd, kdtree, max_correspondence_distance, transformation,
+                indices, dists, offsets, result);
+        if (std::abs(prev_fitness - result.fitness_) <
                     criteria.relative_fitness_ &&
-            std::abs(backup.inlier_rmse_ - result.inlier_rmse_) <
+            std::abs(prev_inlier_rmse - result.inlier_rmse_) <
                     criteria.relative_rmse_) {
             break;
         }
@@ -199,6 +409,129 @@ RegistrationResult RegistrationICP(
     return result;
 }
 
+/// Estimates the normals of a level of multi-scale ICP from the neighbors
+/// within twice its voxel size, or from the 30 nearest neighbors at full
+/// resolution.
+void EstimateNormalsAtVoxelSize(geometry::PointCloud &pcd, double voxel_size) {
+    if (voxel_size > 0.0) {
+        pcd.EstimateNormals(
+                geometry::KDTreeSearchParamHybrid(2.0 * voxel_size, 30));
+    } else {
+        pcd.EstimateNormals(geometry::KDTreeSearchParamKNN(30));
+    }
+}
+
+}  // unnamed namespace
+
+namespace registration {
+RegistrationResult EvaluateRegistration(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d
+                &transformation /* = Eigen::Matrix4d::Identity()*/) {
+    geometry::KDTreeFlann kdtree;
+    kdtree.SetGeometry(target);
+    geometry::PointCloud pcd = source;
+    if (transformation.isIdentity() == false) {
+        pcd.Transform(transformation);
+    }
+    return GetRegistrationResultAndCorrespondences(
+            pcd, target, kdtree, max_correspondence_distance, transformation);
+}
+
+RegistrationResult RegistrationICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        const ICPConvergenceCriteria
+                &criteria /* = ICPConvergenceCriteria()*/) {
+    geometry::KDTreeFlann kdtree;
+    kdtree.SetGeometry(target);
+    return RegistrationICPWithKDTree(source, target, kdtree,
+                                     max_correspondence_distance, init,
+                                     estimation, criteria);
+}
+
+ICPTargetPyramid::ICPTargetPyramid(const geometry::PointCloud &target,
+                                   const std::vector<double> &voxel_sizes)
+    : voxel_sizes_(voxel_sizes) {
+    for (double voxel_size : voxel_sizes_) {
+        std::shared_ptr<geometry::PointCloud> points =
+                voxel_size > 0.0
+                        ? target.VoxelDownSample(voxel_size)
+                        : std::make_shared<geometry::PointCloud>(target);
+        if (!points->HasNormals()) {
+            EstimateNormalsAtVoxelSize(*points, voxel_size);
+        }
+        auto kdtree = std::make_shared<geometry::KDTreeFlann>();
+        kdtree->SetGeometryReference(*points);
+        points_.push_back(points);
+        kdtrees_.push_back(kdtree);
+    }
+}
+
+ICPTargetPyramid::~ICPTargetPyramid() {}
+
+RegistrationResult RegistrationMultiScaleICP(
+        const geometry::PointCloud &source,
+        const ICPTargetPyramid &target,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria_list,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/) {
+    if (target.NumLevels() == 0 ||
+        max_correspondence_distances.size() != target.NumLevels() ||
+        criteria_list.size() != target.NumLevels()) {
+        utility::LogError(
+                "[RegistrationMultiScaleICP] Every level of the target needs "
+                "one max_correspondence_distance and one criteria.");
+    }
+    const bool need_normals =
+            estimation.GetTransformationEstimationType() ==
+                    TransformationEstimationType::PointToPlane ||
+            estimation.GetTransformationEstimationType() ==
+                    TransformationEstimationType::ColoredICP;
+    RegistrationResult result(init);
+    for (size_t level = 0; level < target.NumLevels(); level++) {
+        const double voxel_size = target.voxel_sizes_[level];
+        std::shared_ptr<geometry::PointCloud> downsampled;
+        if (voxel_size > 0.0) {
+            downsampled = source.VoxelDownSample(voxel_size);
+        } else if (need_normals && !source.HasNormals()) {
+            downsampled = std::make_shared<geometry::PointCloud>(source);
+        }
+        if (downsampled && need_normals && !downsampled->HasNormals()) {
+            EstimateNormalsAtVoxelSize(*downsampled, voxel_size);
+        }
+        utility::LogDebug("Multi-scale ICP level {:d}, voxel size {:f}",
+                          (int)level, voxel_size);
+        result = RegistrationICPWithKDTree(
+                downsampled ? *downsampled : source, *target.points_[level],
+                *target.kdtrees_[level], max_correspondence_distances[level],
+                result.transformation_, estimation, criteria_list[level]);
+    }
+    return result;
+}
+
+RegistrationResult RegistrationMultiScaleICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const std::vector<double> &voxel_sizes,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria_list,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/) {
+    return RegistrationMultiScaleICP(
+            source, ICPTargetPyramid(target, voxel_sizes),
+            max_correspondence_distances, criteria_list, init, estimation);
+}
+
 RegistrationResult RegistrationRANSACBasedOnCorrespondence(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -216,27 +549,35 @@ RegistrationResult RegistrationRANSACBasedOnCorrespondence(
     Eigen::Matrix4d transformation;
     CorrespondenceSet ransac_corres(ransac_n);
     RegistrationResult result;
+    int max_iteration = criteria.max_iteration_;
+    std::mt19937 rng(utility::GetRANSACSeed(criteria.seed_));
+    std::uniform_int_distribution<int> distribution(0, (int)corres.size() - 1);
 
-    for (int itr = 0;
-         itr < criteria.max_iteration_ && itr < criteria.max_validation_;
+    for (int itr = 0; itr < max_iteration && itr < criteria.max_validation_;
          itr++) {
         for (int j = 0; j < ransac_n; j++) {
-            ransac_corres[j] =
-                    corres[utility::UniformRandInt(0, corres.size() - 1)];
+            ransac_corres[j] = corres[distribution(rng)];
         }
         transformation =
                 estimation.ComputeTransformation(source, target, ransac_corres);
-        geometry::PointCloud pcd = source;
-        pcd.Transform(transformation);
         auto this_result = EvaluateRANSACBasedOnCorrespondence(
-                pcd, target, corres, max_correspondence_distance,
-                transformation);
+                source, target, corres, max_correspondence_distance,
+                transformation, false);
         if (this_result.fitness_ > result.fitness_ ||
             (this_result.fitness_ == result.fitness_ &&
              this_result.inlier_rmse_ < result.inlier_rmse_)) {
             result = this_result;
+            max_iteration = utility::GetRANSACIterations(
+                    criteria.confidence_, result.fitness_, ransac_n,
+                    max_iteration);
         }
     }
+    // Only the correspondences of the best hypothesis are collected.
+    if (result.fitness_ > 0.0) {
+        result = EvaluateRANSACBasedOnCorrespondence(
+                source, target, corres, max_correspondence_distance,
+                result.transformation_, true);
+    }
     utility::LogDebug("RANSAC: Fitness {:e}, RMSE {:e}", result.fitness_,
                       result.inlier_rmse_);
     return result;
@@ -255,55 +596,74 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
                 &checkers /* = {}*/,
         const RANSACConvergenceCriteria &criteria
         /* = RANSACConvergenceCriteria()*/) {
-    if (ransac_n < 3 || max_correspondence_distance <= 0.0) {
+    if (ransac_n < 3 || max_correspondence_distance <= 0.0 ||
+        source.points_.empty() || target_feature.Num() == 0) {
         return RegistrationResult();
     }
 
+    // Hypotheses are validated on the same random permutation of the source
+    // points, or of a subset of them. Source points are visited in random
+    // order so that validations of bad hypotheses stop early. Iterations are
+    // claimed in blocks of kRANSACIterationBlockSize, and each block draws its
+    // samples from a generator seeded with the seed and the block number, so
+    // the sample of an iteration does not depend on the thread running it.
+    const unsigned int seed = utility::GetRANSACSeed(criteria.seed_);
+    std::vector<int> sample(source.points_.size());
+    std::iota(sample.begin(), sample.end(), 0);
+    std::shuffle(sample.begin(), sample.end(), std::mt19937(seed));
+    if (criteria.validation_sample_size_ > 0 &&
+        criteria.validation_sample_size_ < (int)sample.size()) {
+        sample.resize(criteria.validation_sample_size_);
+    }
+
+    // The nearest target feature of every source feature is found up front
+    // by a batched search. The tree is only read in the parallel region and
+    // shared by threads.
+    const std::vector<int> similar_features =
+            FindNearestFeatures(source_feature, target_feature);
+    geometry::KDTreeFlann kdtree(target);
     RegistrationResult result;
+    int result_inliers = 0;
+    int total_iteration = 0;
+    std::atomic<int> next_block(0);
+    std::atomic<int> max_iteration(criteria.max_iteration_);
+    double best_inlier_ratio = 0.0;
     int total_validation = 0;
-    bool finished_validation = false;
-    int num_similar_features = 1;
-    std::vector<std::vector<int>> similar_features(source.points_.size());
+    std::atomic<bool> finished_validation(false);
 
 #ifdef _OPENMP
 #pragma omp parallel
     {
 #endif
         CorrespondenceSet ransac_corres(ransac_n);
-        geometry::KDTreeFlann kdtree(target);
-        geometry::KDTreeFlann kdtree_feature(target_feature);
         RegistrationResult result_private;
+        int result_private_inliers = 0;
+        double result_private_inlier_ratio = 0.0;
+        RegistrationResult this_result;
+        std::vector<int> indices;
+        std::vector<double> dists;
+        std::uniform_int_distribution<int> distribution(
+                0, (int)source.points_.size() - 1);
+        int total_iteration_private = 0;
 
-#ifdef _OPENMP
-#pragma omp for nowait
-#endif
-        for (int itr = 0; itr < criteria.max_iteration_; itr++) {
-            if (!finished_validation) {
-                std::vector<double> dists(num_similar_features);
+        // Threads take blocks of iterations until the shared budget, which
+        // shrinks as better hypotheses are found, is used up.
+        while (!finished_validation) {
+            const int block = next_block++;
+            const int begin = block * kRANSACIterationBlockSize;
+            if (begin >= max_iteration) break;
+            std::seed_seq seed_seq{seed, (unsigned int)block};
+            std::mt19937 rng(seed_seq);
+            for (int iteration = begin;
+                 iteration < begin + kRANSACIterationBlockSize &&
+                 iteration < max_iteration && !finished_validation;
+                 iteration++) {
+                total_iteration_private++;
                 Eigen::Matrix4d transformation;
                 for (int j = 0; j < ransac_n; j++) {
-                    int source_sample_id = utility::UniformRandInt(
-                            0, source.points_.size() - 1);
-                    if (similar_features[source_sample_id].empty()) {
-                        std::vector<int> indices(num_similar_features);
-                        kdtree_feature.SearchKNN(
-                                Eigen::VectorXd(source_feature.data_.col(
-                                        source_sample_id)),
-                                num_similar_features, indices, dists);
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-                        { similar_features[source_sample_id] = indices; }
-                    }
+                    int source_sample_id = distribution(rng);
                     ransac_corres[j](0) = source_sample_id;
-                    if (num_similar_features == 1)
-                        ransac_corres[j](1) =
-                                similar_features[source_sample_id][0];
-                    else {
-                        ransac_corres[j](1) = similar_features
-                                [source_sample_id][utility::UniformRandInt(
-                                        0, num_similar_features - 1)];
-                    }
+                    ransac_corres[j](1) = similar_features[source_sample_id];
                 }
                 bool check = true;
                 for (const auto &checker : checkers) {
@@ -327,15 +687,25 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
                     }
                 }
                 if (check == false) continue;
-                geometry::PointCloud pcd = source;
-                pcd.Transform(transformation);
-                auto this_result = GetRegistrationResultAndCorrespondences(
-                        pcd, target, kdtree, max_correspondence_distance,
-                        transformation);
-                if (this_result.fitness_ > result_private.fitness_ ||
-                    (this_result.fitness_ == result_private.fitness_ &&
-                     this_result.inlier_rmse_ < result_private.inlier_rmse_)) {
-                    result_private = this_result;
+                // Ties in the number of inliers are broken by the rmse, so
+                // only hypotheses with fewer inliers are rejected early.
+                const int this_inliers = EvaluateRANSACBasedOnFeatureMatching(
+                        source, kdtree, sample, max_correspondence_distance,
+                        transformation, result_private_inliers, indices, dists,
+                        this_result);
+                if (this_inliers >= 0) {
+                    if (this_inliers > result_private_inliers ||
+                        (this_inliers == result_private_inliers &&
+                         this_result.inlier_rmse_ <
+                                 result_private.inlier_rmse_)) {
+                        result_private = this_result;
+                        result_private_inliers = this_inliers;
+                        result_private_inlier_ratio =
+                                GetFeatureMatchingInlierRatio(
+                                        source, target, similar_features,
+                                        max_correspondence_distance,
+                                        transformation);
+                    }
                 }
 #ifdef _OPENMP
 #pragma omp critical
@@ -344,23 +714,44 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
                     total_validation = total_validation + 1;
                     if (total_validation >= criteria.max_validation_)
                         finished_validation = true;
+                    // The budget follows the inlier ratio of the feature
+                    // correspondences the samples are drawn from, not the
+                    // geometric overlap.
+                    if (result_private_inlier_ratio > best_inlier_ratio) {
+                        best_inlier_ratio = result_private_inlier_ratio;
+                        max_iteration = utility::GetRANSACIterations(
+                                criteria.confidence_, best_inlier_ratio,
+                                ransac_n, max_iteration);
+                    }
                 }
-            }  // end of if statement
-        }      // end of for-loop
+            }
+        }
 #ifdef _OPENMP
 #pragma omp critical
 #endif
         {
-            if (result_private.fitness_ > result.fitness_ ||
-                (result_private.fitness_ == result.fitness_ &&
+            total_iteration += total_iteration_private;
+            if (result_private_inliers > result_inliers ||
+                (result_private_inliers == result_inliers &&
                  result_private.inlier_rmse_ < result.inlier_rmse_)) {
                 result = result_private;
+                result_inliers = result_private_inliers;
             }
         }
 #ifdef _OPENMP
     }
 #endif
-    utility::LogDebug("total_validation : {:d}", total_validation);
+    // Only the best hypothesis is validated on all source points with its
+    // correspondences.
+    if (result_inliers > 0) {
+        geometry::PointCloud pcd = source;
+        pcd.Transform(result.transformation_);
+        result = GetRegistrationResultAndCorrespondences(
+                pcd, target, kdtree, max_correspondence_distance,
+                result.transformation_);
+    }
+    utility::LogDebug("total_iteration : {:d}, total_validation : {:d}",
+                      total_iteration, total_validation);
     utility::LogDebug("RANSAC: Fitness {:e}, RMSE {:e}", result.fitness_,
                       result.inlier_rmse_);
     return result;
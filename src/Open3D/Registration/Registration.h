@@ -27,6 +27,7 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -37,6 +38,7 @@
 namespace open3d {
 
 namespace geometry {
+class KDTreeFlann;
 class PointCloud;
 }
 
@@ -69,16 +71,36 @@ public:
 /// Note that the validation is the most computational expensive operator in an
 /// iteration. Most iterations do not do full validation. It is crucial to
 /// control max_validation_ so that the computation time is acceptable.
+/// In feature matching based RANSAC, a validation stops as soon as the
+/// hypothesis cannot beat the best one anymore. It runs on
+/// validation_sample_size_ random source points, or on all of them if
+/// validation_sample_size_ is not positive.
+/// RANSAC also stops once it has drawn an outlier-free sample with
+/// probability confidence_, estimated from the fitness of the best hypothesis
+/// so far. A confidence_ of 1 runs all the iterations.
+/// The samples and the validation order are drawn from seed_. With a single
+/// thread, the same seed gives the same result. A negative seed is drawn at
+/// random.
 class RANSACConvergenceCriteria {
 public:
     RANSACConvergenceCriteria(int max_iteration = 1000,
-                              int max_validation = 1000)
-        : max_iteration_(max_iteration), max_validation_(max_validation) {}
+                              int max_validation = 1000,
+                              int validation_sample_size = 0,
+                              double confidence = 1.0,
+                              int seed = -1)
+        : max_iteration_(max_iteration),
+          max_validation_(max_validation),
+          validation_sample_size_(validation_sample_size),
+          confidence_(confidence),
+          seed_(seed) {}
     ~RANSACConvergenceCriteria() {}
 
 public:
     int max_iteration_;
     int max_validation_;
+    int validation_sample_size_;
+    double confidence_;
+    int seed_;
 };
 
 /// Class that contains the registration results
@@ -96,6 +118,31 @@ public:
     double fitness_;
 };
 
+/// Class that holds the target of a multi-scale ICP. Every level is the
+/// target downsampled with one voxel size, with normals and a KDTree. It is
+/// built once, and can be shared by any number of registrations against the
+/// same target.
+class ICPTargetPyramid {
+public:
+    /// Builds one level per voxel size, from the coarsest to the finest. A
+    /// level with a non-positive voxel size keeps all the points of target.
+    /// If target has no normals, they are estimated from the neighbors within
+    /// twice the voxel size, or from the 30 nearest neighbors at full
+    /// resolution.
+    ICPTargetPyramid(const geometry::PointCloud &target,
+                     const std::vector<double> &voxel_sizes);
+    ~ICPTargetPyramid();
+
+public:
+    size_t NumLevels() const { return voxel_sizes_.size(); }
+
+public:
+    std::vector<double> voxel_sizes_;
+    std::vector<std::shared_ptr<geometry::PointCloud>> points_;
+    /// KDTrees that reference the points of the levels.
+    std::vector<std::shared_ptr<geometry::KDTreeFlann>> kdtrees_;
+};
+
 /// Function for evaluation
 RegistrationResult EvaluateRegistration(
         const geometry::PointCloud &source,
@@ -113,6 +160,33 @@ RegistrationResult RegistrationICP(
                 TransformationEstimationPointToPoint(false),
         const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
 
+/// Function for multi-scale ICP registration against a target pyramid. The
+/// source is downsampled with the voxel size of every level, and aligned to
+/// it with RegistrationICP, starting from the transformation of the previous
+/// level. Returns the result of the last level, whose fitness and
+/// correspondences refer to the downsampled source.
+RegistrationResult RegistrationMultiScaleICP(
+        const geometry::PointCloud &source,
+        const ICPTargetPyramid &target,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria_list,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false));
+
+/// Function for multi-scale ICP registration, which builds the target pyramid
+/// for voxel_sizes. Build an ICPTargetPyramid to reuse it across
+/// registrations.
+RegistrationResult RegistrationMultiScaleICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const std::vector<double> &voxel_sizes,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria_list,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false));
+
 /// Function for global RANSAC registration based on a given set of
 /// correspondences
 RegistrationResult RegistrationRANSACBasedOnCorrespondence(
@@ -0,0 +1,104 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+namespace open3d {
+namespace registration {
+
+/// \class RobustKernel
+///
+/// \brief Base class of the robust kernels (M-estimators) that reduce the
+/// influence of outliers in least squares problems.
+///
+/// The problems are solved by iteratively reweighted least squares: residual
+/// r gets the weight rho'(r) / r of the kernel rho.
+class RobustKernel {
+public:
+    virtual ~RobustKernel() {}
+
+public:
+    /// Returns the weight of residual.
+    virtual double Weight(double residual) const = 0;
+};
+
+/// \class L2Loss
+///
+/// \brief The squared loss rho(r) = r^2 / 2, which weights all residuals
+/// equally.
+class L2Loss : public RobustKernel {
+public:
+    double Weight(double residual) const override;
+};
+
+/// \class HuberLoss
+///
+/// \brief The Huber loss, quadratic for residuals up to k_ and linear beyond.
+class HuberLoss : public RobustKernel {
+public:
+    explicit HuberLoss(double k) : k_(k) {}
+
+public:
+    double Weight(double residual) const override;
+
+public:
+    /// Scale of the inlier residuals.
+    double k_;
+};
+
+/// \class CauchyLoss
+///
+/// \brief The Cauchy loss rho(r) = k^2 / 2 log(1 + (r / k)^2), whose weights
+/// decrease smoothly with the residual.
+class CauchyLoss : public RobustKernel {
+public:
+    explicit CauchyLoss(double k) : k_(k) {}
+
+public:
+    double Weight(double residual) const override;
+
+public:
+    /// Scale of the inlier residuals.
+    double k_;
+};
+
+/// \class TukeyLoss
+///
+/// \brief Tukey's biweight loss, which ignores residuals larger than k_.
+class TukeyLoss : public RobustKernel {
+public:
+    explicit TukeyLoss(double k) : k_(k) {}
+
+public:
+    double Weight(double residual) const override;
+
+public:
+    /// Largest residual of an inlier.
+    double k_;
+};
+
+}  // namespace registration
+}  // namespace open3d
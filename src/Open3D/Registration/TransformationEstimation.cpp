@@ -81,22 +81,23 @@ Eigen::Matrix4d TransformationEstimationPointToPlane::ComputeTransformation(
     if (corres.empty() || target.HasNormals() == false)
         return Eigen::Matrix4d::Identity();
 
-    auto compute_jacobian_and_residual = [&](int i, Eigen::Vector6d &J_r,
-                                             double &r) {
-        const Eigen::Vector3d &vs = source.points_[corres[i][0]];
-        const Eigen::Vector3d &vt = target.points_[corres[i][1]];
-        const Eigen::Vector3d &nt = target.normals_[corres[i][1]];
-        r = (vs - vt).dot(nt);
-        J_r.block<3, 1>(0, 0) = vs.cross(nt);
-        J_r.block<3, 1>(3, 0) = nt;
-    };
+    auto compute_jacobian_and_residual =
+            [&](int i, utility::JTJandJTrAccumulator &sum) {
+                const Eigen::Vector3d &vs = source.points_[corres[i][0]];
+                const Eigen::Vector3d &vt = target.points_[corres[i][1]];
+                const Eigen::Vector3d &nt = target.normals_[corres[i][1]];
+                const double r = (vs - vt).dot(nt);
+                Eigen::Vector6d J_r;
+                J_r.block<3, 1>(0, 0) = vs.cross(nt);
+                J_r.block<3, 1>(3, 0) = nt;
+                sum.AddRow(J_r, r, kernel_->Weight(r));
+            };
 
     Eigen::Matrix6d JTJ;
     Eigen::Vector6d JTr;
     double r2;
-    std::tie(JTJ, JTr, r2) =
-            utility::ComputeJTJandJTr<Eigen::Matrix6d, Eigen::Vector6d>(
-                    compute_jacobian_and_residual, (int)corres.size());
+    std::tie(JTJ, JTr, r2) = utility::ReduceJTJandJTr(
+            compute_jacobian_and_residual, (int)corres.size());
 
     bool is_success;
     Eigen::Matrix4d extrinsic;
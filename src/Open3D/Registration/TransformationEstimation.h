@@ -31,6 +31,8 @@
 #include <string>
 #include <vector>
 
+#include "Open3D/Registration/RobustKernel.h"
+
 namespace open3d {
 
 namespace geometry {
@@ -96,10 +98,14 @@ private:
             TransformationEstimationType::PointToPoint;
 };
 
-/// Estimate a transformation for point to plane distance
+/// Estimate a transformation for point to plane distance. The residuals are
+/// weighted by a robust kernel, the squared loss by default.
 class TransformationEstimationPointToPlane : public TransformationEstimation {
 public:
     TransformationEstimationPointToPlane() {}
+    explicit TransformationEstimationPointToPlane(
+            std::shared_ptr<RobustKernel> kernel)
+        : kernel_(std::move(kernel)) {}
     ~TransformationEstimationPointToPlane() override {}
 
 public:
@@ -115,6 +121,10 @@ public:
             const geometry::PointCloud &target,
             const CorrespondenceSet &corres) const override;
 
+public:
+    /// Robust kernel weighting the point to plane residuals.
+    std::shared_ptr<RobustKernel> kernel_ = std::make_shared<L2Loss>();
+
 private:
     const TransformationEstimationType type_ =
             TransformationEstimationType::PointToPlane;
@@ -31,6 +31,12 @@
 #include <tuple>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Open3D/Utility/Console.h"
+
 namespace Eigen {
 
 /// Extending Eigen namespace by adding frequently used matrix type
@@ -113,6 +119,120 @@ std::tuple<MatType, VecType, double> ComputeJTJandJTr(
         int iteration_num,
         bool verbose = true);
 
+/// Sum of the rows of a Jacobian with 6 columns. Only the 21 entries of the
+/// upper triangle of JTJ are summed, and the products are spelled out so that
+/// the compiler keeps the sums in registers.
+class JTJandJTrAccumulator {
+public:
+    JTJandJTrAccumulator() { SetZero(); }
+
+public:
+    void SetZero() {
+        for (int k = 0; k < 28; k++) sum_[k] = 0.0;
+    }
+
+    /// Adds the row J_r with residual r and weight w.
+    void AddRow(const Eigen::Vector6d &J_r, double r, double w = 1.0) {
+        const double J0 = J_r(0), J1 = J_r(1), J2 = J_r(2);
+        const double J3 = J_r(3), J4 = J_r(4), J5 = J_r(5);
+        const double wJ0 = w * J0, wJ1 = w * J1, wJ2 = w * J2;
+        const double wJ3 = w * J3, wJ4 = w * J4, wJ5 = w * J5;
+        sum_[0] += wJ0 * J0;
+        sum_[1] += wJ0 * J1;
+        sum_[2] += wJ0 * J2;
+        sum_[3] += wJ0 * J3;
+        sum_[4] += wJ0 * J4;
+        sum_[5] += wJ0 * J5;
+        sum_[6] += wJ1 * J1;
+        sum_[7] += wJ1 * J2;
+        sum_[8] += wJ1 * J3;
+        sum_[9] += wJ1 * J4;
+        sum_[10] += wJ1 * J5;
+        sum_[11] += wJ2 * J2;
+        sum_[12] += wJ2 * J3;
+        sum_[13] += wJ2 * J4;
+        sum_[14] += wJ2 * J5;
+        sum_[15] += wJ3 * J3;
+        sum_[16] += wJ3 * J4;
+        sum_[17] += wJ3 * J5;
+        sum_[18] += wJ4 * J4;
+        sum_[19] += wJ4 * J5;
+        sum_[20] += wJ5 * J5;
+        sum_[21] += wJ0 * r;
+        sum_[22] += wJ1 * r;
+        sum_[23] += wJ2 * r;
+        sum_[24] += wJ3 * r;
+        sum_[25] += wJ4 * r;
+        sum_[26] += wJ5 * r;
+        sum_[27] += r * r;
+    }
+
+    void Add(const JTJandJTrAccumulator &other) {
+        for (int k = 0; k < 28; k++) sum_[k] += other.sum_[k];
+    }
+
+    /// Returns JTJ, JTr and the sum of r^2.
+    std::tuple<Eigen::Matrix6d, Eigen::Vector6d, double> GetJTJandJTr() const {
+        Eigen::Matrix6d JTJ;
+        Eigen::Vector6d JTr;
+        int k = 0;
+        for (int a = 0; a < 6; a++) {
+            for (int b = a; b < 6; b++, k++) {
+                JTJ(a, b) = JTJ(b, a) = sum_[k];
+            }
+            JTr(a) = sum_[21 + a];
+        }
+        return std::make_tuple(JTJ, JTr, sum_[27]);
+    }
+
+private:
+    /// Upper triangle of JTJ in row-major order, JTr and the sum of r^2.
+    double sum_[28];
+};
+
+/// Function to compute JTJ and JTr with an inlined functor
+/// Input: functor f and total number of rows of Jacobian matrix
+/// Output: JTJ, JTr, sum of r^2
+/// Note: f(i, accumulator) adds the rows of element i with
+/// JTJandJTrAccumulator::AddRow. Each thread sums a contiguous block of the
+/// elements, and the sums of the threads are added pairwise, so the result
+/// only depends on the number of threads.
+template <typename FuncType>
+std::tuple<Eigen::Matrix6d, Eigen::Vector6d, double> ReduceJTJandJTr(
+        const FuncType &f, int iteration_num, bool verbose = true) {
+#ifdef _OPENMP
+    std::vector<JTJandJTrAccumulator> sums(omp_get_max_threads());
+#pragma omp parallel
+    {
+        JTJandJTrAccumulator sum_private;
+#pragma omp for schedule(static)
+        for (int i = 0; i < iteration_num; i++) {
+            f(i, sum_private);
+        }
+        sums[omp_get_thread_num()] = sum_private;
+    }
+    const size_t num_sums = sums.size();
+    for (size_t stride = 1; stride < num_sums; stride *= 2) {
+        for (size_t i = 0; i + stride < num_sums; i += 2 * stride) {
+            sums[i].Add(sums[i + stride]);
+        }
+    }
+    const JTJandJTrAccumulator &sum = sums[0];
+#else
+    JTJandJTrAccumulator sum;
+    for (int i = 0; i < iteration_num; i++) {
+        f(i, sum);
+    }
+#endif
+    std::tuple<Eigen::Matrix6d, Eigen::Vector6d, double> result =
+            sum.GetJTJandJTr();
+    if (verbose) {
+        LogDebug("Residual : {:.2e} (# of elements : {:d})",
+                 std::get<2>(result) / (double)iteration_num, iteration_num);
+    }
+    return result;
+}
+
 Eigen::Matrix3d RotationMatrixX(double radians);
 Eigen::Matrix3d RotationMatrixY(double radians);
 Eigen::Matrix3d RotationMatrixZ(double radians);
@@ -26,7 +26,9 @@
 
 #include "Open3D/Utility/Helper.h"
 
+#include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <random>
 #include <unordered_set>
 
@@ -104,5 +106,25 @@ int UniformRandInt(const int min, const int max) {
     return distribution(generator);
 }
 
+int GetRANSACIterations(double confidence,
+                        double inlier_ratio,
+                        int sample_size,
+                        int max_iteration) {
+    if (confidence >= 1.0 || inlier_ratio <= 0.0) {
+        return max_iteration;
+    }
+    const double iterations =
+            std::log1p(-confidence) /
+            std::log1p(-std::pow(std::min(inlier_ratio, 1.0), sample_size));
+    if (!(iterations < max_iteration)) {
+        return max_iteration;
+    }
+    return std::max((int)std::ceil(iterations), 1);
+}
+
+unsigned int GetRANSACSeed(int seed) {
+    return seed < 0 ? std::random_device{}() : (unsigned int)seed;
+}
+
 }  // namespace utility
 }  // namespace open3d
@@ -133,5 +133,17 @@ void Sleep(int milliseconds);
 /// (inclusive)
 int UniformRandInt(const int min, const int max);
 
+/// Returns the number of RANSAC iterations needed to draw a sample of
+/// sample_size inliers with probability confidence, given the inlier ratio,
+/// capped at max_iteration.
+int GetRANSACIterations(double confidence,
+                        double inlier_ratio,
+                        int sample_size,
+                        int max_iteration);
+
+/// Returns seed as the seed of a RANSAC generator, or a random seed if seed is
+/// negative.
+unsigned int GetRANSACSeed(int seed);
+
 }  // namespace utility
 }  // namespace open3d
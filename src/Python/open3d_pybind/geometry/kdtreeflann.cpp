@@ -25,6 +25,8 @@
 // ----------------------------------------------------------------------------
 
 #include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/NeighborhoodGraph.h"
+#include "Open3D/Geometry/PointCloud.h"
 
 #include "open3d_pybind/docstring.h"
 #include "open3d_pybind/geometry/geometry.h"
@@ -119,7 +121,11 @@ void pybind_kdtreeflann(py::module &m) {
                      "At maximum, ``max_nn`` neighbors will be searched."},
                     {"knn", "``knn`` neighbors will be searched."},
                     {"feature", "Feature data."},
-                    {"data", "Matrix data."}};
+                    {"data", "Matrix data."},
+                    {"points",
+                     "Points added to a tree built with ``set_geometry``."},
+                    {"use_float32",
+                     "Store the points of the geometry in single precision."}};
     py::class_<geometry::KDTreeFlann, std::shared_ptr<geometry::KDTreeFlann>>
             kdtreeflann(m, "KDTreeFlann",
                         "KDTree with FLANN for nearest neighbor search.");
@@ -127,11 +133,13 @@ void pybind_kdtreeflann(py::module &m) {
             .def(py::init<const Eigen::MatrixXd &>(), "data"_a)
             .def("set_matrix_data", &geometry::KDTreeFlann::SetMatrixData,
                  "data"_a)
-            .def(py::init<const geometry::Geometry &>(), "geometry"_a)
+            .def(py::init<const geometry::Geometry &, bool>(), "geometry"_a,
+                 "use_float32"_a = false)
             .def("set_geometry", &geometry::KDTreeFlann::SetGeometry,
-                 "geometry"_a)
+                 "geometry"_a, "use_float32"_a = false)
             .def(py::init<const registration::Feature &>(), "feature"_a)
             .def("set_feature", &geometry::KDTreeFlann::SetFeature, "feature"_a)
+            .def("add_points", &geometry::KDTreeFlann::AddPoints, "points"_a)
             // Although these C++ style functions are fast by orders of
             // magnitudes when similar queries are performed for a large number
             // of times and memory management is involved, we prefer not to
@@ -249,6 +257,8 @@ void pybind_kdtreeflann(py::module &m) {
                      return std::make_tuple(k, indices, distance2);
                  },
                  "query"_a, "radius"_a, "max_nn"_a);
+    docstring::ClassMethodDocInject(m, "KDTreeFlann", "add_points",
+                                    map_kd_tree_flann_method_docs);
     docstring::ClassMethodDocInject(m, "KDTreeFlann", "search_hybrid_vector_3d",
                                     map_kd_tree_flann_method_docs);
     docstring::ClassMethodDocInject(m, "KDTreeFlann", "search_hybrid_vector_xd",
@@ -271,4 +281,36 @@ void pybind_kdtreeflann(py::module &m) {
                                     map_kd_tree_flann_method_docs);
     docstring::ClassMethodDocInject(m, "KDTreeFlann", "set_matrix_data",
                                     map_kd_tree_flann_method_docs);
+
+    // open3d.geometry.NeighborhoodGraph
+    py::class_<geometry::NeighborhoodGraph,
+               std::shared_ptr<geometry::NeighborhoodGraph>>
+            neighborhood_graph(m, "NeighborhoodGraph",
+                               "Neighbors of every point of a point cloud, "
+                               "in compressed sparse row layout.");
+    neighborhood_graph.def(py::init<>())
+            .def("__repr__",
+                 [](const geometry::NeighborhoodGraph &graph) {
+                     return std::string("geometry::NeighborhoodGraph with ") +
+                            std::to_string(graph.NumPoints()) + " points.";
+                 })
+            .def_static("create_from_point_cloud",
+                        &geometry::NeighborhoodGraph::CreateFromPointCloud,
+                        "Function to search the neighbors of all points of a "
+                        "point cloud.",
+                        "pointcloud"_a,
+                        "search_param"_a = geometry::KDTreeSearchParamKNN())
+            .def_readwrite("indices", &geometry::NeighborhoodGraph::indices_,
+                           "Indices of the neighbors of all points.")
+            .def_readwrite("distance2",
+                           &geometry::NeighborhoodGraph::distance2_,
+                           "Squared distances to the neighbors.")
+            .def_readwrite("offsets", &geometry::NeighborhoodGraph::offsets_,
+                           "The neighbors of point ``i`` are ``indices[offsets"
+                           "[i]:offsets[i + 1]]``.");
+    docstring::ClassMethodDocInject(
+            m, "NeighborhoodGraph", "create_from_point_cloud",
+            {{"pointcloud", "The input point cloud."},
+             {"search_param",
+              "The KDTree search parameters for neighborhood search."}});
 }
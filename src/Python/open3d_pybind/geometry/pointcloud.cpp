@@ -28,6 +28,7 @@
 
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
 #include "Open3D/Geometry/Image.h"
+#include "Open3D/Geometry/NeighborhoodGraph.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/RGBDImage.h"
 
@@ -46,6 +47,17 @@ void pybind_pointcloud(py::module &m) {
                        "normals.");
     py::detail::bind_default_constructor<geometry::PointCloud>(pointcloud);
     py::detail::bind_copy_functions<geometry::PointCloud>(pointcloud);
+    py::enum_<geometry::PointCloud::VoxelReduction>(pointcloud,
+                                                    "VoxelReduction")
+            .value("Mean", geometry::PointCloud::VoxelReduction::Mean,
+                   "The points and colors of a voxel are averaged, the "
+                   "normals are averaged and normalized.")
+            .value("Median", geometry::PointCloud::VoxelReduction::Median,
+                   "The component-wise medians of a voxel are taken, the "
+                   "normals are normalized.")
+            .value("First", geometry::PointCloud::VoxelReduction::First,
+                   "The first point of a voxel is kept.")
+            .export_values();
     pointcloud
             .def(py::init<const std::vector<Eigen::Vector3d> &>(),
                  "Create a PointCloud from points", "points"_a)
@@ -78,7 +90,8 @@ void pybind_pointcloud(py::module &m) {
                  "Function to downsample input pointcloud into output "
                  "pointcloud with "
                  "a voxel",
-                 "voxel_size"_a)
+                 "voxel_size"_a,
+                 "reduction"_a = geometry::PointCloud::VoxelReduction::Mean)
             .def("voxel_down_sample_and_trace",
                  &geometry::PointCloud::VoxelDownSampleAndTrace,
                  "Function to downsample using "
@@ -122,12 +135,29 @@ void pybind_pointcloud(py::module &m) {
                  "Function to remove points that are further away from their "
                  "neighbors in average",
                  "nb_neighbors"_a, "std_ratio"_a)
-            .def("estimate_normals", &geometry::PointCloud::EstimateNormals,
+            .def("estimate_normals",
+                 [](geometry::PointCloud &pcd,
+                    const geometry::KDTreeSearchParam &search_param,
+                    bool fast_normal_computation) {
+                     return pcd.EstimateNormals(search_param,
+                                                fast_normal_computation);
+                 },
                  "Function to compute the normals of a point cloud. Normals "
                  "are oriented with respect to the input point cloud if "
                  "normals exist",
                  "search_param"_a = geometry::KDTreeSearchParamKNN(),
                  "fast_normal_computation"_a = true)
+            .def("estimate_normals_from_graph",
+                 [](geometry::PointCloud &pcd,
+                    const geometry::NeighborhoodGraph &graph,
+                    bool fast_normal_computation) {
+                     return pcd.EstimateNormals(graph,
+                                                fast_normal_computation);
+                 },
+                 "Function to compute the normals of a point cloud from the "
+                 "neighbors in a graph created from it. Normals are oriented "
+                 "with respect to the input point cloud if normals exist",
+                 "graph"_a, "fast_normal_computation"_a = true)
             .def("orient_normals_to_align_with_direction",
                  &geometry::PointCloud::OrientNormalsToAlignWithDirection,
                  "Function to orient the normals of a point cloud",
@@ -175,7 +205,15 @@ void pybind_pointcloud(py::module &m) {
             .def("segment_plane", &geometry::PointCloud::SegmentPlane,
                  "Segments a plane in the point cloud using the RANSAC "
                  "algorithm.",
-                 "distance_threshold"_a, "ransac_n"_a, "num_iterations"_a)
+                 "distance_threshold"_a, "ransac_n"_a, "num_iterations"_a,
+                 "confidence"_a = 1.0, "seed"_a = -1)
+            .def("segment_planes", &geometry::PointCloud::SegmentPlanes,
+                 "Segments up to ``num_planes`` planes, largest first, by "
+                 "running segment_plane on the points that are not inliers of "
+                 "a previous plane.",
+                 "num_planes"_a, "distance_threshold"_a = 0.01,
+                 "ransac_n"_a = 3, "num_iterations"_a = 100,
+                 "confidence"_a = 1.0, "seed"_a = -1)
             .def_static(
                     "create_from_depth_image",
                     &geometry::PointCloud::CreateFromDepthImage,
@@ -233,6 +271,8 @@ void pybind_pointcloud(py::module &m) {
     docstring::ClassMethodDocInject(
             m, "PointCloud", "voxel_down_sample",
             {{"voxel_size", "Voxel size to downsample into."},
+             {"reduction",
+              "How the points, normals and colors of a voxel are reduced."},
              {"invert", "set to ``True`` to invert the selection of indices"}});
     docstring::ClassMethodDocInject(
             m, "PointCloud", "voxel_down_sample_and_trace",
@@ -267,6 +307,14 @@ void pybind_pointcloud(py::module &m) {
               "If true, the normal estiamtion uses a non-iterative method to "
               "extract the eigenvector from the covariance matrix. This is "
               "faster, but is not as numerical stable."}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "estimate_normals_from_graph",
+            {{"graph",
+              "The neighborhood graph, created from this point cloud."},
+             {"fast_normal_computation",
+              "If true, the normal estiamtion uses a non-iterative method to "
+              "extract the eigenvector from the covariance matrix. This is "
+              "faster, but is not as numerical stable."}});
     docstring::ClassMethodDocInject(
             m, "PointCloud", "orient_normals_to_align_with_direction",
             {{"orientation_reference",
@@ -307,7 +355,33 @@ void pybind_pointcloud(py::module &m) {
              {"ransac_n",
               "Number of initial points to be considered inliers in each "
               "iteration."},
-             {"num_iterations", "Number of iterations."}});
+             {"num_iterations", "Number of iterations."},
+             {"confidence",
+              "Stop once a sample of inliers has been drawn with this "
+              "probability, estimated from the best plane so far. 1 runs all "
+              "the iterations."},
+             {"seed",
+              "Seed of the random samples, which makes the result independent "
+              "of the number of threads. A negative seed is drawn at "
+              "random."}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "segment_planes",
+            {{"num_planes", "Maximum number of planes."},
+             {"distance_threshold",
+              "Max distance a point can be from the plane model, and still be "
+              "considered an inlier."},
+             {"ransac_n",
+              "Number of initial points to be considered inliers in each "
+              "iteration."},
+             {"num_iterations", "Number of iterations per plane."},
+             {"confidence",
+              "Stop once a sample of inliers has been drawn with this "
+              "probability, estimated from the best plane so far. 1 runs all "
+              "the iterations."},
+             {"seed",
+              "Seed of the random samples, which makes the result independent "
+              "of the number of threads. A negative seed is drawn at "
+              "random."}});
     docstring::ClassMethodDocInject(
             m, "PointCloud", "create_from_depth_image",
             {
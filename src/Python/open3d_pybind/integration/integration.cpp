@@ -53,6 +53,16 @@ public:
         PYBIND11_OVERLOAD_PURE(std::shared_ptr<geometry::TriangleMesh>,
                                TSDFVolumeBase, );
     }
+    typedef std::tuple<std::shared_ptr<geometry::Image>,
+                       std::shared_ptr<geometry::Image>,
+                       std::shared_ptr<geometry::Image>,
+                       std::shared_ptr<geometry::Image>>
+            RaycastImages;
+    RaycastImages Raycast(const camera::PinholeCameraIntrinsic &intrinsic,
+                          const Eigen::Matrix4d &extrinsic) override {
+        PYBIND11_OVERLOAD_PURE(RaycastImages, TSDFVolumeBase, intrinsic,
+                               extrinsic);
+    }
 };
 
 void pybind_integration_classes(py::module &m) {
@@ -95,6 +105,11 @@ In SIGGRAPH, 1996)");
             .def("extract_triangle_mesh",
                  &integration::TSDFVolume::ExtractTriangleMesh,
                  "Function to extract a triangle mesh")
+            .def("raycast", &integration::TSDFVolume::Raycast,
+                 "Function to render the depth, vertex map, normal map and "
+                 "color of the surface seen by a camera, by raycasting the "
+                 "volume",
+                 "intrinsic"_a, "extrinsic"_a)
             .def_readwrite("voxel_length",
                            &integration::TSDFVolume::voxel_length_,
                            "float: Voxel size.")
@@ -111,6 +126,10 @@ In SIGGRAPH, 1996)");
             {{"image", "RGBD image."},
              {"intrinsic", "Pinhole camera intrinsic parameters."},
              {"extrinsic", "Extrinsic parameters."}});
+    docstring::ClassMethodDocInject(
+            m, "TSDFVolume", "raycast",
+            {{"intrinsic", "Pinhole camera intrinsic parameters."},
+             {"extrinsic", "Extrinsic parameters."}});
     docstring::ClassMethodDocInject(m, "TSDFVolume", "reset");
 
     // open3d.integration.UniformTSDFVolume: open3d.integration.TSDFVolume
@@ -183,13 +202,16 @@ In SIGGRAPH, 2013)");
             .def(py::init([](double voxel_length, double sdf_trunc,
                              integration::TSDFVolumeColorType color_type,
                              int volume_unit_resolution,
-                             int depth_sampling_stride) {
+                             int depth_sampling_stride,
+                             bool skip_occluded_volume_units) {
                      return new integration::ScalableTSDFVolume(
                              voxel_length, sdf_trunc, color_type,
-                             volume_unit_resolution, depth_sampling_stride);
+                             volume_unit_resolution, depth_sampling_stride,
+                             skip_occluded_volume_units);
                  }),
                  "voxel_length"_a, "sdf_trunc"_a, "color_type"_a,
-                 "volume_unit_resolution"_a = 16, "depth_sampling_stride"_a = 4)
+                 "volume_unit_resolution"_a = 16, "depth_sampling_stride"_a = 4,
+                 "skip_occluded_volume_units"_a = false)
             .def("__repr__",
                  [](const integration::ScalableTSDFVolume &vol) {
                      return std::string("integration::ScalableTSDFVolume ") +
@@ -178,6 +178,47 @@ Anonymous submission.)");
             [](const odometry::RGBDOdometryJacobianFromHybridTerm &te) {
                 return std::string("RGBDOdometryJacobianFromHybridTerm");
             });
+
+    // open3d.odometry.RGBDOdometryTracker
+    py::class_<odometry::RGBDOdometryTracker> tracker(
+            m, "RGBDOdometryTracker",
+            "Class that estimates 6D rigid motion between consecutive RGBD "
+            "images of a stream. Each image is preprocessed once, and the "
+            "last image is kept as the keyframe.");
+    tracker.def(py::init<const camera::PinholeCameraIntrinsic &,
+                         const odometry::OdometryOption &>(),
+                "pinhole_camera_intrinsic"_a = camera::PinholeCameraIntrinsic(),
+                "option"_a = odometry::OdometryOption())
+            .def("track", &odometry::RGBDOdometryTracker::Track,
+                 "Function to estimate 6D rigid motion from the keyframe to "
+                 "the RGBD image, which then becomes the keyframe. Output: "
+                 "(is_success, 4x4 motion matrix, 6x6 information matrix).",
+                 "rgbd_image"_a, "odo_init"_a = Eigen::Matrix4d::Identity(),
+                 "jacobian"_a = odometry::RGBDOdometryJacobianFromHybridTerm())
+            .def("set_keyframe", &odometry::RGBDOdometryTracker::SetKeyframe,
+                 "Makes the RGBD image the keyframe without estimating "
+                 "motion.",
+                 "rgbd_image"_a)
+            .def("reset", &odometry::RGBDOdometryTracker::Reset,
+                 "Drops the keyframe.")
+            .def("has_keyframe", &odometry::RGBDOdometryTracker::HasKeyframe,
+                 "Returns ``True`` if there is a keyframe.")
+            .def("__repr__", [](const odometry::RGBDOdometryTracker &t) {
+                return std::string("odometry::RGBDOdometryTracker ") +
+                       (t.HasKeyframe() ? "with a keyframe"
+                                        : "without a keyframe");
+            });
+    docstring::ClassMethodDocInject(
+            m, "RGBDOdometryTracker", "track",
+            {{"rgbd_image", "The next RGBD image of the stream."},
+             {"odo_init", "Initial 4x4 motion matrix estimation."},
+             {"jacobian",
+              "The odometry Jacobian method to use. Can be "
+              "``odometry::RGBDOdometryJacobianFromHybridTerm()`` or "
+              "``odometry::RGBDOdometryJacobianFromColorTerm().``"}});
+    docstring::ClassMethodDocInject(
+            m, "RGBDOdometryTracker", "set_keyframe",
+            {{"rgbd_image", "The RGBD image to make the keyframe."}});
 }
 
 void pybind_odometry_methods(py::module &m) {
@@ -202,6 +243,31 @@ void pybind_odometry_methods(py::module &m) {
                      "``odometry::RGBDOdometryJacobianFromColorTerm().``"},
                     {"option", "Odometry hyper parameteres."},
             });
+    m.def("compute_projective_icp_odometry",
+          &odometry::ComputeProjectiveICPOdometry,
+          "Function to estimate 6D rigid motion from a depth image to the "
+          "vertex and normal maps of a model by point to plane ICP with "
+          "projective data association. Output: (is_success, 4x4 motion "
+          "matrix, 6x6 information matrix).",
+          "depth_source"_a, "vertex_map_target"_a, "normal_map_target"_a,
+          "pinhole_camera_intrinsic"_a = camera::PinholeCameraIntrinsic(),
+          "odo_init"_a = Eigen::Matrix4d::Identity(),
+          "option"_a = odometry::OdometryOption());
+    docstring::FunctionDocInject(
+            m, "compute_projective_icp_odometry",
+            {
+                    {"depth_source", "Source depth image."},
+                    {"vertex_map_target",
+                     "Target vertex map, a 3 channel float image in the "
+                     "target camera coordinates with NaN where the model is "
+                     "missing."},
+                    {"normal_map_target",
+                     "Target normal map, in the same format as the vertex "
+                     "map."},
+                    {"pinhole_camera_intrinsic", "Camera intrinsic parameters"},
+                    {"odo_init", "Initial 4x4 motion matrix estimation."},
+                    {"option", "Odometry hyper parameteres."},
+            });
 }
 
 void pybind_odometry(py::module &m) {
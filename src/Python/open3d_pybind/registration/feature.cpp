@@ -25,6 +25,7 @@
 // ----------------------------------------------------------------------------
 
 #include "Open3D/Registration/Feature.h"
+#include "Open3D/Geometry/NeighborhoodGraph.h"
 #include "Open3D/Geometry/PointCloud.h"
 
 #include "open3d_pybind/docstring.h"
@@ -45,7 +46,7 @@ void pybind_feature(py::module &m) {
             .def("num", &registration::Feature::Num,
                  "Returns number of points.")
             .def_readwrite("data", &registration::Feature::data_,
-                           "``dim x n`` float64 numpy array: Data buffer "
+                           "``dim x n`` float32 numpy array: Data buffer "
                            "storing features.")
             .def("__repr__", [](const registration::Feature &f) {
                 return std::string(
@@ -63,11 +64,46 @@ void pybind_feature(py::module &m) {
 }
 
 void pybind_feature_methods(py::module &m) {
-    m.def("compute_fpfh_feature", &registration::ComputeFPFHFeature,
+    m.def("compute_fpfh_feature",
+          [](const geometry::PointCloud &input,
+             const geometry::KDTreeSearchParam &search_param) {
+              return registration::ComputeFPFHFeature(input, search_param);
+          },
           "Function to compute FPFH feature for a point cloud", "input"_a,
           "search_param"_a);
     docstring::FunctionDocInject(
             m, "compute_fpfh_feature",
             {{"input", "The Input point cloud."},
              {"search_param", "KDTree KNN search parameter."}});
+    m.def("compute_fpfh_feature_from_graph",
+          [](const geometry::PointCloud &input,
+             const geometry::NeighborhoodGraph &graph) {
+              return registration::ComputeFPFHFeature(input, graph);
+          },
+          "Function to compute FPFH feature for a point cloud from the "
+          "neighbors in a graph created from it",
+          "input"_a, "graph"_a);
+    docstring::FunctionDocInject(
+            m, "compute_fpfh_feature_from_graph",
+            {{"input", "The Input point cloud."},
+             {"graph", "The neighborhood graph, created from input."}});
+    m.def("find_nearest_features", &registration::FindNearestFeatures,
+          "Function to find the index of the nearest reference feature of "
+          "every query feature",
+          "query"_a, "reference"_a);
+    docstring::FunctionDocInject(m, "find_nearest_features",
+                                 {{"query", "The query features."},
+                                  {"reference", "The reference features."}});
+    m.def("correspondences_from_features",
+          &registration::CorrespondencesFromFeatures,
+          "Function to find correspondences between two point clouds from "
+          "the nearest neighbors of their features",
+          "source_feature"_a, "target_feature"_a, "mutual_filter"_a = false);
+    docstring::FunctionDocInject(
+            m, "correspondences_from_features",
+            {{"source_feature", "Source point cloud feature."},
+             {"target_feature", "Target point cloud feature."},
+             {"mutual_filter",
+              "If true, only keeps the correspondences whose points are "
+              "nearest neighbors of each other in both directions."}});
 }
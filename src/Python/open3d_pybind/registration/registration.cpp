@@ -30,6 +30,7 @@
 #include "Open3D/Registration/CorrespondenceChecker.h"
 #include "Open3D/Registration/FastGlobalRegistration.h"
 #include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/RobustKernel.h"
 #include "Open3D/Registration/TransformationEstimation.h"
 #include "Open3D/Utility/Console.h"
 
@@ -126,15 +127,27 @@ void pybind_registration_classes(py::module &m) {
             "that the validation is the most computational expensive operator "
             "in an iteration. Most iterations do not do full validation. It is "
             "crucial to control ``max_validation`` so that the computation "
-            "time is acceptable.");
+            "time is acceptable. In feature matching based RANSAC, a "
+            "validation stops as soon as the hypothesis cannot beat the best "
+            "one, and runs on ``validation_sample_size`` random source points, "
+            "or on all of them if it is not positive. RANSAC also stops once "
+            "it has drawn an outlier-free sample with probability "
+            "``confidence``, estimated from the best fitness so far. The "
+            "samples and the validation order are drawn from ``seed``, so "
+            "that a single-threaded run can be reproduced.");
     py::detail::bind_copy_functions<registration::RANSACConvergenceCriteria>(
             ransac_criteria);
     ransac_criteria
-            .def(py::init([](int max_iteration, int max_validation) {
+            .def(py::init([](int max_iteration, int max_validation,
+                             int validation_sample_size, double confidence,
+                             int seed) {
                      return new registration::RANSACConvergenceCriteria(
-                             max_iteration, max_validation);
+                             max_iteration, max_validation,
+                             validation_sample_size, confidence, seed);
                  }),
-                 "max_iteration"_a = 1000, "max_validation"_a = 1000)
+                 "max_iteration"_a = 1000, "max_validation"_a = 1000,
+                 "validation_sample_size"_a = 0, "confidence"_a = 1.0,
+                 "seed"_a = -1)
             .def_readwrite(
                     "max_iteration",
                     &registration::RANSACConvergenceCriteria::max_iteration_,
@@ -144,15 +157,97 @@ void pybind_registration_classes(py::module &m) {
                     &registration::RANSACConvergenceCriteria::max_validation_,
                     "Maximum times the validation has been run before the "
                     "iteration stops.")
+            .def_readwrite("validation_sample_size",
+                           &registration::RANSACConvergenceCriteria::
+                                   validation_sample_size_,
+                           "Number of random source points a hypothesis is "
+                           "validated on, all of them if not positive.")
+            .def_readwrite(
+                    "confidence",
+                    &registration::RANSACConvergenceCriteria::confidence_,
+                    "Probability of drawing an outlier-free sample after "
+                    "which the iteration stops. 1 runs all the iterations.")
+            .def_readwrite("seed",
+                           &registration::RANSACConvergenceCriteria::seed_,
+                           "Seed of the random draws. A negative seed is "
+                           "drawn at random.")
             .def("__repr__",
                  [](const registration::RANSACConvergenceCriteria &c) {
                      return fmt::format(
                              "registration::RANSACConvergenceCriteria "
                              "class with max_iteration={:d}, "
-                             "and max_validation={:d}",
-                             c.max_iteration_, c.max_validation_);
+                             "max_validation={:d}, "
+                             "validation_sample_size={:d}, "
+                             "confidence={:f}, and seed={:d}",
+                             c.max_iteration_, c.max_validation_,
+                             c.validation_sample_size_, c.confidence_,
+                             c.seed_);
                  });
 
+    // open3d.registration.RobustKernel
+    py::class_<registration::RobustKernel,
+               std::shared_ptr<registration::RobustKernel>>
+            robust_kernel(m, "RobustKernel",
+                          "Base class of the robust kernels that weight the "
+                          "residuals of point to plane ICP.");
+    robust_kernel.def("weight", &registration::RobustKernel::Weight,
+                      "residual"_a, "Returns the weight of a residual.");
+
+    // open3d.registration.L2Loss: RobustKernel
+    py::class_<registration::L2Loss, std::shared_ptr<registration::L2Loss>,
+               registration::RobustKernel>
+            l2_loss(m, "L2Loss",
+                    "The squared loss, which weights all residuals equally.");
+    l2_loss.def(py::init<>())
+            .def("__repr__", [](const registration::L2Loss &rk) {
+                return std::string("registration::L2Loss");
+            });
+
+    // open3d.registration.HuberLoss: RobustKernel
+    py::class_<registration::HuberLoss,
+               std::shared_ptr<registration::HuberLoss>,
+               registration::RobustKernel>
+            huber_loss(m, "HuberLoss",
+                       "The Huber loss, quadratic for residuals up to ``k`` "
+                       "and linear beyond.");
+    huber_loss.def(py::init<double>(), "k"_a)
+            .def_readwrite("k", &registration::HuberLoss::k_,
+                           "Scale of the inlier residuals.")
+            .def("__repr__", [](const registration::HuberLoss &rk) {
+                return fmt::format("registration::HuberLoss with k={:f}",
+                                   rk.k_);
+            });
+
+    // open3d.registration.CauchyLoss: RobustKernel
+    py::class_<registration::CauchyLoss,
+               std::shared_ptr<registration::CauchyLoss>,
+               registration::RobustKernel>
+            cauchy_loss(m, "CauchyLoss",
+                        "The Cauchy loss, whose weights decrease smoothly "
+                        "with the residual.");
+    cauchy_loss.def(py::init<double>(), "k"_a)
+            .def_readwrite("k", &registration::CauchyLoss::k_,
+                           "Scale of the inlier residuals.")
+            .def("__repr__", [](const registration::CauchyLoss &rk) {
+                return fmt::format("registration::CauchyLoss with k={:f}",
+                                   rk.k_);
+            });
+
+    // open3d.registration.TukeyLoss: RobustKernel
+    py::class_<registration::TukeyLoss,
+               std::shared_ptr<registration::TukeyLoss>,
+               registration::RobustKernel>
+            tukey_loss(m, "TukeyLoss",
+                       "Tukey's biweight loss, which ignores residuals larger "
+                       "than ``k``.");
+    tukey_loss.def(py::init<double>(), "k"_a)
+            .def_readwrite("k", &registration::TukeyLoss::k_,
+                           "Largest residual of an inlier.")
+            .def("__repr__", [](const registration::TukeyLoss &rk) {
+                return fmt::format("registration::TukeyLoss with k={:f}",
+                                   rk.k_);
+            });
+
     // open3d.registration.TransformationEstimation
     py::class_<
             registration::TransformationEstimation,
@@ -236,11 +331,33 @@ Sets :math:`c = 1` if ``with_scaling`` is ``False``.
             registration::TransformationEstimationPointToPlane>(te_p2l);
     py::detail::bind_copy_functions<
             registration::TransformationEstimationPointToPlane>(te_p2l);
-    te_p2l.def(
-            "__repr__",
-            [](const registration::TransformationEstimationPointToPlane &te) {
-                return std::string("TransformationEstimationPointToPlane");
-            });
+    te_p2l.def(py::init([](std::shared_ptr<registration::RobustKernel> kernel) {
+                   if (!kernel) {
+                       throw std::runtime_error("kernel must not be None.");
+                   }
+                   return new registration::
+                           TransformationEstimationPointToPlane(
+                                   std::move(kernel));
+               }),
+               "kernel"_a)
+            .def("__repr__",
+                 [](const registration::TransformationEstimationPointToPlane
+                            &te) {
+                     return std::string("TransformationEstimationPointToPlane");
+                 })
+            .def_property(
+                    "kernel",
+                    [](const registration::TransformationEstimationPointToPlane
+                               &te) { return te.kernel_; },
+                    [](registration::TransformationEstimationPointToPlane &te,
+                       std::shared_ptr<registration::RobustKernel> kernel) {
+                        if (!kernel) {
+                            throw std::runtime_error(
+                                    "kernel must not be None.");
+                        }
+                        te.kernel_ = std::move(kernel);
+                    },
+                    "Robust kernel weighting the point to plane residuals.");
 
     // open3d.registration.CorrespondenceChecker
     py::class_<registration::CorrespondenceChecker,
@@ -379,17 +496,17 @@ must hold true for all edges.)");
                              bool decrease_mu,
                              double maximum_correspondence_distance,
                              int iteration_number, double tuple_scale,
-                             int maximum_tuple_count) {
+                             int maximum_tuple_count, int seed) {
                      return new registration::FastGlobalRegistrationOption(
                              division_factor, use_absolute_scale, decrease_mu,
                              maximum_correspondence_distance, iteration_number,
-                             tuple_scale, maximum_tuple_count);
+                             tuple_scale, maximum_tuple_count, seed);
                  }),
                  "division_factor"_a = 1.4, "use_absolute_scale"_a = false,
                  "decrease_mu"_a = false,
                  "maximum_correspondence_distance"_a = 0.025,
                  "iteration_number"_a = 64, "tuple_scale"_a = 0.95,
-                 "maximum_tuple_count"_a = 1000)
+                 "maximum_tuple_count"_a = 1000, "seed"_a = -1)
             .def_readwrite(
                     "division_factor",
                     &registration::FastGlobalRegistrationOption::
@@ -423,6 +540,10 @@ must hold true for all edges.)");
                            &registration::FastGlobalRegistrationOption::
                                    maximum_tuple_count_,
                            "float: Maximum tuple numbers.")
+            .def_readwrite(
+                    "seed", &registration::FastGlobalRegistrationOption::seed_,
+                    "int: Seed of the tuple sampling. A negative seed is "
+                    "drawn at random.")
             .def("__repr__",
                  [](const registration::FastGlobalRegistrationOption &c) {
                      return fmt::format(
@@ -434,11 +555,12 @@ must hold true for all edges.)");
                              "\nmaximum_correspondence_distance={}"
                              "\niteration_number={}"
                              "\ntuple_scale={}"
-                             "\nmaximum_tuple_count={}",
+                             "\nmaximum_tuple_count={}"
+                             "\nseed={}",
                              c.division_factor_, c.use_absolute_scale_,
                              c.decrease_mu_, c.maximum_correspondence_distance_,
                              c.iteration_number_, c.tuple_scale_,
-                             c.maximum_tuple_count_);
+                             c.maximum_tuple_count_, c.seed_);
                  });
 
     // open3d.registration.RegistrationResult
@@ -477,6 +599,34 @@ must hold true for all edges.)");
                         rr.fitness_, rr.inlier_rmse_,
                         rr.correspondence_set_.size());
             });
+
+    // open3d.registration.ICPTargetPyramid
+    py::class_<registration::ICPTargetPyramid,
+               std::shared_ptr<registration::ICPTargetPyramid>>
+            target_pyramid(m, "ICPTargetPyramid",
+                           "Class that holds the target of a multi-scale ICP, "
+                           "downsampled with one voxel size per level, with "
+                           "normals and a KDTree per level. It can be reused "
+                           "by any number of registrations against the same "
+                           "target.");
+    target_pyramid
+            .def(py::init<const geometry::PointCloud &,
+                          const std::vector<double> &>(),
+                 "target"_a, "voxel_sizes"_a,
+                 "Builds one level per voxel size, from the coarsest to the "
+                 "finest. A non-positive voxel size keeps all the points.")
+            .def("num_levels", &registration::ICPTargetPyramid::NumLevels,
+                 "Returns the number of levels.")
+            .def_readonly("voxel_sizes",
+                          &registration::ICPTargetPyramid::voxel_sizes_,
+                          "List of float: The voxel sizes of the levels.")
+            .def_readonly("points", &registration::ICPTargetPyramid::points_,
+                          "List of PointCloud: The downsampled targets.")
+            .def("__repr__", [](const registration::ICPTargetPyramid &tp) {
+                return fmt::format(
+                        "registration::ICPTargetPyramid with {:d} levels",
+                        tp.NumLevels());
+            });
 }
 
 // Registration functions have similar arguments, sharing arg docstrings
@@ -491,6 +641,7 @@ static const std::unordered_map<std::string, std::string>
                  "``registration::CorrespondenceCheckerBasedOnDistance``, "
                  "``registration::CorrespondenceCheckerBasedOnNormal``)"},
                 {"criteria", "Convergence criteria"},
+                {"criteria_list", "Convergence criteria of every level"},
                 {"estimation_method",
                  "Estimation method. One of "
                  "(``registration::TransformationEstimationPointToPoint``, "
@@ -499,12 +650,16 @@ static const std::unordered_map<std::string, std::string>
                 {"lambda_geometric", "lambda_geometric value"},
                 {"max_correspondence_distance",
                  "Maximum correspondence points-pair distance."},
+                {"max_correspondence_distances",
+                 "Maximum correspondence points-pair distance of every "
+                 "level."},
                 {"option", "Registration option"},
                 {"ransac_n", "Fit ransac with ``ransac_n`` correspondences"},
                 {"source_feature", "Source point cloud feature."},
                 {"source", "The source point cloud."},
                 {"target_feature", "Target point cloud feature."},
                 {"target", "The target point cloud."},
+                {"target_pyramid", "The target point cloud pyramid."},
                 {"transformation",
                  "The 4x4 transformation matrix to transform ``source`` to "
                  "``target``"}};
@@ -527,6 +682,27 @@ void pybind_registration_methods(py::module &m) {
     docstring::FunctionDocInject(m, "registration_icp",
                                  map_shared_argument_docstrings);
 
+    m.def("registration_multi_scale_icp",
+          [](const geometry::PointCloud &source,
+             const registration::ICPTargetPyramid &target_pyramid,
+             const std::vector<double> &max_correspondence_distances,
+             const std::vector<registration::ICPConvergenceCriteria>
+                     &criteria_list,
+             const Eigen::Matrix4d &init,
+             const registration::TransformationEstimation &estimation) {
+              return registration::RegistrationMultiScaleICP(
+                      source, target_pyramid, max_correspondence_distances,
+                      criteria_list, init, estimation);
+          },
+          "Function for multi-scale ICP registration, from the coarsest to "
+          "the finest level of a target pyramid",
+          "source"_a, "target_pyramid"_a, "max_correspondence_distances"_a,
+          "criteria_list"_a, "init"_a = Eigen::Matrix4d::Identity(),
+          "estimation_method"_a =
+                  registration::TransformationEstimationPointToPoint(false));
+    docstring::FunctionDocInject(m, "registration_multi_scale_icp",
+                                 map_shared_argument_docstrings);
+
     m.def("registration_colored_icp", &registration::RegistrationColoredICP,
           "Function for Colored ICP registration", "source"_a, "target"_a,
           "max_correspondence_distance"_a,
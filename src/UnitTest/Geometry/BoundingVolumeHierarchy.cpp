@@ -0,0 +1,188 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <utility>
+
+#include "Open3D/Geometry/BoundingVolumeHierarchy.h"
+#include "Open3D/Geometry/IntersectionTest.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Random boxes with extent in [0, 1] inside [0, 10]^3.
+void RandBoxes(int size,
+               int seed,
+               vector<Vector3d> &min_bounds,
+               vector<Vector3d> &max_bounds) {
+    vector<Vector3d> extents(size);
+    min_bounds.resize(size);
+    Rand(min_bounds, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0),
+         seed);
+    Rand(extents, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), seed + 1);
+    max_bounds.resize(size);
+    for (int i = 0; i < size; i++) {
+        max_bounds[i] = min_bounds[i] + extents[i];
+    }
+}
+
+}  // unnamed namespace
+
+TEST(BoundingVolumeHierarchy, SetBoundingBoxes) {
+    vector<Vector3d> min_bounds, max_bounds;
+    RandBoxes(1000, 0, min_bounds, max_bounds);
+
+    geometry::BoundingVolumeHierarchy bvh;
+    EXPECT_TRUE(bvh.IsEmpty());
+    EXPECT_TRUE(bvh.SetBoundingBoxes(min_bounds, max_bounds, 4));
+    EXPECT_FALSE(bvh.IsEmpty());
+
+    // Every primitive is referenced by exactly one leaf, and leaf bounds
+    // contain the bounds of their primitives.
+    vector<int> count(min_bounds.size(), 0);
+    for (const auto &node : bvh.nodes_) {
+        if (!node.IsLeaf()) {
+            EXPECT_LT(node.first_ + 1, int(bvh.nodes_.size()));
+            continue;
+        }
+        EXPECT_LE(node.size_, 4);
+        for (int i = node.first_; i < node.first_ + node.size_; i++) {
+            int idx = bvh.primitive_indices_[i];
+            count[idx]++;
+            ExpectLE(node.min_bound_, min_bounds[idx]);
+            ExpectGE(node.max_bound_, max_bounds[idx]);
+        }
+    }
+    for (size_t i = 0; i < count.size(); i++) {
+        EXPECT_EQ(count[i], 1);
+    }
+
+    vector<Vector3d> max_bounds_mismatch(10, Vector3d::Zero());
+    EXPECT_FALSE(bvh.SetBoundingBoxes(min_bounds, max_bounds_mismatch));
+    EXPECT_TRUE(bvh.IsEmpty());
+}
+
+TEST(BoundingVolumeHierarchy, SearchAABB) {
+    vector<Vector3d> min_bounds, max_bounds;
+    RandBoxes(1000, 0, min_bounds, max_bounds);
+    geometry::BoundingVolumeHierarchy bvh;
+    bvh.SetBoundingBoxes(min_bounds, max_bounds);
+
+    Vector3d query_min(2.0, 3.0, 4.0);
+    Vector3d query_max(5.0, 5.0, 6.0);
+    vector<int> ref_indices;
+    for (int i = 0; i < int(min_bounds.size()); i++) {
+        if (geometry::IntersectionTest::AABBAABB(min_bounds[i], max_bounds[i],
+                                                 query_min, query_max)) {
+            ref_indices.push_back(i);
+        }
+    }
+
+    vector<int> indices = bvh.SearchAABB(query_min, query_max);
+    sort(indices.begin(), indices.end());
+    EXPECT_FALSE(ref_indices.empty());
+    ExpectEQ(ref_indices, indices);
+}
+
+TEST(BoundingVolumeHierarchy, TraverseOverlappingPairs) {
+    vector<Vector3d> min_bounds0, max_bounds0, min_bounds1, max_bounds1;
+    RandBoxes(500, 0, min_bounds0, max_bounds0);
+    RandBoxes(300, 2, min_bounds1, max_bounds1);
+    geometry::BoundingVolumeHierarchy bvh0, bvh1;
+    bvh0.SetBoundingBoxes(min_bounds0, max_bounds0);
+    bvh1.SetBoundingBoxes(min_bounds1, max_bounds1);
+
+    auto traverse = [](const geometry::BoundingVolumeHierarchy &a,
+                       const geometry::BoundingVolumeHierarchy &b) {
+        vector<pair<int, int>> pairs;
+        a.TraverseOverlappingPairs(b, [&](int i, int j) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            { pairs.push_back(make_pair(i, j)); }
+            return true;
+        });
+        sort(pairs.begin(), pairs.end());
+        return pairs;
+    };
+
+    // Self traversal reports every overlapping pair i < j once.
+    vector<pair<int, int>> ref_pairs;
+    for (int i = 0; i < int(min_bounds0.size()); i++) {
+        for (int j = i + 1; j < int(min_bounds0.size()); j++) {
+            if (geometry::IntersectionTest::AABBAABB(
+                        min_bounds0[i], max_bounds0[i], min_bounds0[j],
+                        max_bounds0[j])) {
+                ref_pairs.push_back(make_pair(i, j));
+            }
+        }
+    }
+    EXPECT_FALSE(ref_pairs.empty());
+    EXPECT_TRUE(ref_pairs == traverse(bvh0, bvh0));
+
+    ref_pairs.clear();
+    for (int i = 0; i < int(min_bounds0.size()); i++) {
+        for (int j = 0; j < int(min_bounds1.size()); j++) {
+            if (geometry::IntersectionTest::AABBAABB(
+                        min_bounds0[i], max_bounds0[i], min_bounds1[j],
+                        max_bounds1[j])) {
+                ref_pairs.push_back(make_pair(i, j));
+            }
+        }
+    }
+    EXPECT_FALSE(ref_pairs.empty());
+    EXPECT_TRUE(ref_pairs == traverse(bvh0, bvh1));
+
+    // Returning false stops the traversal.
+    int num_calls = 0;
+    bvh0.TraverseOverlappingPairs(bvh1, [&](int i, int j) {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+        num_calls++;
+        return false;
+    });
+    EXPECT_GE(num_calls, 1);
+    EXPECT_LT(num_calls, int(ref_pairs.size()));
+}
+
+TEST(BoundingVolumeHierarchy, SetTriangleMesh) {
+    auto mesh = geometry::TriangleMesh::CreateSphere(1.0, 20);
+    geometry::BoundingVolumeHierarchy bvh(*mesh);
+    EXPECT_FALSE(bvh.IsEmpty());
+    EXPECT_EQ(bvh.primitive_indices_.size(), mesh->triangles_.size());
+    ExpectEQ(bvh.nodes_[0].min_bound_, mesh->GetMinBound());
+    ExpectEQ(bvh.nodes_[0].max_bound_, mesh->GetMaxBound());
+
+    geometry::BoundingVolumeHierarchy empty_bvh((geometry::TriangleMesh()));
+    EXPECT_TRUE(empty_bvh.IsEmpty());
+}
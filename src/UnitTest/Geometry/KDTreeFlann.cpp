@@ -24,6 +24,8 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <random>
+
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
@@ -144,3 +146,202 @@ TEST(KDTreeFlann, SearchHybrid) {
     ExpectEQ(ref_indices, indices);
     ExpectEQ(ref_distance2, distance2);
 }
+
+TEST(KDTreeFlann, SearchBatch) {
+    geometry::PointCloud pc;
+    pc.points_.resize(2000);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+    geometry::KDTreeFlann kdtree(pc);
+
+    vector<Vector3d> queries(600);
+    Rand(queries, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 1);
+    Map<const MatrixXd> queries_mat((const double*)queries.data(), 3,
+                                    queries.size());
+
+    // The radius is large enough for the unbounded search to exceed the
+    // initial capacity of its buffers.
+    vector<shared_ptr<geometry::KDTreeSearchParam>> params = {
+            make_shared<geometry::KDTreeSearchParamKNN>(30),
+            make_shared<geometry::KDTreeSearchParamRadius>(2.5),
+            make_shared<geometry::KDTreeSearchParamHybrid>(2.5, 30)};
+    for (const auto& param : params) {
+        vector<int> indices;
+        vector<double> distance2;
+        vector<int> offsets;
+        int result = kdtree.Search(queries_mat, *param, indices, distance2,
+                                   offsets);
+        EXPECT_EQ(result, int(indices.size()));
+        EXPECT_EQ(indices.size(), distance2.size());
+        ASSERT_EQ(offsets.size(), queries.size() + 1);
+        EXPECT_EQ(offsets.back(), result);
+        for (size_t i = 0; i < queries.size(); i++) {
+            vector<int> ref_indices;
+            vector<double> ref_distance2;
+            kdtree.Search(queries[i], *param, ref_indices, ref_distance2);
+            vector<int> query_indices(indices.begin() + offsets[i],
+                                      indices.begin() + offsets[i + 1]);
+            vector<double> query_distance2(
+                    distance2.begin() + offsets[i],
+                    distance2.begin() + offsets[i + 1]);
+            ExpectEQ(ref_indices, query_indices);
+            ExpectEQ(ref_distance2, query_distance2);
+        }
+    }
+}
+
+TEST(KDTreeFlann, SearchBatchStrided) {
+    // The flann index of a matrix is searched with queries that are rows of a
+    // larger matrix, a view with an outer stride.
+    MatrixXd data = MatrixXd::Random(3, 2000) * 5.0;
+    geometry::KDTreeFlann kdtree(data);
+    MatrixXd queries = MatrixXd::Random(5, 600) * 5.0;
+    const MatrixXd dense_queries = queries.topRows(3);
+
+    vector<shared_ptr<geometry::KDTreeSearchParam>> params = {
+            make_shared<geometry::KDTreeSearchParamKNN>(10),
+            make_shared<geometry::KDTreeSearchParamRadius>(1.0),
+            make_shared<geometry::KDTreeSearchParamHybrid>(1.0, 10)};
+    for (const auto& param : params) {
+        vector<int> indices, ref_indices;
+        vector<double> distance2, ref_distance2;
+        vector<int> offsets, ref_offsets;
+        int result = kdtree.Search(queries.topRows(3), *param, indices,
+                                   distance2, offsets);
+        int ref_result = kdtree.Search(dense_queries, *param, ref_indices,
+                                       ref_distance2, ref_offsets);
+        EXPECT_EQ(ref_result, result);
+        ExpectEQ(ref_indices, indices);
+        ExpectEQ(ref_distance2, distance2);
+        ExpectEQ(ref_offsets, offsets);
+    }
+}
+
+TEST(KDTreeFlann, SearchPointCloud3D) {
+    // Rand yields many equidistant points, whose order differs between the
+    // search structures.
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> distribution(0.0, 10.0);
+    geometry::PointCloud pc;
+    pc.points_.resize(2000);
+    for (auto& point : pc.points_) {
+        point << distribution(generator), distribution(generator),
+                distribution(generator);
+    }
+    // Matrix data is indexed with flann, point clouds with KDTree3D.
+    MatrixXd data = Map<const MatrixXd>((const double*)pc.points_.data(), 3,
+                                        pc.points_.size());
+    geometry::KDTreeFlann kdtree_flann(data);
+    geometry::KDTreeFlann kdtree(pc);
+    geometry::KDTreeFlann kdtree_float32(pc, true);
+
+    // Some queries lie outside of the bounding box of the points.
+    std::uniform_real_distribution<double> query_distribution(-1.0, 11.0);
+    vector<Vector3d> queries(200);
+    for (auto& query : queries) {
+        query << query_distribution(generator), query_distribution(generator),
+                query_distribution(generator);
+    }
+
+    vector<shared_ptr<geometry::KDTreeSearchParam>> params = {
+            make_shared<geometry::KDTreeSearchParamKNN>(30),
+            make_shared<geometry::KDTreeSearchParamRadius>(1.5),
+            make_shared<geometry::KDTreeSearchParamHybrid>(1.5, 30)};
+    for (const auto& param : params) {
+        for (const auto& query : queries) {
+            vector<int> ref_indices;
+            vector<double> ref_distance2;
+            int ref_result = kdtree_flann.Search(query, *param, ref_indices,
+                                                 ref_distance2);
+
+            vector<int> indices;
+            vector<double> distance2;
+            EXPECT_EQ(ref_result,
+                      kdtree.Search(query, *param, indices, distance2));
+            ExpectEQ(ref_indices, indices);
+            ExpectEQ(ref_distance2, distance2);
+
+            EXPECT_EQ(ref_result, kdtree_float32.Search(query, *param,
+                                                        indices, distance2));
+            ExpectEQ(ref_indices, indices);
+            ExpectEQ(ref_distance2, distance2, 1e-4);
+        }
+    }
+
+    VectorXd query4 = VectorXd::Zero(4);
+    vector<int> indices;
+    vector<double> distance2;
+    EXPECT_EQ(-1, kdtree.SearchKNN(query4, 1, indices, distance2));
+}
+
+TEST(KDTreeFlann, AddPoints) {
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<double> distribution(0.0, 10.0);
+    vector<Vector3d> points(3000);
+    for (auto& point : points) {
+        point << distribution(generator), distribution(generator),
+                distribution(generator);
+    }
+    // Concentrate the last points in a corner, which unbalances the trees
+    // they are added to.
+    for (size_t i = 2000; i < points.size(); i++) {
+        points[i] *= 0.1;
+    }
+    geometry::PointCloud pc;
+    pc.points_ = points;
+    geometry::KDTreeFlann kdtree(pc);
+
+    // Add the points in batches of different sizes, so that the trailing
+    // parts of the trees are merged and rebuilt several times.
+    geometry::PointCloud pc_added;
+    pc_added.points_.assign(points.begin(), points.begin() + 1000);
+    geometry::KDTreeFlann kdtree_added(pc_added);
+    geometry::KDTreeFlann kdtree_reference;
+    EXPECT_TRUE(kdtree_reference.SetGeometryReference(pc_added));
+    EXPECT_FALSE(kdtree_added.AddPointsReference(
+            Map<const Matrix3Xd>((const double*)points.data(), 3, 1000)));
+    EXPECT_FALSE(kdtree_reference.AddPoints(points));
+    vector<int> batch_sizes = {1, 7, 200, 12, 500, 30, 250, 999, 1};
+    size_t begin = 1000;
+    for (int batch_size : batch_sizes) {
+        vector<Vector3d> batch(points.begin() + begin,
+                               points.begin() + begin + batch_size);
+        EXPECT_TRUE(kdtree_added.AddPoints(batch));
+        pc_added.points_.insert(pc_added.points_.end(), batch.begin(),
+                                batch.end());
+        EXPECT_TRUE(kdtree_reference.AddPointsReference(
+                Map<const Matrix3Xd>((const double*)pc_added.points_.data(),
+                                     3, pc_added.points_.size())));
+        begin += batch_size;
+    }
+    ASSERT_EQ(begin, points.size());
+
+    vector<Vector3d> queries(200);
+    for (auto& query : queries) {
+        query << distribution(generator), distribution(generator),
+                distribution(generator);
+    }
+    vector<shared_ptr<geometry::KDTreeSearchParam>> params = {
+            make_shared<geometry::KDTreeSearchParamKNN>(30),
+            make_shared<geometry::KDTreeSearchParamRadius>(1.5),
+            make_shared<geometry::KDTreeSearchParamHybrid>(1.5, 30)};
+    for (const auto& param : params) {
+        for (const auto& query : queries) {
+            vector<int> ref_indices;
+            vector<double> ref_distance2;
+            int ref_result =
+                    kdtree.Search(query, *param, ref_indices, ref_distance2);
+
+            vector<int> indices;
+            vector<double> distance2;
+            EXPECT_EQ(ref_result,
+                      kdtree_added.Search(query, *param, indices, distance2));
+            ExpectEQ(ref_indices, indices);
+            ExpectEQ(ref_distance2, distance2);
+
+            EXPECT_EQ(ref_result, kdtree_reference.Search(query, *param,
+                                                          indices, distance2));
+            ExpectEQ(ref_indices, indices);
+            ExpectEQ(ref_distance2, distance2);
+        }
+    }
+}
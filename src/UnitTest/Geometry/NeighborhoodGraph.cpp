@@ -0,0 +1,90 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/NeighborhoodGraph.h"
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+TEST(NeighborhoodGraph, CreateFromPointCloud) {
+    geometry::PointCloud pc;
+    pc.points_.resize(1000);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+
+    geometry::KDTreeSearchParamHybrid param(1.5, 20);
+    auto graph = geometry::NeighborhoodGraph::CreateFromPointCloud(pc, param);
+    EXPECT_EQ(graph->NumPoints(), pc.points_.size());
+    EXPECT_EQ(graph->indices_.size(), size_t(graph->offsets_.back()));
+    EXPECT_EQ(graph->distance2_.size(), graph->indices_.size());
+
+    // The neighbors of every point are those of a single search.
+    geometry::KDTreeFlann kdtree(pc);
+    for (size_t i = 0; i < pc.points_.size(); i++) {
+        vector<int> indices;
+        vector<double> distance2;
+        int k = kdtree.Search(pc.points_[i], param, indices, distance2);
+        ASSERT_EQ(graph->NumNeighbors(i), k);
+        EXPECT_EQ(graph->indices_[graph->offsets_[i]], int(i));
+        for (int j = 0; j < k; j++) {
+            EXPECT_EQ(graph->indices_[graph->offsets_[i] + j], indices[j]);
+            EXPECT_EQ(graph->distance2_[graph->offsets_[i] + j],
+                      distance2[j]);
+        }
+    }
+
+    auto empty = geometry::NeighborhoodGraph::CreateFromPointCloud(
+            geometry::PointCloud());
+    EXPECT_EQ(empty->NumPoints(), 0u);
+}
+
+TEST(NeighborhoodGraph, EstimateNormals) {
+    geometry::PointCloud pc;
+    pc.points_.resize(1000);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+
+    geometry::KDTreeSearchParamKNN param(10);
+    geometry::PointCloud ref = pc;
+    ref.EstimateNormals(param);
+    auto graph = geometry::NeighborhoodGraph::CreateFromPointCloud(pc, param);
+    EXPECT_TRUE(pc.EstimateNormals(*graph));
+    ExpectEQ(ref.normals_, pc.normals_);
+
+    // Existing normals orient the new ones, as with a search parameter.
+    ref.normals_[0] *= -1.0;
+    pc.normals_[0] *= -1.0;
+    ref.EstimateNormals(param, false);
+    EXPECT_TRUE(pc.EstimateNormals(*graph, false));
+    ExpectEQ(ref.normals_, pc.normals_);
+
+    geometry::PointCloud other;
+    other.points_.resize(10);
+    EXPECT_FALSE(other.EstimateNormals(*graph));
+}
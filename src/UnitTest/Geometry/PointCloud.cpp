@@ -25,10 +25,12 @@
 // ----------------------------------------------------------------------------
 
 #include <algorithm>
+#include <random>
 
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
 #include "Open3D/Geometry/BoundingVolume.h"
 #include "Open3D/Geometry/Image.h"
+#include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/RGBDImage.h"
 #include "TestUtility/UnitTest.h"
@@ -527,6 +529,80 @@ TEST(PointCloud, VoxelDownSample) {
     ExpectEQ(ref_colors, output_pc->colors_);
 }
 
+TEST(PointCloud, VoxelDownSampleReduction) {
+    geometry::PointCloud pc;
+    pc.points_ = {{5.2, 0.3, 0.3},
+                  {0.1, 0.1, 0.1},
+                  {0.3, 0.4, 0.2},
+                  {5.4, 0.1, 0.1},
+                  {0.2, 0.5, 0.5}};
+    for (const auto& point : pc.points_) {
+        pc.colors_.push_back(point * 0.1);
+    }
+
+    // The output is ordered by voxel index, whatever the input order.
+    vector<Vector3d> ref_mean = {{0.2, 1.0 / 3.0, 0.8 / 3.0},
+                                 {5.3, 0.2, 0.2}};
+    vector<Vector3d> ref_median = {{0.2, 0.4, 0.2}, {5.3, 0.2, 0.2}};
+    vector<Vector3d> ref_first = {{0.1, 0.1, 0.1}, {5.2, 0.3, 0.3}};
+    vector<pair<geometry::PointCloud::VoxelReduction, vector<Vector3d>>>
+            reductions = {
+                    {geometry::PointCloud::VoxelReduction::Mean, ref_mean},
+                    {geometry::PointCloud::VoxelReduction::Median, ref_median},
+                    {geometry::PointCloud::VoxelReduction::First, ref_first}};
+    for (const auto& reduction : reductions) {
+        auto output_pc = pc.VoxelDownSample(1.0, reduction.first);
+        ExpectEQ(reduction.second, output_pc->points_);
+        vector<Vector3d> ref_colors = reduction.second;
+        for (auto& color : ref_colors) {
+            color *= 0.1;
+        }
+        ExpectEQ(ref_colors, output_pc->colors_);
+    }
+}
+
+TEST(PointCloud, VoxelDownSampleOrder) {
+    // Enough points for the parallel passes to use several chunks.
+    geometry::PointCloud pc;
+    pc.points_.resize(200000);
+    Rand(pc.points_, Zero3d, Vector3d(10.0, 10.0, 10.0), 0);
+    double voxel_size = 0.5;
+    auto output_pc = pc.VoxelDownSample(voxel_size);
+
+    Vector3d voxel_min_bound = pc.GetMinBound() - Vector3d::Constant(0.25);
+    vector<Vector3i> voxel_indices;
+    for (const auto& point : output_pc->points_) {
+        Vector3d ref_coord = (point - voxel_min_bound) / voxel_size;
+        voxel_indices.push_back(Vector3i(int(floor(ref_coord(0))),
+                                         int(floor(ref_coord(1))),
+                                         int(floor(ref_coord(2)))));
+    }
+    for (size_t i = 1; i < voxel_indices.size(); i++) {
+        EXPECT_TRUE(lexicographical_compare(
+                voxel_indices[i - 1].data(), voxel_indices[i - 1].data() + 3,
+                voxel_indices[i].data(), voxel_indices[i].data() + 3));
+    }
+
+    // Every point belongs to exactly one voxel of the output.
+    vector<int> count(output_pc->points_.size(), 0);
+    for (const auto& point : pc.points_) {
+        Vector3d ref_coord = (point - voxel_min_bound) / voxel_size;
+        Vector3i voxel_index(int(floor(ref_coord(0))),
+                             int(floor(ref_coord(1))),
+                             int(floor(ref_coord(2))));
+        auto it = lower_bound(voxel_indices.begin(), voxel_indices.end(),
+                              voxel_index,
+                              [](const Vector3i& a, const Vector3i& b) {
+                                  return lexicographical_compare(
+                                          a.data(), a.data() + 3, b.data(),
+                                          b.data() + 3);
+                              });
+        ASSERT_TRUE(it != voxel_indices.end() && *it == voxel_index);
+        count[it - voxel_indices.begin()]++;
+    }
+    EXPECT_LT(0, *min_element(count.begin(), count.end()));
+}
+
 TEST(PointCloud, UniformDownSample) {
     vector<Vector3d> ref = {{839.215686, 392.156863, 780.392157},
                             {364.705882, 509.803922, 949.019608},
@@ -1078,3 +1154,144 @@ TEST(PointCloud, SegmentPlane) {
 
     ExpectEQ(ref, output_pc->points_);
 }
+
+TEST(PointCloud, SegmentPlaneConfidence) {
+    // Points on the plane z = 0.5, followed by outliers.
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    geometry::PointCloud pc;
+    for (int i = 0; i < 1000; i++) {
+        pc.points_.push_back(Vector3d(uniform(rng), uniform(rng), 0.5));
+    }
+    for (int i = 0; i < 250; i++) {
+        pc.points_.push_back(
+                Vector3d(uniform(rng), uniform(rng), 0.6 + uniform(rng)));
+    }
+
+    // Stops after a few iterations instead of running the whole budget.
+    Eigen::Vector4d plane_model;
+    std::vector<size_t> inliers;
+    std::tie(plane_model, inliers) =
+            pc.SegmentPlane(0.01, 3, 100000000, 0.999);
+    ASSERT_EQ(1000u, inliers.size());
+    for (size_t i = 0; i < inliers.size(); i++) {
+        EXPECT_EQ(i, inliers[i]);
+    }
+    if (plane_model(2) < 0) {
+        plane_model = -plane_model;
+    }
+    ExpectEQ(Eigen::Vector4d(0.0, 0.0, 1.0, -0.5), plane_model);
+}
+
+TEST(PointCloud, SegmentPlaneSeed) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    geometry::PointCloud pc;
+    for (int i = 0; i < 1000; i++) {
+        pc.points_.push_back(Vector3d(uniform(rng), uniform(rng),
+                                      0.5 + 0.01 * uniform(rng)));
+    }
+    for (int i = 0; i < 1000; i++) {
+        pc.points_.push_back(
+                Vector3d(uniform(rng), uniform(rng), uniform(rng)));
+    }
+
+    // The same seed gives the same plane.
+    Eigen::Vector4d plane_model0, plane_model1;
+    std::vector<size_t> inliers0, inliers1;
+    std::tie(plane_model0, inliers0) = pc.SegmentPlane(0.01, 3, 200, 1.0, 7);
+    std::tie(plane_model1, inliers1) = pc.SegmentPlane(0.01, 3, 200, 1.0, 7);
+    ExpectEQ(plane_model0, plane_model1, 0.0);
+    EXPECT_EQ(inliers0, inliers1);
+}
+
+TEST(PointCloud, SegmentPlanes) {
+    // The floor and two walls of a room, with different numbers of points.
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uniform(0.1, 0.9);
+    geometry::PointCloud pc;
+    for (int i = 0; i < 500; i++) {
+        pc.points_.push_back(Vector3d(0.0, uniform(rng), uniform(rng)));
+    }
+    for (int i = 0; i < 2000; i++) {
+        pc.points_.push_back(Vector3d(uniform(rng), uniform(rng), 0.0));
+    }
+    for (int i = 0; i < 1000; i++) {
+        pc.points_.push_back(Vector3d(uniform(rng), 1.0, uniform(rng)));
+    }
+
+    auto planes = pc.SegmentPlanes(5, 0.01, 3, 1000, 0.999, 0);
+    ASSERT_EQ(3u, planes.size());
+    const std::vector<size_t> begins = {500, 2500, 0};
+    const std::vector<size_t> sizes = {2000, 1000, 500};
+    const std::vector<Vector3d> normals = {
+            {0.0, 0.0, 1.0}, {0.0, 1.0, 0.0}, {1.0, 0.0, 0.0}};
+    for (size_t p = 0; p < planes.size(); p++) {
+        const Eigen::Vector4d &plane_model = std::get<0>(planes[p]);
+        const std::vector<size_t> &inliers = std::get<1>(planes[p]);
+        EXPECT_NEAR(1.0, std::abs(plane_model.head<3>().dot(normals[p])),
+                    1e-6);
+        ASSERT_EQ(sizes[p], inliers.size());
+        for (size_t i = 0; i < inliers.size(); i++) {
+            EXPECT_EQ(begins[p] + i, inliers[i]);
+        }
+    }
+}
+
+TEST(PointCloud, ClusterDBSCAN) {
+    // Blobs of different densities, some of them touching, and noise.
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::normal_distribution<double> normal(0.0, 0.05);
+    geometry::PointCloud pc;
+    for (int b = 0; b < 8; b++) {
+        Vector3d center(uniform(rng), uniform(rng), uniform(rng));
+        for (int i = 0; i < 100 + 50 * b; i++) {
+            pc.points_.push_back(
+                    center + Vector3d(normal(rng), normal(rng), normal(rng)));
+        }
+    }
+    for (int i = 0; i < 500; i++) {
+        pc.points_.push_back(
+                Vector3d(uniform(rng), uniform(rng), uniform(rng)));
+    }
+    std::shuffle(pc.points_.begin(), pc.points_.end(), rng);
+
+    // Serial expansion of the clusters in the order of the points.
+    const double eps = 0.04;
+    const size_t min_points = 10;
+    geometry::KDTreeFlann kdtree(pc);
+    std::vector<std::vector<int>> nbs(pc.points_.size());
+    std::vector<double> dists2;
+    for (size_t idx = 0; idx < pc.points_.size(); idx++) {
+        kdtree.SearchRadius(pc.points_[idx], eps, nbs[idx], dists2);
+    }
+    std::vector<int> ref(pc.points_.size(), -2);
+    int cluster_label = 0;
+    for (size_t idx = 0; idx < pc.points_.size(); idx++) {
+        if (ref[idx] != -2) continue;
+        if (nbs[idx].size() < min_points) {
+            ref[idx] = -1;
+            continue;
+        }
+        std::vector<int> stack = {int(idx)};
+        while (!stack.empty()) {
+            int nb = stack.back();
+            stack.pop_back();
+            if (ref[nb] >= 0) continue;
+            ref[nb] = cluster_label;
+            if (nbs[nb].size() >= min_points) {
+                stack.insert(stack.end(), nbs[nb].begin(), nbs[nb].end());
+            }
+        }
+        cluster_label++;
+    }
+    ASSERT_GT(cluster_label, 1);
+    ASSERT_GT(std::count(ref.begin(), ref.end(), -1), 0);
+
+    EXPECT_EQ(ref, pc.ClusterDBSCAN(eps, min_points));
+    // Every point is a core point.
+    std::vector<int> labels = pc.ClusterDBSCAN(eps, 1);
+    EXPECT_EQ(0, *std::min_element(labels.begin(), labels.end()));
+    EXPECT_TRUE(geometry::PointCloud().ClusterDBSCAN(eps, min_points).empty());
+}
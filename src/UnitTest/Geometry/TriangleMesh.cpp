@@ -26,6 +26,7 @@
 
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Geometry/BoundingVolume.h"
+#include "Open3D/Geometry/IntersectionTest.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "TestUtility/UnitTest.h"
 
@@ -1075,6 +1076,53 @@ TEST(TriangleMesh, IsSelfIntersecting) {
     EXPECT_EQ(mesh1.IsSelfIntersecting(), true);
 }
 
+TEST(TriangleMesh, GetSelfIntersectingTriangles) {
+    EXPECT_TRUE(geometry::TriangleMesh::CreateSphere()
+                        ->GetSelfIntersectingTriangles()
+                        .empty());
+
+    // two boxes that are merged into one mesh intersect along their faces
+    auto mesh = geometry::TriangleMesh::CreateBox();
+    auto box = geometry::TriangleMesh::CreateBox();
+    box->Translate(Eigen::Vector3d(0.5, 0.5, 0.5));
+    *mesh += *box;
+
+    std::vector<Eigen::Vector2i> ref_pairs;
+    for (int tidx0 = 0; tidx0 < 12; tidx0++) {
+        for (int tidx1 = 12; tidx1 < 24; tidx1++) {
+            const Eigen::Vector3i &p = mesh->triangles_[tidx0];
+            const Eigen::Vector3i &q = mesh->triangles_[tidx1];
+            if (geometry::IntersectionTest::TriangleTriangle3d(
+                        mesh->vertices_[p(0)], mesh->vertices_[p(1)],
+                        mesh->vertices_[p(2)], mesh->vertices_[q(0)],
+                        mesh->vertices_[q(1)], mesh->vertices_[q(2)])) {
+                ref_pairs.push_back(Eigen::Vector2i(tidx0, tidx1));
+            }
+        }
+    }
+    std::vector<Eigen::Vector2i> pairs = mesh->GetSelfIntersectingTriangles();
+    EXPECT_FALSE(pairs.empty());
+    unit_test::ExpectEQ(ref_pairs, pairs);
+}
+
+TEST(TriangleMesh, IsIntersecting) {
+    auto box0 = geometry::TriangleMesh::CreateBox();
+    auto box1 = geometry::TriangleMesh::CreateBox();
+    box1->Translate(Eigen::Vector3d(0.5, 0.5, 0.5));
+    auto box2 = geometry::TriangleMesh::CreateBox();
+    box2->Translate(Eigen::Vector3d(2.0, 0.0, 0.0));
+    auto sphere = geometry::TriangleMesh::CreateSphere(0.1);
+    sphere->Translate(Eigen::Vector3d(0.5, 0.5, 0.5));
+
+    EXPECT_TRUE(box0->IsIntersecting(*box1));
+    EXPECT_TRUE(box1->IsIntersecting(*box0));
+    EXPECT_FALSE(box0->IsIntersecting(*box2));
+    // the sphere is inside of the box, bounding boxes overlap but triangles
+    // do not intersect
+    EXPECT_TRUE(box0->IsBoundingBoxIntersecting(*sphere));
+    EXPECT_FALSE(box0->IsIntersecting(*sphere));
+}
+
 TEST(TriangleMesh, ClusterConnectedTriangles) {
     geometry::TriangleMesh mesh;
     mesh.vertices_ = {
@@ -0,0 +1,166 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "Open3D/IO/FileFormat/FileASCII.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace unit_test;
+
+TEST(FileASCII, ParseASCIIDouble) {
+    // Fast path and strtod fallback agree with strtod.
+    std::vector<std::string> strs = {"0",
+                                     "-0",
+                                     "+1",
+                                     "1.",
+                                     ".5",
+                                     "3.14159",
+                                     "-2e10",
+                                     "1E-22",
+                                     "1e23",
+                                     "1e-300",
+                                     "nan",
+                                     "-inf",
+                                     "0x1p3",
+                                     "1.5x",
+                                     "9007199254740993",
+                                     "12345678901234567890123",
+                                     "0.1000000000000000055511151231257827"};
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-30, 30);
+    char str[64];
+    for (int i = 0; i < 1000; i++) {
+        snprintf(str, sizeof(str), "%.*fe%d", 1 + i % 17, uniform(rng),
+                 exponent(rng));
+        strs.push_back(str);
+    }
+    for (const auto &s : strs) {
+        char *end;
+        const double ref = std::strtod(s.c_str(), &end);
+        double value;
+        const char *ptr = io::ParseASCIIDouble(s.c_str(), value);
+        ASSERT_NE(ptr, nullptr) << s;
+        EXPECT_EQ(ptr, end) << s;
+        if (ref == ref) {
+            EXPECT_EQ(ref, value) << s;
+            EXPECT_EQ(std::signbit(ref), std::signbit(value)) << s;
+        } else {
+            EXPECT_NE(value, value) << s;
+        }
+    }
+
+    double value;
+    EXPECT_EQ(io::ParseASCIIDouble("abc", value), nullptr);
+    EXPECT_EQ(io::ParseASCIIDouble("-", value), nullptr);
+    EXPECT_EQ(io::ParseASCIIDouble("\n1", value), nullptr);
+}
+
+TEST(FileASCII, AppendASCIIDouble) {
+    std::vector<double> values = {0.1,    -2.5,  1e-300, 1e300, -0.0,
+                                  100.0,  1e21,  1e22,   1e-6,  1e-7,
+                                  1.0 / 3.0, 5e-324, 1e20};
+    std::vector<std::string> ref_strs = {
+            "0.1",      "-2.5",   "1e-300",   "1e300",
+            "-0",       "100",    "1e21",
+            "1e22",     "0.000001", "1e-7",   "0.3333333333333333",
+            "5e-324",   "100000000000000000000"};
+    for (size_t i = 0; i < values.size(); i++) {
+        std::string str;
+        io::AppendASCIIDouble(str, values[i]);
+        EXPECT_EQ(ref_strs[i], str);
+    }
+
+    // Random finite doubles of every magnitude read back exactly.
+    std::mt19937_64 rng(0);
+    for (int i = 0; i < 100000; i++) {
+        std::uint64_t bits = rng();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value)) {
+            continue;
+        }
+        std::string str;
+        io::AppendASCIIDouble(str, value);
+        EXPECT_EQ(value, std::strtod(str.c_str(), nullptr)) << str;
+    }
+}
+
+TEST(FileASCII, WriteReadASCIIRows) {
+    // Rows span several formatting blocks and parsing pieces.
+    const size_t num_rows = 100003;
+    const std::string file_name = "tmp.txt";
+    FILE *file = fopen(file_name.c_str(), "w");
+    auto format_row = [](size_t i, std::string &buffer) {
+        if (i % 10 == 3) {
+            buffer += "invalid row\n";
+            return;
+        }
+        io::AppendASCIIInt(buffer, (int)i);
+        buffer += ' ';
+        io::AppendASCIIDouble(buffer, i / 7.0);
+        buffer += '\n';
+    };
+    EXPECT_TRUE(io::WriteASCIIRows(file, num_rows, format_row));
+    fclose(file);
+
+    std::vector<double> values;
+    auto append_rows = [&values](const double *row_values, size_t num_rows) {
+        values.insert(values.end(), row_values, row_values + 2 * num_rows);
+    };
+    file = fopen(file_name.c_str(), "r");
+    EXPECT_TRUE(io::ReadASCIIRows(file, 2, append_rows));
+    fclose(file);
+    size_t k = 0;
+    for (size_t i = 0; i < num_rows; i++) {
+        if (i % 10 != 3) {
+            ASSERT_LT(2 * k + 1, values.size());
+            EXPECT_EQ((double)i, values[2 * k]);
+            EXPECT_EQ(i / 7.0, values[2 * k + 1]);
+            k++;
+        }
+    }
+    EXPECT_EQ(2 * k, values.size());
+
+    // Invalid rows are zeros, and reading stops after max_num_rows rows.
+    values.clear();
+    file = fopen(file_name.c_str(), "r");
+    EXPECT_TRUE(io::ReadASCIIRows(file, 2, append_rows, false, 1000));
+    fclose(file);
+    ASSERT_EQ(2000u, values.size());
+    EXPECT_EQ(0.0, values[2 * 3]);
+    EXPECT_EQ(0.0, values[2 * 3 + 1]);
+    EXPECT_EQ(999.0, values[2 * 999]);
+    std::remove(file_name.c_str());
+}
@@ -24,8 +24,53 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+geometry::PointCloud CreateRandomPointCloud(int num_points) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::uniform_int_distribution<int> byte(0, 255);
+    geometry::PointCloud pointcloud;
+    for (int i = 0; i < num_points; i++) {
+        pointcloud.points_.push_back(Eigen::Vector3d(
+                uniform(rng), uniform(rng), uniform(rng)));
+        pointcloud.normals_.push_back(Eigen::Vector3d(
+                uniform(rng), uniform(rng), uniform(rng)));
+        // Colors that are exactly representable by 8 bit channels.
+        pointcloud.colors_.push_back(
+                Eigen::Vector3d(byte(rng), byte(rng), byte(rng)) / 255.0);
+    }
+    return pointcloud;
+}
+
+void WriteReadAndAssertEqual(const geometry::PointCloud &pointcloud,
+                             bool write_ascii,
+                             bool compressed) {
+    const std::string file_name = "tmp.pcd";
+    EXPECT_TRUE(io::WritePointCloudToPCD(file_name, pointcloud, write_ascii,
+                                         compressed, false));
+    geometry::PointCloud pointcloud_read;
+    EXPECT_TRUE(io::ReadPointCloudFromPCD(file_name, pointcloud_read, false));
+    // Points and normals are stored in single precision.
+    ExpectEQ(pointcloud.points_, pointcloud_read.points_, 1e-6);
+    ExpectEQ(pointcloud.normals_, pointcloud_read.normals_, 1e-6);
+    ExpectEQ(pointcloud.colors_, pointcloud_read.colors_);
+    std::remove(file_name.c_str());
+}
+
+}  // unnamed namespace
+
 TEST(FilePCD, DISABLED_CheckHeader) { unit_test::NotImplemented(); }
 
 TEST(FilePCD, DISABLED_ReadPCDHeader) { unit_test::NotImplemented(); }
@@ -52,6 +97,96 @@ TEST(FilePCD, DISABLED_ConvertRGBToFloat) { unit_test::NotImplemented(); }
 
 TEST(FilePCD, DISABLED_WritePCDData) { unit_test::NotImplemented(); }
 
-TEST(FilePCD, DISABLED_ReadPointCloudFromPCD) { unit_test::NotImplemented(); }
-
-TEST(FilePCD, DISABLED_WritePointCloudToPCD) { unit_test::NotImplemented(); }
+TEST(FilePCD, WriteReadPointCloudFromPCD) {
+    // Spans several unpacking blocks, with a partial last block.
+    geometry::PointCloud pointcloud = CreateRandomPointCloud(10007);
+    WriteReadAndAssertEqual(pointcloud, false, false);
+    WriteReadAndAssertEqual(pointcloud, false, true);
+    WriteReadAndAssertEqual(pointcloud, true, false);
+
+    pointcloud.colors_.clear();
+    WriteReadAndAssertEqual(pointcloud, false, false);
+    WriteReadAndAssertEqual(pointcloud, false, true);
+
+    pointcloud.normals_.clear();
+    WriteReadAndAssertEqual(pointcloud, false, false);
+    WriteReadAndAssertEqual(pointcloud, false, true);
+}
+
+TEST(FilePCD, ReadPointCloudFromBinaryPCDFieldTypes) {
+    // Fields of every supported type and size, a field with count 2, and a
+    // field that is not read, in a hand-written binary file.
+    const std::string file_name = "tmp.pcd";
+    FILE *file = fopen(file_name.c_str(), "wb");
+    ASSERT_TRUE(file != NULL);
+    fprintf(file,
+            "VERSION 0.7\n"
+            "FIELDS x y z intensity normal_x normal_y normal_z rgb\n"
+            "SIZE 4 2 1 4 4 2 1 4\n"
+            "TYPE F I U F I U I U\n"
+            "COUNT 1 1 1 2 1 1 1 1\n"
+            "WIDTH 3\n"
+            "HEIGHT 1\n"
+            "POINTS 3\n"
+            "DATA binary\n");
+    for (int i = 0; i < 3; i++) {
+        const float x = 0.5f * i;
+        const std::int16_t y = (std::int16_t)(-300 * i);
+        const std::uint8_t z = (std::uint8_t)(100 * i);
+        const float intensity[2] = {1.0f, 2.0f};
+        const std::int32_t normal_x = -70000 * i;
+        const std::uint16_t normal_y = (std::uint16_t)(60000 - i);
+        const std::int8_t normal_z = (std::int8_t)(-i);
+        const std::uint8_t bgra[4] = {(std::uint8_t)(10 * i), 20, 30, 0};
+        fwrite(&x, sizeof(x), 1, file);
+        fwrite(&y, sizeof(y), 1, file);
+        fwrite(&z, sizeof(z), 1, file);
+        fwrite(intensity, sizeof(intensity), 1, file);
+        fwrite(&normal_x, sizeof(normal_x), 1, file);
+        fwrite(&normal_y, sizeof(normal_y), 1, file);
+        fwrite(&normal_z, sizeof(normal_z), 1, file);
+        fwrite(bgra, sizeof(bgra), 1, file);
+    }
+    fclose(file);
+
+    geometry::PointCloud pointcloud;
+    EXPECT_TRUE(io::ReadPointCloudFromPCD(file_name, pointcloud, false));
+    std::remove(file_name.c_str());
+    ASSERT_EQ(3u, pointcloud.points_.size());
+    ASSERT_EQ(3u, pointcloud.normals_.size());
+    ASSERT_EQ(3u, pointcloud.colors_.size());
+    for (int i = 0; i < 3; i++) {
+        ExpectEQ(Eigen::Vector3d(0.5 * i, -300.0 * i, 100.0 * i),
+                 pointcloud.points_[i]);
+        ExpectEQ(Eigen::Vector3d(-70000.0 * i, 60000.0 - i, -i),
+                 pointcloud.normals_[i]);
+        ExpectEQ(Eigen::Vector3d(30.0 / 255.0, 20.0 / 255.0, 10.0 * i / 255.0),
+                 pointcloud.colors_[i]);
+    }
+}
+
+TEST(FilePCD, ReadTruncatedBinaryPCD) {
+    const std::string file_name = "tmp.pcd";
+    EXPECT_TRUE(io::WritePointCloudToPCD(
+            file_name, CreateRandomPointCloud(100), false, false, false));
+    // Dropping the last byte leaves the data one point short.
+    geometry::PointCloud pointcloud;
+    EXPECT_TRUE(io::ReadPointCloudFromPCD(file_name, pointcloud, false));
+    std::string content;
+    FILE *file = fopen(file_name.c_str(), "rb");
+    ASSERT_TRUE(file != NULL);
+    char buffer[4096];
+    size_t num_read;
+    while ((num_read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        content.append(buffer, num_read);
+    }
+    fclose(file);
+    content.resize(content.size() - 1);
+    file = fopen(file_name.c_str(), "wb");
+    ASSERT_TRUE(file != NULL);
+    fwrite(content.data(), 1, content.size(), file);
+    fclose(file);
+    EXPECT_FALSE(io::ReadPointCloudFromPCD(file_name, pointcloud, false));
+    EXPECT_FALSE(pointcloud.HasPoints());
+    std::remove(file_name.c_str());
+}
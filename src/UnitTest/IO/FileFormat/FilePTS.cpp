@@ -24,9 +24,15 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+#include <random>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
-TEST(FilePTS, DISABLED_ReadPointCloudFromPTS) { unit_test::NotImplemented(); }
+using namespace open3d;
+using namespace unit_test;
 
 TEST(FilePTS, DISABLED_ResetConsoleProgress) { unit_test::NotImplemented(); }
 
@@ -34,4 +40,54 @@ TEST(FilePTS, DISABLED_SplitString) { unit_test::NotImplemented(); }
 
 TEST(FilePTS, DISABLED_AdvanceConsoleProgress) { unit_test::NotImplemented(); }
 
-TEST(FilePTS, DISABLED_WritePointCloudToPTS) { unit_test::NotImplemented(); }
+TEST(FilePTS, WriteReadPointCloudFromPTS) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::uniform_int_distribution<int> byte(0, 255);
+    geometry::PointCloud pointcloud;
+    for (int i = 0; i < 10000; i++) {
+        pointcloud.points_.push_back(
+                Eigen::Vector3d(uniform(rng), uniform(rng), uniform(rng)));
+        // Colors that are exactly representable by 8 bit channels.
+        pointcloud.colors_.push_back(
+                Eigen::Vector3d(byte(rng), byte(rng), byte(rng)) / 255.0);
+    }
+
+    const std::string file_name = "tmp.pts";
+    geometry::PointCloud pointcloud_read;
+    EXPECT_TRUE(io::WritePointCloudToPTS(file_name, pointcloud));
+    EXPECT_TRUE(io::ReadPointCloudFromPTS(file_name, pointcloud_read));
+    ExpectEQ(pointcloud.points_, pointcloud_read.points_, 0.0);
+    ExpectEQ(pointcloud.colors_, pointcloud_read.colors_);
+
+    pointcloud.colors_.clear();
+    EXPECT_TRUE(io::WritePointCloudToPTS(file_name, pointcloud));
+    EXPECT_TRUE(io::ReadPointCloudFromPTS(file_name, pointcloud_read));
+    ExpectEQ(pointcloud.points_, pointcloud_read.points_, 0.0);
+    EXPECT_FALSE(pointcloud_read.HasColors());
+    std::remove(file_name.c_str());
+}
+
+TEST(FilePTS, ReadPointCloudFromPTS) {
+    // A point that fails to parse is kept as zeros, and lines after the
+    // number of points in the header are not read.
+    const std::string file_name = "tmp.pts";
+    FILE *file = fopen(file_name.c_str(), "w");
+    fprintf(file,
+            "3\r\n"
+            "1 2 3 0 255 0 51\r\n"
+            "bad line\r\n"
+            "4 5 6 0 0 102 255\r\n"
+            "7 8 9 0 0 0 0\r\n");
+    fclose(file);
+
+    geometry::PointCloud pointcloud;
+    EXPECT_TRUE(io::ReadPointCloudFromPTS(file_name, pointcloud));
+    std::vector<Eigen::Vector3d> ref_points = {
+            {1.0, 2.0, 3.0}, {0.0, 0.0, 0.0}, {4.0, 5.0, 6.0}};
+    std::vector<Eigen::Vector3d> ref_colors = {
+            {1.0, 0.0, 0.2}, {0.0, 0.0, 0.0}, {0.0, 0.4, 1.0}};
+    ExpectEQ(ref_points, pointcloud.points_);
+    ExpectEQ(ref_colors, pointcloud.colors_);
+    std::remove(file_name.c_str());
+}
@@ -24,8 +24,58 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+#include <random>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
-TEST(FileXYZ, DISABLED_ReadPointCloudFromXYZ) { unit_test::NotImplemented(); }
+using namespace open3d;
+using namespace unit_test;
+
+TEST(FileXYZ, WriteReadPointCloudFromXYZ) {
+    // Spans several parsing pieces of the reader.
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uniform(-1000.0, 1000.0);
+    geometry::PointCloud pointcloud;
+    for (int i = 0; i < 100000; i++) {
+        pointcloud.points_.push_back(
+                Eigen::Vector3d(uniform(rng), uniform(rng), uniform(rng)));
+    }
+    pointcloud.points_.push_back(Eigen::Vector3d(1e-300, -1e300, 0.1));
+
+    const std::string file_name = "tmp.xyz";
+    EXPECT_TRUE(io::WritePointCloudToXYZ(file_name, pointcloud));
+    geometry::PointCloud pointcloud_read;
+    EXPECT_TRUE(io::ReadPointCloudFromXYZ(file_name, pointcloud_read));
+    ExpectEQ(pointcloud.points_, pointcloud_read.points_, 0.0);
+    std::remove(file_name.c_str());
+}
+
+TEST(FileXYZ, ReadPointCloudFromXYZ) {
+    // Lines with too few numbers are skipped, and extra fields are ignored.
+    const std::string file_name = "tmp.xyz";
+    FILE *file = fopen(file_name.c_str(), "w");
+    fprintf(file,
+            "1 2 3\n"
+            "\t-1.5e2  +2.25E-1 .5\r\n"
+            "# comment\n"
+            "\n"
+            "4 5\n"
+            "6 7 8 9 10\n"
+            "0.1000000000000000055511151231257827 1e300 -0\n"
+            "7 8 9");
+    fclose(file);
 
-TEST(FileXYZ, DISABLED_WritePointCloudToXYZ) { unit_test::NotImplemented(); }
+    geometry::PointCloud pointcloud;
+    EXPECT_TRUE(io::ReadPointCloudFromXYZ(file_name, pointcloud));
+    std::vector<Eigen::Vector3d> ref_points = {
+            {1.0, 2.0, 3.0},
+            {-150.0, 0.225, 0.5},
+            {6.0, 7.0, 8.0},
+            {0.1, 1e300, 0.0},
+            {7.0, 8.0, 9.0}};
+    ExpectEQ(ref_points, pointcloud.points_, 0.0);
+    std::remove(file_name.c_str());
+}
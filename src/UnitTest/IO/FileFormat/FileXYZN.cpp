@@ -24,8 +24,32 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+#include <random>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
-TEST(FileXYZN, DISABLED_ReadPointCloudFromXYZN) { unit_test::NotImplemented(); }
+using namespace open3d;
+using namespace unit_test;
+
+TEST(FileXYZN, WriteReadPointCloudFromXYZN) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    geometry::PointCloud pointcloud;
+    for (int i = 0; i < 10000; i++) {
+        pointcloud.points_.push_back(
+                Eigen::Vector3d(uniform(rng), uniform(rng), uniform(rng)));
+        pointcloud.normals_.push_back(
+                Eigen::Vector3d(uniform(rng), uniform(rng), uniform(rng)));
+    }
 
-TEST(FileXYZN, DISABLED_WritePointCloudToXYZN) { unit_test::NotImplemented(); }
\ No newline at end of file
+    const std::string file_name = "tmp.xyzn";
+    EXPECT_TRUE(io::WritePointCloudToXYZN(file_name, pointcloud));
+    geometry::PointCloud pointcloud_read;
+    EXPECT_TRUE(io::ReadPointCloudFromXYZN(file_name, pointcloud_read));
+    ExpectEQ(pointcloud.points_, pointcloud_read.points_, 0.0);
+    ExpectEQ(pointcloud.normals_, pointcloud_read.normals_, 0.0);
+    std::remove(file_name.c_str());
+}
@@ -24,12 +24,33 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <cstdio>
+#include <random>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
-TEST(FileXYZRGB, DISABLED_ReadPointCloudFromXYZRGB) {
-    unit_test::NotImplemented();
-}
+using namespace open3d;
+using namespace unit_test;
 
-TEST(FileXYZRGB, DISABLED_WritePointCloudToXYZRGB) {
-    unit_test::NotImplemented();
-}
\ No newline at end of file
+TEST(FileXYZRGB, WriteReadPointCloudFromXYZRGB) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    geometry::PointCloud pointcloud;
+    for (int i = 0; i < 10000; i++) {
+        pointcloud.points_.push_back(
+                Eigen::Vector3d(uniform(rng), uniform(rng), uniform(rng)));
+        pointcloud.colors_.push_back(
+                Eigen::Vector3d(uniform(rng), uniform(rng), uniform(rng)));
+    }
+
+    const std::string file_name = "tmp.xyzrgb";
+    EXPECT_TRUE(io::WritePointCloudToXYZRGB(file_name, pointcloud));
+    geometry::PointCloud pointcloud_read;
+    EXPECT_TRUE(
+            io::ReadPointCloudFromXYZRGB(file_name, pointcloud_read, false));
+    ExpectEQ(pointcloud.points_, pointcloud_read.points_, 0.0);
+    ExpectEQ(pointcloud.colors_, pointcloud_read.colors_, 0.0);
+    std::remove(file_name.c_str());
+}
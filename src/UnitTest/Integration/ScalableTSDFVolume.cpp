@@ -24,8 +24,20 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Integration/ScalableTSDFVolume.h"
+#include "Open3D/Camera/PinholeCameraTrajectory.h"
+#include "Open3D/Geometry/RGBDImage.h"
+#include "Open3D/IO/ClassIO/ImageIO.h"
+#include "Open3D/IO/ClassIO/PinholeCameraTrajectoryIO.h"
 #include "TestUtility/UnitTest.h"
 
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+using namespace open3d;
+using namespace unit_test;
+
 TEST(ScalableTSDFVolume, DISABLED_VolumeUnit) { unit_test::NotImplemented(); }
 
 TEST(ScalableTSDFVolume, DISABLED_Constructor) { unit_test::NotImplemented(); }
@@ -36,7 +48,51 @@ TEST(ScalableTSDFVolume, DISABLED_MemberData) { unit_test::NotImplemented(); }
 
 TEST(ScalableTSDFVolume, DISABLED_Reset) { unit_test::NotImplemented(); }
 
-TEST(ScalableTSDFVolume, DISABLED_Integrate) { unit_test::NotImplemented(); }
+TEST(ScalableTSDFVolume, Integrate) {
+    camera::PinholeCameraTrajectory trajectory;
+    ASSERT_TRUE(io::ReadPinholeCameraTrajectory(
+            std::string(TEST_DATA_DIR) + "/RGBD/odometry.log", trajectory));
+
+    // The occlusion test checks every pixel of a unit's footprint, so even
+    // with the default depth sampling stride skipping the occluded units must
+    // not change the result.
+    integration::ScalableTSDFVolume tsdf_volume(
+            4.0 / 256.0, 0.04, integration::TSDFVolumeColorType::RGB8);
+    integration::ScalableTSDFVolume tsdf_volume_culled(
+            4.0 / 256.0, 0.04, integration::TSDFVolumeColorType::RGB8, 16, 4,
+            /*skip_occluded_volume_units*/ true);
+    for (size_t i = 0; i < trajectory.parameters_.size(); ++i) {
+        geometry::Image im_color;
+        std::ostringstream im_color_path;
+        im_color_path << TEST_DATA_DIR << "/RGBD/color/" << std::setfill('0')
+                      << std::setw(5) << i << ".jpg";
+        io::ReadImage(im_color_path.str(), im_color);
+
+        geometry::Image im_depth;
+        std::ostringstream im_depth_path;
+        im_depth_path << TEST_DATA_DIR << "/RGBD/depth/" << std::setfill('0')
+                      << std::setw(5) << i << ".png";
+        io::ReadImage(im_depth_path.str(), im_depth);
+
+        auto im_rgbd = geometry::RGBDImage::CreateFromColorAndDepth(
+                im_color, im_depth, /*depth_scale*/ 1000.0,
+                /*depth_func*/ 4.0, /*convert_rgb_to_intensity*/ false);
+        const auto &parameters = trajectory.parameters_[i];
+        tsdf_volume.Integrate(*im_rgbd, parameters.intrinsic_,
+                              parameters.extrinsic_);
+        tsdf_volume_culled.Integrate(*im_rgbd, parameters.intrinsic_,
+                                     parameters.extrinsic_);
+    }
+    EXPECT_LT(tsdf_volume_culled.volume_units_.size(),
+              tsdf_volume.volume_units_.size());
+
+    auto mesh = tsdf_volume.ExtractTriangleMesh();
+    auto mesh_culled = tsdf_volume_culled.ExtractTriangleMesh();
+    EXPECT_GT(mesh->triangles_.size(), 0u);
+    EXPECT_EQ(mesh->vertices_.size(), mesh_culled->vertices_.size());
+    EXPECT_EQ(mesh->triangles_.size(), mesh_culled->triangles_.size());
+    ExpectEQ(mesh->GetCenter(), mesh_culled->GetCenter());
+}
 
 TEST(ScalableTSDFVolume, DISABLED_ExtractPointCloud) {
     unit_test::NotImplemented();
@@ -46,6 +102,70 @@ TEST(ScalableTSDFVolume, DISABLED_ExtractTriangleMesh) {
     unit_test::NotImplemented();
 }
 
+TEST(ScalableTSDFVolume, Raycast) {
+    // A tilted plane z = 1 + 0.1 x + 0.2 y of constant intensity, integrated
+    // from a wider and finer view than the rendered one.
+    const camera::PinholeCameraIntrinsic wide_intrinsic(400, 300, 300.0, 300.0,
+                                                        199.5, 149.5);
+    const camera::PinholeCameraIntrinsic intrinsic(80, 60, 75.0, 75.0, 39.5,
+                                                   29.5);
+    auto plane_depth = [](double x, double y) {
+        return 1.0 / (1.0 - 0.1 * x - 0.2 * y);
+    };
+    geometry::RGBDImage rgbd;
+    rgbd.color_.Prepare(400, 300, 1, 4);
+    rgbd.depth_.Prepare(400, 300, 1, 4);
+    for (int v = 0; v < 300; v++) {
+        for (int u = 0; u < 400; u++) {
+            *rgbd.depth_.PointerAt<float>(u, v) = (float)plane_depth(
+                    (u - 199.5) / 300.0, (v - 149.5) / 300.0);
+            *rgbd.color_.PointerAt<float>(u, v) = 0.5f;
+        }
+    }
+
+    integration::ScalableTSDFVolume tsdf_volume(
+            2.0 / 128.0, 0.04, integration::TSDFVolumeColorType::Gray32);
+    tsdf_volume.Integrate(rgbd, wide_intrinsic, Eigen::Matrix4d::Identity());
+    std::shared_ptr<geometry::Image> depth, vertex_map, normal_map, color;
+    std::tie(depth, vertex_map, normal_map, color) =
+            tsdf_volume.Raycast(intrinsic, Eigen::Matrix4d::Identity());
+    EXPECT_EQ(color->num_of_channels_, 1);
+    EXPECT_EQ(color->bytes_per_channel_, 4);
+
+    const Eigen::Vector3d normal = Eigen::Vector3d(0.1, 0.2, -1.0).normalized();
+    for (int v = 0; v < intrinsic.height_; v++) {
+        for (int u = 0; u < intrinsic.width_; u++) {
+            const Eigen::Vector3d ray((u - 39.5) / 75.0, (v - 29.5) / 75.0,
+                                      1.0);
+            float d = *depth->PointerAt<float>(u, v);
+            EXPECT_NEAR(d, plane_depth(ray(0), ray(1)), 1e-3);
+            for (int c = 0; c < 3; c++) {
+                EXPECT_NEAR(*vertex_map->PointerAt<float>(u, v, c),
+                            d * ray(c), 1e-6);
+                EXPECT_NEAR(*normal_map->PointerAt<float>(u, v, c), normal(c),
+                            3e-2);
+            }
+            EXPECT_EQ(*color->PointerAt<float>(u, v), 0.5f);
+        }
+    }
+
+    // Nothing is hit looking away from the plane.
+    Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+    extrinsic(0, 0) = -1.0;
+    extrinsic(2, 2) = -1.0;
+    std::tie(depth, vertex_map, normal_map, color) =
+            tsdf_volume.Raycast(intrinsic, extrinsic);
+    EXPECT_EQ(*depth->PointerAt<float>(40, 30), 0.0f);
+    EXPECT_TRUE(std::isnan(*vertex_map->PointerAt<float>(40, 30, 2)));
+    EXPECT_TRUE(std::isnan(*normal_map->PointerAt<float>(40, 30, 2)));
+
+    // Nor in an empty volume.
+    tsdf_volume.Reset();
+    std::tie(depth, vertex_map, normal_map, color) =
+            tsdf_volume.Raycast(intrinsic, Eigen::Matrix4d::Identity());
+    EXPECT_EQ(*depth->PointerAt<float>(40, 30), 0.0f);
+}
+
 TEST(ScalableTSDFVolume, DISABLED_ExtractVoxelPointCloud) {
     unit_test::NotImplemented();
 }
@@ -32,6 +32,7 @@
 #include "Open3D/Visualization/Utility/DrawGeometry.h"
 #include "TestUtility/UnitTest.h"
 
+#include <cmath>
 #include <sstream>
 
 using namespace open3d;
@@ -94,7 +95,10 @@ TEST(UniformTSDFVolume, Constructor) {
     EXPECT_EQ(tsdf_volume.length_, length);
     EXPECT_EQ(tsdf_volume.resolution_, resolution);
     EXPECT_EQ(tsdf_volume.voxel_num_, resolution * resolution * resolution);
-    EXPECT_EQ(int(tsdf_volume.voxels_.size()), tsdf_volume.voxel_num_);
+    EXPECT_EQ(int(tsdf_volume.tsdf_.size()), tsdf_volume.voxel_num_);
+    EXPECT_EQ(int(tsdf_volume.weight_.size()), tsdf_volume.voxel_num_);
+    EXPECT_EQ(int(tsdf_volume.color_.size()), 3 * tsdf_volume.voxel_num_);
+    EXPECT_EQ(tsdf_volume.intensity_.size(), 0u);
 }
 
 TEST(UniformTSDFVolume, RealData) {
@@ -217,3 +221,71 @@ TEST(UniformTSDFVolume, DISABLED_IndexOf) {}
 TEST(UniformTSDFVolume, DISABLED_GetNormalAt) {}
 
 TEST(UniformTSDFVolume, DISABLED_GetTSDFAt) {}
+
+TEST(UniformTSDFVolume, Raycast) {
+    // A tilted plane z = 1 + 0.1 x + 0.2 y of constant color, integrated from
+    // a wider and finer view than the rendered one.
+    const camera::PinholeCameraIntrinsic wide_intrinsic(400, 300, 300.0, 300.0,
+                                                        199.5, 149.5);
+    const camera::PinholeCameraIntrinsic intrinsic(80, 60, 75.0, 75.0, 39.5,
+                                                   29.5);
+    auto plane_depth = [](double x, double y) {
+        return 1.0 / (1.0 - 0.1 * x - 0.2 * y);
+    };
+    geometry::RGBDImage rgbd;
+    rgbd.color_.Prepare(400, 300, 3, 1);
+    rgbd.depth_.Prepare(400, 300, 1, 4);
+    for (int v = 0; v < 300; v++) {
+        for (int u = 0; u < 400; u++) {
+            *rgbd.depth_.PointerAt<float>(u, v) = (float)plane_depth(
+                    (u - 199.5) / 300.0, (v - 149.5) / 300.0);
+            uint8_t* rgb = rgbd.color_.PointerAt<uint8_t>(u, v, 0);
+            rgb[0] = 200;
+            rgb[1] = 100;
+            rgb[2] = 50;
+        }
+    }
+
+    integration::UniformTSDFVolume tsdf_volume(
+            2.0, 128, 0.04, integration::TSDFVolumeColorType::RGB8,
+            Eigen::Vector3d(-1.0, -1.0, 0.0));
+    tsdf_volume.Integrate(rgbd, wide_intrinsic, Eigen::Matrix4d::Identity());
+    std::shared_ptr<geometry::Image> depth, vertex_map, normal_map, color;
+    std::tie(depth, vertex_map, normal_map, color) =
+            tsdf_volume.Raycast(intrinsic, Eigen::Matrix4d::Identity());
+    EXPECT_EQ(depth->num_of_channels_, 1);
+    EXPECT_EQ(vertex_map->num_of_channels_, 3);
+    EXPECT_EQ(normal_map->num_of_channels_, 3);
+    EXPECT_EQ(color->num_of_channels_, 3);
+    EXPECT_EQ(color->bytes_per_channel_, 1);
+
+    const Eigen::Vector3d normal = Eigen::Vector3d(0.1, 0.2, -1.0).normalized();
+    for (int v = 0; v < intrinsic.height_; v++) {
+        for (int u = 0; u < intrinsic.width_; u++) {
+            const Eigen::Vector3d ray((u - 39.5) / 75.0, (v - 29.5) / 75.0,
+                                      1.0);
+            float d = *depth->PointerAt<float>(u, v);
+            EXPECT_NEAR(d, plane_depth(ray(0), ray(1)), 1e-3);
+            for (int c = 0; c < 3; c++) {
+                EXPECT_NEAR(*vertex_map->PointerAt<float>(u, v, c),
+                            d * ray(c), 1e-6);
+                EXPECT_NEAR(*normal_map->PointerAt<float>(u, v, c), normal(c),
+                            3e-2);
+            }
+            for (int c = 0; c < 3; c++) {
+                EXPECT_EQ(*color->PointerAt<uint8_t>(u, v, c),
+                          *rgbd.color_.PointerAt<uint8_t>(0, 0, c));
+            }
+        }
+    }
+
+    // Nothing is hit looking away from the plane.
+    Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+    extrinsic(0, 0) = -1.0;
+    extrinsic(2, 2) = -1.0;
+    std::tie(depth, vertex_map, normal_map, color) =
+            tsdf_volume.Raycast(intrinsic, extrinsic);
+    EXPECT_EQ(*depth->PointerAt<float>(40, 30), 0.0f);
+    EXPECT_TRUE(std::isnan(*vertex_map->PointerAt<float>(40, 30, 2)));
+    EXPECT_TRUE(std::isnan(*normal_map->PointerAt<float>(40, 30, 2)));
+}
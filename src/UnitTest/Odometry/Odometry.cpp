@@ -24,9 +24,151 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <Eigen/Geometry>
+#include <cmath>
+#include <limits>
+
+#include "Open3D/Geometry/Image.h"
+#include "Open3D/Geometry/RGBDImage.h"
+#include "Open3D/Odometry/Odometry.h"
 #include "TestUtility/UnitTest.h"
 
-TEST(Odometry, DISABLED_ComputeRGBDOdometry) { unit_test::NotImplemented(); }
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+const camera::PinholeCameraIntrinsic kIntrinsic(160, 120, 150.0, 150.0, 79.5,
+                                                59.5);
+
+/// The camera to world pose of frame i of a smooth trajectory.
+Eigen::Matrix4d CreatePose(int i) {
+    Eigen::Matrix4d pose = Eigen::Matrix4d::Identity();
+    const Eigen::Vector3d axis = Eigen::Vector3d(0.2, 1.0, 0.1).normalized();
+    pose.block<3, 3>(0, 0) =
+            Eigen::AngleAxisd(0.01 * i, axis).toRotationMatrix();
+    pose.block<3, 1>(0, 3) = Eigen::Vector3d(0.01 * i, -0.005 * i, 0.01 * i);
+    return pose;
+}
+
+/// Renders a tilted, textured plane from pose.
+geometry::RGBDImage RenderFrame(const Eigen::Matrix4d &pose) {
+    const Eigen::Vector3d normal = Eigen::Vector3d(0.1, 0.2, -1.0).normalized();
+    const double offset = -1.5;
+    const Eigen::Matrix3d &K = kIntrinsic.intrinsic_matrix_;
+    geometry::Image color, depth;
+    color.Prepare(kIntrinsic.width_, kIntrinsic.height_, 1, 4);
+    depth.Prepare(kIntrinsic.width_, kIntrinsic.height_, 1, 4);
+    for (int v = 0; v < kIntrinsic.height_; v++) {
+        for (int u = 0; u < kIntrinsic.width_; u++) {
+            Eigen::Vector3d ray((u - K(0, 2)) / K(0, 0),
+                                (v - K(1, 2)) / K(1, 1), 1.0);
+            Eigen::Vector3d ray_world = pose.block<3, 3>(0, 0) * ray;
+            Eigen::Vector3d origin = pose.block<3, 1>(0, 3);
+            double s = (offset - normal.dot(origin)) / normal.dot(ray_world);
+            Eigen::Vector3d point = origin + s * ray_world;
+            *depth.PointerAt<float>(u, v) = (float)s;
+            *color.PointerAt<float>(u, v) =
+                    (float)(0.5 + 0.2 * std::sin(9.0 * point(0)) *
+                                          std::cos(7.0 * point(1)) +
+                            0.1 * std::sin(13.0 * (point(0) + point(1))));
+        }
+    }
+    return geometry::RGBDImage(color, depth);
+}
+
+/// Renders the depth, vertex and normal maps of a room corner from pose.
+void RenderCorner(const Eigen::Matrix4d &pose,
+                  geometry::Image &depth,
+                  geometry::Image &vertex_map,
+                  geometry::Image &normal_map) {
+    // The back wall, the left wall and the floor, as n.dot(x) = d.
+    const Eigen::Vector3d normals[3] = {Eigen::Vector3d(0.0, 0.0, 1.0),
+                                        Eigen::Vector3d(1.0, 0.0, 0.0),
+                                        Eigen::Vector3d(0.0, 1.0, 0.0)};
+    const double offsets[3] = {2.0, -0.7, 0.5};
+    const Eigen::Matrix3d &K = kIntrinsic.intrinsic_matrix_;
+    const Eigen::Matrix3d R = pose.block<3, 3>(0, 0);
+    const Eigen::Vector3d origin = pose.block<3, 1>(0, 3);
+    depth.Prepare(kIntrinsic.width_, kIntrinsic.height_, 1, 4);
+    vertex_map.Prepare(kIntrinsic.width_, kIntrinsic.height_, 3, 4);
+    normal_map.Prepare(kIntrinsic.width_, kIntrinsic.height_, 3, 4);
+    for (int v = 0; v < kIntrinsic.height_; v++) {
+        for (int u = 0; u < kIntrinsic.width_; u++) {
+            Eigen::Vector3d ray((u - K(0, 2)) / K(0, 0),
+                                (v - K(1, 2)) / K(1, 1), 1.0);
+            double s = std::numeric_limits<double>::infinity();
+            Eigen::Vector3d normal;
+            for (int k = 0; k < 3; k++) {
+                double s_k = (offsets[k] - normals[k].dot(origin)) /
+                             normals[k].dot(R * ray);
+                if (s_k > 0.0 && s_k < s) {
+                    s = s_k;
+                    normal = R.transpose() * normals[k];
+                }
+            }
+            if (normal.dot(ray) > 0.0) normal = -normal;
+            *depth.PointerAt<float>(u, v) = (float)s;
+            for (int c = 0; c < 3; c++) {
+                *vertex_map.PointerAt<float>(u, v, c) = (float)(s * ray(c));
+                *normal_map.PointerAt<float>(u, v, c) = (float)normal(c);
+            }
+        }
+    }
+}
+
+}  // unnamed namespace
+
+TEST(Odometry, ComputeRGBDOdometry) {
+    const geometry::RGBDImage source = RenderFrame(CreatePose(0));
+    const geometry::RGBDImage target = RenderFrame(CreatePose(1));
+    bool is_success;
+    Eigen::Matrix4d odo;
+    Eigen::Matrix6d info;
+    std::tie(is_success, odo, info) =
+            odometry::ComputeRGBDOdometry(source, target, kIntrinsic);
+    EXPECT_TRUE(is_success);
+    ExpectEQ(Eigen::Matrix4d(CreatePose(1).inverse() * CreatePose(0)), odo,
+             5e-3);
+    EXPECT_GT(info(3, 3), 0.0);
+}
+
+TEST(Odometry, ComputeProjectiveICPOdometry) {
+    geometry::Image source_depth, source_vertex_map, source_normal_map;
+    RenderCorner(CreatePose(0), source_depth, source_vertex_map,
+                 source_normal_map);
+    geometry::Image target_depth, target_vertex_map, target_normal_map;
+    RenderCorner(CreatePose(1), target_depth, target_vertex_map,
+                 target_normal_map);
+    bool is_success;
+    Eigen::Matrix4d odo;
+    Eigen::Matrix6d info;
+    std::tie(is_success, odo, info) = odometry::ComputeProjectiveICPOdometry(
+            source_depth, target_vertex_map, target_normal_map, kIntrinsic);
+    EXPECT_TRUE(is_success);
+    ExpectEQ(Eigen::Matrix4d(CreatePose(1).inverse() * CreatePose(0)), odo,
+             1e-4);
+    EXPECT_GT(info(3, 3), 0.0);
+
+    // Missing model pixels are skipped.
+    for (int v = 0; v < kIntrinsic.height_ / 4; v++) {
+        for (int u = 0; u < kIntrinsic.width_; u++) {
+            *target_vertex_map.PointerAt<float>(u, v, 2) =
+                    std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+    std::tie(is_success, odo, info) = odometry::ComputeProjectiveICPOdometry(
+            source_depth, target_vertex_map, target_normal_map, kIntrinsic);
+    EXPECT_TRUE(is_success);
+    ExpectEQ(Eigen::Matrix4d(CreatePose(1).inverse() * CreatePose(0)), odo,
+             1e-4);
+
+    // Maps of another size are rejected.
+    std::tie(is_success, odo, info) = odometry::ComputeProjectiveICPOdometry(
+            *source_depth.Downsample(), target_vertex_map, target_normal_map,
+            kIntrinsic);
+    EXPECT_FALSE(is_success);
+}
 
 TEST(Odometry, DISABLED_PinholeCameraIntrinsic) { unit_test::NotImplemented(); }
 
@@ -35,3 +177,47 @@ TEST(Odometry, DISABLED_RGBDOdometryJacobianFromHybridTerm) {
 }
 
 TEST(Odometry, DISABLED_OdometryOption) { unit_test::NotImplemented(); }
+
+TEST(Odometry, RGBDOdometryTracker) {
+    std::vector<geometry::RGBDImage> frames;
+    for (int i = 0; i < 4; i++) {
+        frames.push_back(RenderFrame(CreatePose(i)));
+    }
+
+    odometry::RGBDOdometryTracker tracker(kIntrinsic);
+    EXPECT_FALSE(tracker.HasKeyframe());
+    bool is_success;
+    Eigen::Matrix4d odo;
+    Eigen::Matrix6d info;
+    std::tie(is_success, odo, info) = tracker.Track(frames[0]);
+    EXPECT_FALSE(is_success);
+    EXPECT_TRUE(tracker.HasKeyframe());
+
+    // The same odometry as the pairwise estimation, from cached pyramids.
+    for (int i = 1; i < 4; i++) {
+        std::tie(is_success, odo, info) = tracker.Track(frames[i]);
+        bool ref_is_success;
+        Eigen::Matrix4d ref_odo;
+        Eigen::Matrix6d ref_info;
+        std::tie(ref_is_success, ref_odo, ref_info) =
+                odometry::ComputeRGBDOdometry(frames[i - 1], frames[i],
+                                              kIntrinsic);
+        EXPECT_TRUE(is_success);
+        EXPECT_TRUE(ref_is_success);
+        ExpectEQ(ref_odo, odo, 1e-6);
+        ExpectEQ(ref_info, info, 1e-6);
+        ExpectEQ(Eigen::Matrix4d(CreatePose(i).inverse() * CreatePose(i - 1)),
+                 odo, 5e-3);
+    }
+
+    // A frame of another size is rejected and keeps the keyframe.
+    geometry::RGBDImage small_frame = RenderFrame(CreatePose(0));
+    small_frame.color_ = *small_frame.color_.Downsample();
+    small_frame.depth_ = *small_frame.depth_.Downsample();
+    std::tie(is_success, odo, info) = tracker.Track(small_frame);
+    EXPECT_FALSE(is_success);
+    EXPECT_TRUE(tracker.HasKeyframe());
+
+    tracker.Reset();
+    EXPECT_FALSE(tracker.HasKeyframe());
+}
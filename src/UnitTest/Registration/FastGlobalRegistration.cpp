@@ -24,8 +24,18 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <random>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/FastGlobalRegistration.h"
+#include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/Registration.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
 TEST(FastGlobalRegistration, DISABLED_FastGlobalRegistrationOption) {
     unit_test::NotImplemented();
 }
@@ -41,3 +51,43 @@ TEST(FastGlobalRegistration, DISABLED_Constructor) {
 TEST(FastGlobalRegistration, DISABLED_MemberData) {
     unit_test::NotImplemented();
 }
+
+TEST(FastGlobalRegistration, FastGlobalRegistration) {
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) =
+            Eigen::AngleAxisd(0.5, Eigen::Vector3d(1.0, 2.0, 3.0).normalized())
+                    .toRotationMatrix();
+    transformation.block<3, 1>(0, 3) = Eigen::Vector3d(0.3, -0.2, 0.1);
+    geometry::PointCloud source, target;
+    registration::Feature source_feature, target_feature;
+    source_feature.Resize(8, 2000);
+    mt19937 rng(0);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (int i = 0; i < 2000; i++) {
+        source.points_.push_back(
+                Eigen::Vector3d(uniform(rng), uniform(rng), uniform(rng)));
+        for (int k = 0; k < 8; k++) {
+            source_feature.data_(k, i) = (float)uniform(rng);
+        }
+    }
+    target = source;
+    target.Transform(transformation);
+    // Features that match exactly between corresponding points, except for
+    // the tail of the target, which has fewer points.
+    target.points_.resize(1500);
+    target_feature.data_ = source_feature.data_.leftCols(1500);
+
+    auto result = registration::FastGlobalRegistration(
+            source, target, source_feature, target_feature);
+    ExpectEQ(transformation, Eigen::Matrix4d(result.transformation_), 1e-3);
+
+    // The same seed gives the same result.
+    registration::FastGlobalRegistrationOption option;
+    option.seed_ = 42;
+    auto result0 = registration::FastGlobalRegistration(
+            source, target, source_feature, target_feature, option);
+    auto result1 = registration::FastGlobalRegistration(
+            source, target, source_feature, target_feature, option);
+    ExpectEQ(Eigen::Matrix4d(result0.transformation_),
+             Eigen::Matrix4d(result1.transformation_), 0.0);
+}
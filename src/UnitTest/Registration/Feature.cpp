@@ -24,14 +24,113 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <random>
+
+#include "Open3D/Geometry/NeighborhoodGraph.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/Feature.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
 TEST(Feature, DISABLED_Resize) { unit_test::NotImplemented(); }
 
 TEST(Feature, DISABLED_Dimension) { unit_test::NotImplemented(); }
 
 TEST(Feature, DISABLED_Num) { unit_test::NotImplemented(); }
 
-TEST(Feature, DISABLED_ComputeFPFHFeature) { unit_test::NotImplemented(); }
+TEST(Feature, ComputeFPFHFeature) {
+    geometry::PointCloud pc;
+    pc.points_.resize(1000);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+    geometry::KDTreeSearchParamHybrid param(2.0, 30);
+    pc.EstimateNormals(param);
+
+    auto feature = registration::ComputeFPFHFeature(pc, param);
+    EXPECT_EQ(feature->Dimension(), 33u);
+    EXPECT_EQ(feature->Num(), pc.points_.size());
+    // Each of the three angle histograms of a point with neighbors sums to
+    // 200: 100 for its own SPFH and 100 for the weighted neighbor SPFHs.
+    for (size_t i = 0; i < feature->Num(); i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_NEAR(feature->data_.col(i).segment(j * 11, 11).sum(), 200.0,
+                        1e-3);
+        }
+    }
+
+    // The same graph serves normal estimation and both FPFH passes.
+    geometry::PointCloud graph_pc;
+    graph_pc.points_ = pc.points_;
+    auto graph =
+            geometry::NeighborhoodGraph::CreateFromPointCloud(graph_pc, param);
+    graph_pc.EstimateNormals(*graph);
+    ExpectEQ(pc.normals_, graph_pc.normals_);
+    auto graph_feature = registration::ComputeFPFHFeature(graph_pc, *graph);
+    ExpectEQ(feature->data_, graph_feature->data_);
+
+    geometry::PointCloud other = pc;
+    other.points_.resize(10);
+    other.normals_.resize(10);
+    EXPECT_ANY_THROW(registration::ComputeFPFHFeature(other, *graph));
+}
+
+TEST(Feature, FindNearestFeatures) {
+    registration::Feature query, reference;
+    query.Resize(33, 300);
+    reference.Resize(33, 1000);
+    mt19937 rng(0);
+    uniform_real_distribution<float> uniform(0.0f, 100.0f);
+    for (int i = 0; i < query.data_.size(); i++) {
+        query.data_.data()[i] = uniform(rng);
+    }
+    for (int i = 0; i < reference.data_.size(); i++) {
+        reference.data_.data()[i] = uniform(rng);
+    }
+    // Makes every third query a slightly perturbed reference feature, so that
+    // it has a clear nearest neighbor.
+    for (int i = 0; i < 300; i += 3) {
+        query.data_.col(i) = reference.data_.col(3 * i) +
+                             Eigen::VectorXf::Constant(33, 0.1f);
+    }
+
+    auto nearest = registration::FindNearestFeatures(query, reference);
+    ASSERT_EQ(nearest.size(), 300u);
+    for (int i = 0; i < 300; i++) {
+        // Exhaustive search in double precision.
+        Eigen::MatrixXd diff = reference.data_.cast<double>().colwise() -
+                               query.data_.col(i).cast<double>();
+        int index;
+        double min_distance2 = diff.colwise().squaredNorm().minCoeff(&index);
+        double distance2 =
+                (reference.data_.col(nearest[i]) - query.data_.col(i))
+                        .cast<double>()
+                        .squaredNorm();
+        EXPECT_NEAR(distance2, min_distance2, 1e-3 * min_distance2);
+        if (i % 3 == 0) {
+            EXPECT_EQ(nearest[i], 3 * i);
+        }
+    }
+
+    // Mutual nearest neighbors are a subset of the nearest neighbors.
+    auto corres = registration::CorrespondencesFromFeatures(query, reference);
+    EXPECT_EQ(corres.size(), 300u);
+    auto mutual =
+            registration::CorrespondencesFromFeatures(query, reference, true);
+    EXPECT_GE(mutual.size(), 100u);
+    EXPECT_LT(mutual.size(), 300u);
+    auto reverse = registration::FindNearestFeatures(reference, query);
+    for (const auto &c : mutual) {
+        EXPECT_EQ(nearest[c(0)], c(1));
+        EXPECT_EQ(reverse[c(1)], c(0));
+    }
+
+    registration::Feature empty;
+    empty.Resize(33, 0);
+    EXPECT_EQ(registration::FindNearestFeatures(query, empty),
+              vector<int>(300, -1));
+}
 
 TEST(Feature, DISABLED_KDTreeSearchParamKNN) { unit_test::NotImplemented(); }
@@ -24,14 +24,84 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <Eigen/Dense>
+
+#include "Open3D/Registration/GlobalOptimization.h"
+#include "Open3D/Registration/PoseGraph.h"
+#include "Open3D/Utility/Eigen.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+
+namespace {
+
+// Pose graph of a closed loop of nodes with exact odometry and loop closure
+// measurements. All nodes but the first one are perturbed from the ground
+// truth, which is returned in gt_poses.
+registration::PoseGraph CreateLoopPoseGraph(
+        int n_nodes,
+        std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator> &gt_poses) {
+    registration::PoseGraph pose_graph;
+    gt_poses.clear();
+    for (int i = 0; i < n_nodes; i++) {
+        double angle = 2.0 * M_PI * i / n_nodes;
+        Eigen::Vector6d pose;
+        pose << 0.0, 0.0, angle, cos(angle), sin(angle), 0.1 * i;
+        gt_poses.push_back(utility::TransformVector6dToMatrix4d(pose));
+
+        Eigen::Vector6d noise;
+        noise << 0.01, -0.02, 0.01, 0.03, -0.02, 0.01;
+        noise *= (i == 0 ? 0.0 : (double)(i % 3 + 1));
+        pose_graph.nodes_.push_back(registration::PoseGraphNode(
+                utility::TransformVector6dToMatrix4d(noise) * gt_poses[i]));
+    }
+    for (int i = 0; i < n_nodes; i++) {
+        int j = (i + 1) % n_nodes;
+        pose_graph.edges_.push_back(registration::PoseGraphEdge(
+                i, j, gt_poses[j].inverse() * gt_poses[i],
+                Eigen::Matrix6d::Identity() * 100.0, i == n_nodes - 1));
+    }
+    return pose_graph;
+}
+
+}  // unnamed namespace
+
 TEST(GlobalOptimization, DISABLED_Constructor) { unit_test::NotImplemented(); }
 
 TEST(GlobalOptimization, DISABLED_MemberData) { unit_test::NotImplemented(); }
 
-TEST(GlobalOptimization, DISABLED_GlobalOptimizationLevenbergMarquardt) {
-    unit_test::NotImplemented();
+TEST(GlobalOptimization, GlobalOptimizationGaussNewton) {
+    std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator> gt_poses;
+    registration::PoseGraph pose_graph = CreateLoopPoseGraph(20, gt_poses);
+
+    registration::GlobalOptimization(
+            pose_graph, registration::GlobalOptimizationGaussNewton(),
+            registration::GlobalOptimizationConvergenceCriteria(),
+            registration::GlobalOptimizationOption(0.075, 0.25, 1.0, 0));
+
+    EXPECT_EQ(pose_graph.nodes_.size(), gt_poses.size());
+    EXPECT_EQ(pose_graph.edges_.size(), 20u);
+    for (size_t i = 0; i < gt_poses.size(); i++) {
+        unit_test::ExpectEQ(Eigen::Matrix4d(pose_graph.nodes_[i].pose_),
+                            gt_poses[i], 1e-4);
+    }
+}
+
+TEST(GlobalOptimization, GlobalOptimizationLevenbergMarquardt) {
+    std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator> gt_poses;
+    registration::PoseGraph pose_graph = CreateLoopPoseGraph(20, gt_poses);
+
+    registration::GlobalOptimization(
+            pose_graph, registration::GlobalOptimizationLevenbergMarquardt(),
+            registration::GlobalOptimizationConvergenceCriteria(),
+            registration::GlobalOptimizationOption(0.075, 0.25, 1.0, 0));
+
+    EXPECT_EQ(pose_graph.nodes_.size(), gt_poses.size());
+    EXPECT_EQ(pose_graph.edges_.size(), 20u);
+    for (size_t i = 0; i < gt_poses.size(); i++) {
+        unit_test::ExpectEQ(Eigen::Matrix4d(pose_graph.nodes_[i].pose_),
+                            gt_poses[i], 1e-4);
+    }
 }
 
 TEST(GlobalOptimization, DISABLED_GlobalOptimizationConvergenceCriteria) {
@@ -24,8 +24,82 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <random>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/Registration.h"
+#include "Open3D/Registration/RobustKernel.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+/// Target points are the source points under transformation, except for
+/// every fourth one, which is moved away.
+void CreateRegistrationProblem(int num_points,
+                               const Eigen::Matrix4d &transformation,
+                               geometry::PointCloud &source,
+                               geometry::PointCloud &target) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    source.points_.clear();
+    for (int i = 0; i < num_points; i++) {
+        source.points_.push_back(
+                Eigen::Vector3d(uniform(rng), uniform(rng), uniform(rng)));
+    }
+    target = source;
+    target.Transform(transformation);
+    for (int i = 0; i < num_points; i += 4) {
+        target.points_[i] += Eigen::Vector3d(0.0, 0.0, 10.0);
+    }
+}
+
+Eigen::Matrix4d CreateTransformation() {
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) =
+            Eigen::AngleAxisd(0.5, Eigen::Vector3d(1.0, 2.0, 3.0).normalized())
+                    .toRotationMatrix();
+    transformation.block<3, 1>(0, 3) = Eigen::Vector3d(0.3, -0.2, 0.1);
+    return transformation;
+}
+
+/// Points and normals on the three faces of the corner of the unit cube at
+/// the origin.
+geometry::PointCloud CreateCorner(int num_points_per_face, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    geometry::PointCloud pcd;
+    for (int axis = 0; axis < 3; axis++) {
+        for (int i = 0; i < num_points_per_face; i++) {
+            Eigen::Vector3d point(uniform(rng), uniform(rng), uniform(rng));
+            point(axis) = 0.0;
+            pcd.points_.push_back(point);
+            pcd.normals_.push_back(Eigen::Vector3d::Unit(axis));
+        }
+    }
+    return pcd;
+}
+
+/// Point to plane estimation that does not take the fused ICP path.
+class TransformationEstimationPointToPlaneUnfused
+    : public registration::TransformationEstimationPointToPlane {
+public:
+    using TransformationEstimationPointToPlane::
+            TransformationEstimationPointToPlane;
+    Eigen::Matrix4d ComputeTransformation(
+            const geometry::PointCloud &source,
+            const geometry::PointCloud &target,
+            const registration::CorrespondenceSet &corres) const override {
+        return TransformationEstimationPointToPlane::ComputeTransformation(
+                source, target, corres);
+    }
+};
+
+}  // unnamed namespace
+
 TEST(Registration, DISABLED_ICPConvergenceCriteria) {
     unit_test::NotImplemented();
 }
@@ -46,18 +120,203 @@ TEST(Registration, DISABLED_EvaluateRegistration) {
     unit_test::NotImplemented();
 }
 
-TEST(Registration, DISABLED_RegistrationICP) { unit_test::NotImplemented(); }
+TEST(Registration, RegistrationICP) {
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) =
+            Eigen::AngleAxisd(0.05, Eigen::Vector3d(1.0, 2.0, 3.0).normalized())
+                    .toRotationMatrix();
+    transformation.block<3, 1>(0, 3) = Eigen::Vector3d(0.02, -0.01, 0.015);
+    const geometry::PointCloud target = CreateCorner(2000, 0);
+    geometry::PointCloud source = CreateCorner(1000, 1);
+    source.Transform(transformation.inverse());
+
+    const registration::ICPConvergenceCriteria criteria(1e-9, 1e-9, 50);
+    auto result = registration::RegistrationICP(
+            source, target, 0.1, Eigen::Matrix4d::Identity(),
+            registration::TransformationEstimationPointToPlane(), criteria);
+    ExpectEQ(transformation, Eigen::Matrix4d(result.transformation_), 1e-4);
+    EXPECT_GT(result.fitness_, 0.9);
+    EXPECT_EQ(size_t(std::round(result.fitness_ * 3000)),
+              result.correspondence_set_.size());
+
+    // The fused and the generic point to plane ICP take the same steps.
+    auto unfused = registration::RegistrationICP(
+            source, target, 0.1, Eigen::Matrix4d::Identity(),
+            TransformationEstimationPointToPlaneUnfused(), criteria);
+    ExpectEQ(Eigen::Matrix4d(unfused.transformation_),
+             Eigen::Matrix4d(result.transformation_), 1e-6);
+    EXPECT_NEAR(unfused.fitness_, result.fitness_, 1e-3);
+    EXPECT_NEAR(unfused.inlier_rmse_, result.inlier_rmse_, 1e-6);
+
+    // No iteration only evaluates the initial transformation.
+    result = registration::RegistrationICP(
+            source, target, 0.1, transformation,
+            registration::TransformationEstimationPointToPlane(),
+            registration::ICPConvergenceCriteria(1e-6, 1e-6, 0));
+    ExpectEQ(transformation, Eigen::Matrix4d(result.transformation_), 0.0);
+}
+
+TEST(Registration, RegistrationICPRobustKernel) {
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+    transformation.block<3, 1>(0, 3) = Eigen::Vector3d(0.02, -0.01, 0.015);
+    const geometry::PointCloud target = CreateCorner(2000, 0);
+    geometry::PointCloud source = CreateCorner(1000, 1);
+    // A quarter of the points of the floor float above it.
+    for (int i = 2000; i < 3000; i += 4) {
+        source.points_[i](2) += 0.03;
+    }
+    source.Transform(transformation.inverse());
+
+    const registration::ICPConvergenceCriteria criteria(1e-9, 1e-9, 50);
+    auto l2 = registration::RegistrationICP(
+            source, target, 0.1, Eigen::Matrix4d::Identity(),
+            registration::TransformationEstimationPointToPlane(), criteria);
+    EXPECT_GT(std::abs(l2.transformation_(2, 3) - transformation(2, 3)),
+              1e-3);
+    // The robust kernels refine the squared loss estimate, whose residuals
+    // separate the inliers from the outliers.
+    for (auto kernel : std::vector<std::shared_ptr<registration::RobustKernel>>{
+                 std::make_shared<registration::TukeyLoss>(0.01),
+                 std::make_shared<registration::CauchyLoss>(0.002)}) {
+        auto result = registration::RegistrationICP(
+                source, target, 0.1, l2.transformation_,
+                registration::TransformationEstimationPointToPlane(kernel),
+                criteria);
+        ExpectEQ(transformation, Eigen::Matrix4d(result.transformation_),
+                 1e-3);
+    }
+}
 
 TEST(Registration, DISABLED_TransformationEstimationPointToPoint) {
     unit_test::NotImplemented();
 }
 
-TEST(Registration, DISABLED_RegistrationRANSACBasedOnCorrespondence) {
-    unit_test::NotImplemented();
+TEST(Registration, RegistrationMultiScaleICP) {
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) =
+            Eigen::AngleAxisd(0.1, Eigen::Vector3d(1.0, 2.0, 3.0).normalized())
+                    .toRotationMatrix();
+    transformation.block<3, 1>(0, 3) = Eigen::Vector3d(0.08, -0.05, 0.06);
+    geometry::PointCloud target = CreateCorner(5000, 0);
+    geometry::PointCloud source = CreateCorner(3000, 1);
+    source.Transform(transformation.inverse());
+
+    const std::vector<double> voxel_sizes = {0.05, 0.02, 0.0};
+    const std::vector<double> distances = {0.2, 0.05, 0.02};
+    const std::vector<registration::ICPConvergenceCriteria> criteria(
+            3, registration::ICPConvergenceCriteria(1e-9, 1e-9, 30));
+    const registration::ICPTargetPyramid pyramid(target, voxel_sizes);
+    ASSERT_EQ(3u, pyramid.NumLevels());
+    EXPECT_LT(pyramid.points_[0]->points_.size(),
+              pyramid.points_[1]->points_.size());
+    EXPECT_EQ(target.points_.size(), pyramid.points_[2]->points_.size());
+
+    // The pyramid is reused by several registrations.
+    for (const auto &estimation :
+         std::vector<std::shared_ptr<registration::TransformationEstimation>>{
+                 std::make_shared<
+                         registration::TransformationEstimationPointToPlane>(),
+                 std::make_shared<
+                         registration::TransformationEstimationPointToPoint>(
+                         false)}) {
+        auto result = registration::RegistrationMultiScaleICP(
+                source, pyramid, distances, criteria,
+                Eigen::Matrix4d::Identity(), *estimation);
+        ExpectEQ(transformation, Eigen::Matrix4d(result.transformation_),
+                 2e-3);
+        EXPECT_GT(result.fitness_, 0.9);
+    }
+
+    // Normals of the target are estimated if it has none.
+    target.normals_.clear();
+    source.normals_.clear();
+    auto result = registration::RegistrationMultiScaleICP(
+            source, target, voxel_sizes, distances, criteria,
+            Eigen::Matrix4d::Identity(),
+            registration::TransformationEstimationPointToPlane());
+    ExpectEQ(transformation, Eigen::Matrix4d(result.transformation_), 2e-3);
+
+    EXPECT_ANY_THROW(registration::RegistrationMultiScaleICP(
+            source, pyramid, {0.2, 0.05}, criteria));
 }
 
-TEST(Registration, DISABLED_RegistrationRANSACBasedOnFeatureMatching) {
-    unit_test::NotImplemented();
+TEST(Registration, RegistrationRANSACBasedOnCorrespondence) {
+    const Eigen::Matrix4d transformation = CreateTransformation();
+    geometry::PointCloud source, target;
+    CreateRegistrationProblem(200, transformation, source, target);
+    registration::CorrespondenceSet corres;
+    for (int i = 0; i < 200; i++) {
+        corres.push_back(Eigen::Vector2i(i, i));
+    }
+
+    auto result = registration::RegistrationRANSACBasedOnCorrespondence(
+            source, target, corres, 0.01,
+            registration::TransformationEstimationPointToPoint(false), 3,
+            registration::RANSACConvergenceCriteria(1000, 1000));
+    ExpectEQ(transformation, Eigen::Matrix4d(result.transformation_), 1e-6);
+    EXPECT_EQ(0.75, result.fitness_);
+    EXPECT_EQ(150u, result.correspondence_set_.size());
+    for (const auto &c : result.correspondence_set_) {
+        EXPECT_NE(0, c(0) % 4);
+    }
+    result = registration::RegistrationRANSACBasedOnCorrespondence(
+            source, target, corres, 0.01,
+            registration::TransformationEstimationPointToPoint(false), 3,
+            registration::RANSACConvergenceCriteria(100000000, 100000000, 0,
+                                                    0.999));
+    ExpectEQ(transformation, Eigen::Matrix4d(result.transformation_), 1e-6);
+    EXPECT_EQ(0.75, result.fitness_);
+
+    // The same seed draws the same samples.
+    const registration::RANSACConvergenceCriteria criteria(10, 10, 0, 1.0,
+                                                           /*seed*/ 7);
+    auto result0 = registration::RegistrationRANSACBasedOnCorrespondence(
+            source, target, corres, 0.01,
+            registration::TransformationEstimationPointToPoint(false), 3,
+            criteria);
+    auto result1 = registration::RegistrationRANSACBasedOnCorrespondence(
+            source, target, corres, 0.01,
+            registration::TransformationEstimationPointToPoint(false), 3,
+            criteria);
+    ExpectEQ(Eigen::Matrix4d(result0.transformation_),
+             Eigen::Matrix4d(result1.transformation_), 0.0);
+    EXPECT_EQ(result0.correspondence_set_.size(),
+              result1.correspondence_set_.size());
+}
+
+TEST(Registration, RegistrationRANSACBasedOnFeatureMatching) {
+    const Eigen::Matrix4d transformation = CreateTransformation();
+    geometry::PointCloud source, target;
+    CreateRegistrationProblem(1000, transformation, source, target);
+    // Features that match exactly between corresponding points.
+    registration::Feature source_feature, target_feature;
+    source_feature.Resize(4, 1000);
+    for (int i = 0; i < 1000; i++) {
+        source_feature.data_.col(i) = Eigen::Vector4f(i, i % 7, i % 13, 1.0f);
+    }
+    target_feature.data_ = source_feature.data_;
+
+    // Validations on all points, and on a random subset.
+    for (int validation_sample_size : {0, 100}) {
+        auto result = registration::RegistrationRANSACBasedOnFeatureMatching(
+                source, target, source_feature, target_feature, 0.001,
+                registration::TransformationEstimationPointToPoint(false), 3,
+                {},
+                registration::RANSACConvergenceCriteria(
+                        1000, 1000, validation_sample_size));
+        ExpectEQ(transformation, Eigen::Matrix4d(result.transformation_), 1e-6);
+        EXPECT_EQ(0.75, result.fitness_);
+        EXPECT_EQ(750u, result.correspondence_set_.size());
+        EXPECT_NEAR(0.0, result.inlier_rmse_, 1e-6);
+    }
+    // Stops after a few iterations instead of running the whole budget.
+    auto result = registration::RegistrationRANSACBasedOnFeatureMatching(
+            source, target, source_feature, target_feature, 0.001,
+            registration::TransformationEstimationPointToPoint(false), 3, {},
+            registration::RANSACConvergenceCriteria(100000000, 100000000, 0,
+                                                    0.999));
+    ExpectEQ(transformation, Eigen::Matrix4d(result.transformation_), 1e-6);
+    EXPECT_EQ(0.75, result.fitness_);
 }
 
 TEST(Registration, DISABLED_GetInformationMatrixFromPointClouds) {
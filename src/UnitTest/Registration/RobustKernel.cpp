@@ -0,0 +1,60 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Open3D/Registration/RobustKernel.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+
+TEST(RobustKernel, Weight) {
+    registration::L2Loss l2;
+    registration::HuberLoss huber(0.5);
+    registration::CauchyLoss cauchy(0.5);
+    registration::TukeyLoss tukey(0.5);
+    for (double r : {-2.0, -0.5, -0.1, 0.0, 0.3, 1.0}) {
+        EXPECT_EQ(1.0, l2.Weight(r));
+        EXPECT_NEAR(std::abs(r) <= 0.5 ? 1.0 : 0.5 / std::abs(r),
+                    huber.Weight(r), 1e-12);
+        EXPECT_NEAR(1.0 / (1.0 + 4.0 * r * r), cauchy.Weight(r), 1e-12);
+        const double t = std::max(0.0, 1.0 - 4.0 * r * r);
+        EXPECT_NEAR(t * t, tukey.Weight(r), 1e-12);
+    }
+    // Weights are symmetric and do not increase with the residual.
+    for (const registration::RobustKernel *kernel :
+         std::vector<const registration::RobustKernel *>{&huber, &cauchy,
+                                                          &tukey}) {
+        EXPECT_EQ(1.0, kernel->Weight(0.0));
+        for (double r = 0.0; r < 2.0; r += 0.05) {
+            EXPECT_EQ(kernel->Weight(r), kernel->Weight(-r));
+            EXPECT_LE(kernel->Weight(r + 0.05), kernel->Weight(r));
+        }
+    }
+    EXPECT_EQ(0.0, tukey.Weight(0.6));
+}
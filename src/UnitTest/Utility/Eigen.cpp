@@ -210,6 +210,54 @@ TEST(Eigen, ComputeJTJandJTr) {
     ExpectEQ(ref_JTJ, JTJ);
 }
 
+TEST(Eigen, ReduceJTJandJTr) {
+    Matrix6d ref_JTJ;
+    ref_JTJ << 2.819131, 0.023929, -0.403568, 1.276125, 0.437555, -1.123875,
+            0.023929, 2.817778, 0.086121, 1.133195, -0.124291, -0.695210,
+            -0.403568, 0.086121, 3.435509, -0.094671, 0.466959, -0.215179,
+            1.276125, 1.133195, -0.094671, 3.826990, -0.235632, -0.917586,
+            0.437555, -0.124291, 0.466959, -0.235632, 2.802768, -0.496025,
+            -1.123875, -0.695210, -0.215179, -0.917586, -0.496025, 2.951511;
+
+    Vector6d ref_JTr;
+    ref_JTr << 0.477778, -0.262092, -0.162745, -0.545752, -0.643791, -0.883007;
+
+    // Every row is added twice with half the weight, and once with a zero
+    // weight, which only adds to the sum of r^2.
+    auto testFunction = [&](int i, utility::JTJandJTrAccumulator &sum) {
+        Vector6d J_r;
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+            vector<double> v(6);
+            Rand(v, -1.0, 1.0, i);
+
+            for (int k = 0; k < 6; k++) J_r(k) = v[k];
+        }
+        double r = (double)(i % 6) / 6;
+        sum.AddRow(J_r, r, 0.5);
+        sum.AddRow(J_r, r, 0.5);
+        sum.AddRow(J_r, r, 0.0);
+    };
+
+    int iteration_num = 10;
+
+    Matrix6d JTJ = Matrix6d::Zero();
+    Vector6d JTr = Vector6d::Zero();
+    double r2 = 0.0;
+
+    tie(JTJ, JTr, r2) = utility::ReduceJTJandJTr(testFunction, iteration_num);
+
+    ExpectEQ(ref_JTr, JTr);
+    ExpectEQ(ref_JTJ, JTJ);
+    double ref_r2 = 0.0;
+    for (int i = 0; i < iteration_num; i++) {
+        ref_r2 += 3.0 * ((i % 6) / 6.0) * ((i % 6) / 6.0);
+    }
+    EXPECT_NEAR(ref_r2, r2, THRESHOLD_1E_6);
+}
+
 TEST(Eigen, ComputeJTJandJTr_vector) {
     Matrix6d ref_JTJ;
     ref_JTJ << 28.191311, 0.239293, -4.035679, 12.761246, 4.375548, -11.238754,
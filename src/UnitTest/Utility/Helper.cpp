@@ -24,6 +24,18 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Utility/Helper.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+
 TEST(Helper, DISABLED_SplitString) { unit_test::NotImplemented(); }
+
+TEST(Helper, GetRANSACIterations) {
+    // log(1 - 0.99) / log(1 - 0.5^3) = 34.5
+    EXPECT_EQ(utility::GetRANSACIterations(0.99, 0.5, 3, 1000), 35);
+    EXPECT_EQ(utility::GetRANSACIterations(0.99, 0.5, 3, 20), 20);
+    EXPECT_EQ(utility::GetRANSACIterations(0.99, 1.0, 3, 1000), 1);
+    EXPECT_EQ(utility::GetRANSACIterations(0.99, 0.0, 3, 1000), 1000);
+    EXPECT_EQ(utility::GetRANSACIterations(1.0, 0.5, 3, 1000), 1000);
+}